@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+#
+#  bench.py
+#  TinyC
+#
+#  Created by Tom Cole on 10/19/26.
+#  Copyright (c) 2026 Forest Edge. All rights reserved.
+#
+#  Benchmark harness for TinyC.  Each program in programs/ (plus a large
+#  generated source that exercises the front end) is run several times
+#  with the -T option, which reports the time spent lexing, parsing,
+#  resolving names, allocating string constants and executing.  Programs
+#  marked "// native: yes" are also compiled with the system cc for a
+#  native-speed reference.
+#
+#  Usage:
+#      bench.py [--tinyc path] [--runs n] [--output results.json]
+#               [--baseline baseline.json] [--save-baseline]
+#               [--threshold 0.10] [--no-native] [name ...]
+#
+#  With --baseline, each phase is compared with the saved numbers and any
+#  phase that is slower by more than the threshold is reported as a
+#  regression (and the exit status is 1).  --save-baseline writes the
+#  results of this run as the new baseline.
+
+import argparse
+import datetime
+import json
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+PROGRAMS = os.path.join(HERE, "programs")
+DEFAULT_TINYC = os.path.join(HERE, "..", "build", "Release", "TinyC")
+DEFAULT_BASELINE = os.path.join(HERE, "baseline.json")
+PHASES = ["lex", "parse", "resolve", "strings", "execute"]
+NATIVE_PRELUDE = ["-include", "stdio.h", "-include", "stdlib.h", "-include", "string.h"]
+
+
+def generate_large_source(path, functions=400, statements=20):
+    """Write a large, valid program whose cost is mostly in the front end."""
+    with open(path, "w") as f:
+        f.write("// native: yes\n")
+        f.write("// Generated by bench.py to measure lexing and parsing.\n\n")
+        for n in range(functions):
+            f.write("int func%d( int a, int b )\n{\n    int x;\n    int y;\n" % n)
+            f.write("    x = a;\n    y = b;\n")
+            for s in range(statements):
+                if s % 3 == 0:
+                    f.write("    x = x + y * %d - (a %% %d);\n" % (s + 1, s + 2))
+                elif s % 3 == 1:
+                    f.write("    if( x > %d )\n        y = y - 1;\n    else\n        y = y + 1;\n" % (s * 10))
+                else:
+                    f.write("    y = (x + %d) / 2;\n" % s)
+            f.write("    return x + y;\n}\n\n")
+        f.write("int main()\n{\n    int total;\n    total = 0;\n")
+        for n in range(0, functions, functions // 10 or 1):
+            f.write("    total = total + func%d(%d, %d);\n" % (n, n, n + 1))
+        f.write('    printf("total = %d\\n", total);\n    return 0;\n}\n')
+
+
+def is_native(path):
+    with open(path) as f:
+        for line in f:
+            if not line.startswith("//"):
+                break
+            if line.strip().replace(" ", "") == "//native:yes":
+                return True
+    return False
+
+
+def summarize(samples):
+    """Reduce a list of timings (seconds) to summary statistics."""
+    return {
+        "mean": statistics.mean(samples),
+        "median": statistics.median(samples),
+        "min": min(samples),
+        "max": max(samples),
+        "stdev": statistics.stdev(samples) if len(samples) > 1 else 0.0,
+        "samples": len(samples),
+    }
+
+
+def run_tinyc(tinyc, path, runs):
+    phases = {p: [] for p in PHASES}
+    wall = []
+    for _ in range(runs):
+        start = time.perf_counter()
+        proc = subprocess.run([tinyc, "-T", path], stdout=subprocess.DEVNULL,
+                              stderr=subprocess.PIPE, universal_newlines=True)
+        wall.append(time.perf_counter() - start)
+        timing = None
+        for line in proc.stderr.splitlines():
+            if line.startswith("TIMING: "):
+                timing = json.loads(line[len("TIMING: "):])
+        if timing is None:
+            raise RuntimeError("%s: no timing output (exit %d)\n%s"
+                               % (path, proc.returncode, proc.stderr))
+        for p in PHASES:
+            phases[p].append(timing[p])
+    result = {"phases": {p: summarize(phases[p]) for p in PHASES}}
+    result["wall"] = summarize(wall)
+    return result
+
+
+def run_native(path, runs, workdir):
+    exe = os.path.join(workdir, os.path.splitext(os.path.basename(path))[0])
+    cc = os.environ.get("CC", "cc")
+    proc = subprocess.run([cc, "-O2", "-w"] + NATIVE_PRELUDE + ["-o", exe, path],
+                          stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                          universal_newlines=True)
+    if proc.returncode != 0:
+        print("  native compile failed: %s" % proc.stderr.strip().splitlines()[:1],
+              file=sys.stderr)
+        return None
+    wall = []
+    for _ in range(runs):
+        start = time.perf_counter()
+        subprocess.run([exe], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        wall.append(time.perf_counter() - start)
+    return summarize(wall)
+
+
+def compare(results, baseline, threshold):
+    """Print phase-by-phase changes against the baseline; return regressions."""
+    regressions = []
+    print("\n%-16s %-10s %12s %12s %9s" % ("benchmark", "phase", "baseline ms", "current ms", "change"))
+    for name, current in sorted(results["benchmarks"].items()):
+        old = baseline.get("benchmarks", {}).get(name)
+        if old is None:
+            print("%-16s %-10s %12s" % (name, "-", "(new)"))
+            continue
+        rows = [(p, old["phases"][p]["median"], current["phases"][p]["median"]) for p in PHASES]
+        rows.append(("wall", old["wall"]["median"], current["wall"]["median"]))
+        for phase, before, after in rows:
+            change = (after - before) / before if before > 0 else 0.0
+            flag = ""
+            if change > threshold and after - before > 0.0005:
+                flag = "  REGRESSION"
+                regressions.append((name, phase, change))
+            print("%-16s %-10s %12.3f %12.3f %+8.1f%%%s"
+                  % (name, phase, before * 1000, after * 1000, change * 100, flag))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the TinyC benchmark suite.")
+    parser.add_argument("--tinyc", default=os.environ.get("TINYC", DEFAULT_TINYC))
+    parser.add_argument("--runs", type=int, default=5)
+    parser.add_argument("--output", default=None)
+    parser.add_argument("--baseline", default=None)
+    parser.add_argument("--save-baseline", action="store_true")
+    parser.add_argument("--threshold", type=float, default=0.10)
+    parser.add_argument("--no-native", action="store_true")
+    parser.add_argument("names", nargs="*")
+    args = parser.parse_args()
+
+    workdir = tempfile.mkdtemp(prefix="tinyc-bench-")
+    programs = sorted(os.path.join(PROGRAMS, f) for f in os.listdir(PROGRAMS) if f.endswith(".c"))
+    large = os.path.join(workdir, "frontend_large.c")
+    generate_large_source(large)
+    programs.append(large)
+
+    results = {
+        "tinyc": os.path.abspath(args.tinyc),
+        "runs": args.runs,
+        "timestamp": datetime.datetime.now().isoformat(timespec="seconds"),
+        "benchmarks": {},
+    }
+
+    print("%-16s %9s %9s %9s %9s %9s %10s %10s" % ("benchmark", "lex", "parse", "resolve",
+          "strings", "execute", "wall", "native"))
+    for path in programs:
+        name = os.path.splitext(os.path.basename(path))[0]
+        if args.names and name not in args.names:
+            continue
+        entry = run_tinyc(args.tinyc, path, args.runs)
+        entry["native"] = None
+        if not args.no_native and is_native(path):
+            entry["native"] = run_native(path, args.runs, workdir)
+        if entry["native"]:
+            entry["native_ratio"] = entry["wall"]["median"] / max(entry["native"]["median"], 1e-9)
+        results["benchmarks"][name] = entry
+
+        ms = lambda s: s["median"] * 1000
+        print("%-16s %9.3f %9.3f %9.3f %9.3f %9.3f %10.3f %10s" % (
+            name, *(ms(entry["phases"][p]) for p in PHASES), ms(entry["wall"]),
+            "%.3f" % ms(entry["native"]) if entry["native"] else "-"))
+
+    text = json.dumps(results, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    if args.save_baseline:
+        with open(args.baseline or DEFAULT_BASELINE, "w") as f:
+            f.write(text + "\n")
+
+    status = 0
+    if args.baseline and not args.save_baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(results, baseline, args.threshold)
+        if regressions:
+            print("\n%d regression(s) over %.0f%%" % (len(regressions), args.threshold * 100))
+            status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,26 @@
+// native: yes
+//
+// Dynamic memory churn.  Allocates and frees blocks of a few different
+// sizes, which exercises the allocation and free lists.
+
+int main()
+{
+    int i;
+    long total;
+    char *p;
+    char *q;
+    char *r;
+
+    total = 0;
+    for( i = 0; i < 2000; i++ ) {
+        p = malloc(16);
+        q = malloc(32 + (i % 4) * 16);
+        r = malloc(64);
+        total = total + 112 + (i % 4) * 16;
+        free(q);
+        free(p);
+        free(r);
+    }
+    printf("allocated %ld bytes\n", total);
+    return 0;
+}
@@ -0,0 +1,22 @@
+// native: yes
+//
+// Recursive Fibonacci.  Measures function call overhead: argument
+// passing, frame push and pop, and the return value path.
+
+int fib( int n )
+{
+    int result;
+    if( n < 2 )
+        result = n;
+    else
+        result = fib(n-1) + fib(n-2);
+    return result;
+}
+
+int main()
+{
+    int value;
+    value = fib(20);
+    printf("fib(20) = %d\n", value);
+    return 0;
+}
@@ -0,0 +1,45 @@
+// native: yes
+//
+// Nested-loop integer matrix multiply.  Measures loop control, array
+// indexing through pointers, and integer arithmetic.
+
+int main()
+{
+    int n;
+    int i;
+    int j;
+    int k;
+    int sum;
+    int *a;
+    int *b;
+    int *c;
+
+    n = 24;
+    a = malloc(n*n*4);
+    b = malloc(n*n*4);
+    c = malloc(n*n*4);
+
+    for( i = 0; i < n*n; i++ ) {
+        a[i] = i % 7;
+        b[i] = i % 5;
+    }
+
+    for( i = 0; i < n; i++ ) {
+        for( j = 0; j < n; j++ ) {
+            sum = 0;
+            for( k = 0; k < n; k++ )
+                sum = sum + a[i*n+k] * b[k*n+j];
+            c[i*n+j] = sum;
+        }
+    }
+
+    sum = 0;
+    for( i = 0; i < n*n; i++ )
+        sum = sum + c[i];
+    printf("checksum = %d\n", sum);
+
+    free(a);
+    free(b);
+    free(c);
+    return 0;
+}
@@ -0,0 +1,17 @@
+// native: yes
+//
+// Formatted output.  Measures printf() with several conversions per
+// call.  The harness discards stdout.
+
+int main()
+{
+    int i;
+    double x;
+
+    x = 0.5;
+    for( i = 0; i < 2000; i++ ) {
+        printf("line %d: value %f hex %x name %s\n", i, x, i * 3, "benchmark");
+        x = x + 0.25;
+    }
+    return 0;
+}
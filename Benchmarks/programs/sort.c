@@ -0,0 +1,50 @@
+//
+// Sorting through a TinyC comparator.  Measures qsort and bsearch, which
+// call back into an interpreted function with pointers to the elements
+// for every compare, and checks the result.
+
+int compare( int *a, int *b )
+{
+    return *a - *b;
+}
+
+int main()
+{
+    int n;
+    int i;
+    int key;
+    int found;
+    int *values;
+    int *match;
+
+    n = 500;
+    values = malloc(n*4);
+    for( i = 0; i < n; i++ )
+        values[i] = (i * 7919) % n;
+
+    qsort(values, n, 4, "compare");
+    for( i = 1; i < n; i++ ) {
+        if( values[i-1] > values[i] ) {
+            printf("qsort: out of order at %d\n", i);
+            return 1;
+        }
+    }
+
+    found = 0;
+    for( i = 0; i < n; i++ ) {
+        key = i;
+        match = bsearch(&key, values, n, 4, "compare");
+        if( match != 0 && *match == i )
+            found++;
+    }
+    key = n;
+    match = bsearch(&key, values, n, 4, "compare");
+    if( match != 0 ) {
+        printf("bsearch: found %d, which is not there\n", key);
+        return 1;
+    }
+
+    printf("sorted %d values, found %d\n", n, found);
+    free(values);
+    return 0;
+}
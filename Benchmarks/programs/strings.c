@@ -0,0 +1,24 @@
+// native: yes
+//
+// String building.  Measures string constants, the string builtins,
+// and byte copies into dynamic storage.
+
+int main()
+{
+    char *buffer;
+    int i;
+    int length;
+
+    buffer = malloc(8192);
+    strcpy(buffer, "");
+    for( i = 0; i < 500; i++ ) {
+        strcat(buffer, "abcdefgh");
+        if( strlen(buffer) > 4000 )
+            strcpy(buffer, "");
+    }
+
+    length = strlen(buffer);
+    printf("length = %d, compare = %d\n", length, strcmp(buffer, "abcdefgh"));
+    free(buffer);
+    return 0;
+}
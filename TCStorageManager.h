@@ -7,8 +7,45 @@
 //
 
 #import <Foundation/Foundation.h>
+#import <os/lock.h>
 #import "TCValue.h"
 
+/**
+ Virtual addresses at or above this value do not refer to the storage
+ buffer, but to externally backed regions such as memory-mapped files.
+ */
+#define TCSTORAGE_EXTERNAL_BASE 0x100000000000L
+
+/**
+ Describes a region of the virtual address space whose bytes live outside
+ the storage buffer.
+ */
+typedef struct {
+    long address;
+    long length;
+    char * data;
+    BOOL readOnly;
+} TCStorageRegion;
+
+/**
+ An automatic storage stack in a block of the dynamic area, used by a
+ spawned thread or a coroutine so its frames are kept apart from the main
+ stack and from each other.  Set base and current to the start of the
+ block and limit to its end.
+ */
+@interface TCStorageStack : NSObject
+
+@property long base;
+@property long current;
+
+/** The end of the stack's block */
+@property long limit;
+
+@property int frameCount;
+@property NSMutableArray * frames;
+
+@end
+
 @interface TCStorageManager : NSObject
 
 {
@@ -17,6 +54,26 @@
     NSMutableArray * _stringPool;
     NSMutableArray * _stringAddress;
     
+    /** Array of TCStorageRegion structures for externally backed memory */
+    NSMutableData * _regions;
+    
+    /** The objects that own the bytes of each external region */
+    NSMutableArray * _regionData;
+    
+    /** The virtual address to be given to the next external region */
+    long _nextExternal;
+    
+    /** Open FILE* pointers, indexed by file handle - 1 */
+    NSMutableArray * _files;
+    
+    /** Serializes the dynamic allocator, which every thread shares */
+    os_unfair_lock _heapLock;
+    
+    /** Serializes the external regions, which every thread shares */
+    os_unfair_lock _regionLock;
+    
+    /** Serializes the table of open files, which every thread shares */
+    os_unfair_lock _fileLock;
 }
 @property char * buffer;
 @property long base;
@@ -35,13 +92,29 @@
 -(instancetype) initWithStorage:(long) size;
 -(long) pushStorage;
 -(long) popStorage;
+-(void) adoptStack:(TCStorageStack*) stack;
 -(long) allocateAuto:(long)size;
 -(long) allocateDynamic:(long)size;
 -(long) allocUnpadded:(long)size;
 -(long) free:(long) address;
+-(void) freeListBlocks:(long*) blocks bytes:(long*) bytes largest:(long*) largest;
 -(void) align:(long)size;
 
 -(BOOL) isFault:(long) address;
+-(BOOL) isValidRange:(long) address length:(long) length;
+-(char*) pointerTo:(long) address length:(long) length forWrite:(BOOL) write;
+-(long) addressOf:(const char*) pointer;
+-(long) stringLength:(long) address limit:(long) limit;
+
+-(long) mapExternal:(NSData*) data writable:(BOOL) writable;
+-(long) mapBytes:(void*) bytes length:(long) length writable:(BOOL) writable owner:(id) owner;
+-(long) externalLength:(long) address;
+-(BOOL) unmapExternal:(long) address;
+
+-(long) addFile:(FILE*) file;
+-(FILE*) fileForHandle:(long) handle;
+-(int) closeFile:(long) handle;
+
 -(TCValue*) getValue:(long) address ofType:(TCValueType) type;
 -(void) setValue:(TCValue*) value at:(long) address;
 
@@ -57,6 +130,9 @@
 -(double) getDouble:(long) address;
 -(void) setDouble:(double) value at:(long) address;
 
+-(float) getFloat:(long) address;
+-(void) setFloat:(float) value at:(long) address;
+
 -(NSString*) getString:(long)address;
 
 -(TCValue*) allocateString: (NSString*) string;
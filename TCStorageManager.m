@@ -8,6 +8,9 @@
 
 #import "TCStorageManager.h"
 #import "TCValue.h"
+#import "TCMetrics.h"
+#import "TCTraceBuffer.h"
+#import "TCHeapProfiler.h"
 
 const char * typeName( TCValueType t )
 {
@@ -62,6 +65,19 @@ const char * typeName( TCValueType t )
     [name getCString:msgBuffer maxLength:78 encoding:NSUTF8StringEncoding];
     return msgBuffer;
 }
+/**
+ The automatic stack of this thread, when it is not the main stack of the
+ storage that owns it.  A spawned thread or a coroutine adopts a stack in
+ a block of the dynamic area, and its frames go there.
+ */
+static __thread __unsafe_unretained TCStorageStack * threadStack = nil;
+static __thread __unsafe_unretained TCStorageManager * threadStackOwner = nil;
+
+#define TCTHREAD_STACK (threadStackOwner == self ? threadStack : nil)
+
+@implementation TCStorageStack
+@end
+
 @implementation TCStorageManager
 
 #pragma mark - Initialization
@@ -117,14 +133,41 @@ const char * typeName( TCValueType t )
         _freeList = [NSMutableArray array];
         _allocList = [NSMutableArray array];
 
+        // External regions live in their own part of the address space
+        // well above the storage buffer, so a pointer into one can never
+        // be confused with a pointer into the buffer.
+        
+        _regions = [NSMutableData data];
+        _regionData = [NSMutableArray array];
+        _nextExternal = TCSTORAGE_EXTERNAL_BASE;
+        
+        _files = [NSMutableArray array];
+        _heapLock = OS_UNFAIR_LOCK_INIT;
+        _regionLock = OS_UNFAIR_LOCK_INIT;
+        _fileLock = OS_UNFAIR_LOCK_INIT;
     }
     return self;
 }
 
+-(void) dealloc
+{
+    for( long handle = 1; handle <= (long) _files.count; handle++ )
+        [self closeFile:handle];
+}
+
 #pragma mark - Dynamic Sizing
 
 -(long) pushStorage;
 {
+    TCStorageStack * stack = TCTHREAD_STACK;
+    if( stack != nil ) {
+        stack.frameCount++;
+        [stack.frames addObject:[NSNumber numberWithLong:stack.base]];
+        [stack.frames addObject:[NSNumber numberWithLong:stack.current]];
+        stack.base = stack.current;
+        return stack.base;
+    }
+    
     _frameCount++;
     if( _frameCount > _maxFrames)
         _maxFrames = _frameCount;
@@ -139,19 +182,37 @@ const char * typeName( TCValueType t )
 
 -(long) popStorage
 {
-    if( _frameCount < 0 ) {
+    TCStorageStack * stack = TCTHREAD_STACK;
+    if( stack != nil ) {
+        NSMutableArray * frames = stack.frames;
+        if( stack.frameCount <= 0 || frames.count < 2 ) {
+            NSLog(@"STORAGE: FATAL, too many stack frames popped");
+            return 0;
+        }
+        stack.current = [frames.lastObject longValue];
+        [frames removeLastObject];
+        stack.base = [frames.lastObject longValue];
+        [frames removeLastObject];
+        stack.frameCount--;
+        return stack.base;
+    }
+    
+    if( _frameCount <= 0 || _stack.count < 2 ) {
         NSLog(@"STORAGE: FATAL, too many stack frames popped");
         return 0;
     }
     long idx =_stack.count-1;
     long frameSize = _current - _base;
     
+    // Each frame pushed both the old base and the old current position,
+    // so both come back off the stack here.
+    
     NSNumber *oldCurrent = [_stack objectAtIndex:idx];
-    NSNumber *oldBase = [_stack objectAtIndex:idx];
+    NSNumber *oldBase = [_stack objectAtIndex:idx-1];
     _base = oldBase.longValue;
     _current = oldCurrent.longValue;
     
-    [_stack removeObjectAtIndex:idx];
+    [_stack removeObjectsInRange:NSMakeRange(idx-1, 2)];
     if(_debug)
         NSLog(@"STORAGE: pop old storage frame #%d at %ld, discarding %ld bytes", _frameCount, _current, frameSize);
     _frameCount--;
@@ -159,8 +220,35 @@ const char * typeName( TCValueType t )
 }
 
 
+/**
+ Make a stack the automatic stack of the calling thread, so its frames
+ are pushed and popped in the stack's own block while the main stack,
+ and the stacks of other threads, are left alone.  The caller must keep
+ the stack alive while it is adopted.
+ @param stack the stack, or nil to go back to the main stack
+ */
+
+-(void) adoptStack:(TCStorageStack*) stack
+{
+    if( stack != nil && stack.frames == nil )
+        stack.frames = [NSMutableArray array];
+    threadStack = stack;
+    threadStackOwner = (stack != nil) ? self : nil;
+}
+
 -(long) allocUnpadded:(long)size
 {
+    TCStorageStack * stack = TCTHREAD_STACK;
+    if( stack != nil ) {
+        long address = stack.current;
+        if( address + size > stack.limit ) {
+            NSLog(@"Memory exhausted");
+            return 0L;
+        }
+        stack.current = address + size;
+        return address;
+    }
+    
     if( _current + size > _size) {
         NSLog(@"Memory exhausted");
         return 0L;
@@ -183,6 +271,11 @@ const char * typeName( TCValueType t )
 {
     TCValue * result = nil;
     
+    // The pool is shared by every thread running in this storage, so it
+    // is only touched under the heap lock.  That lock is not held while
+    // the string is allocated, since allocateDynamic takes it too.
+    
+    os_unfair_lock_lock(&_heapLock);
     if(_stringPool == nil ) {
         _stringPool = [NSMutableArray array];
         _stringAddress = [NSMutableArray array];
@@ -191,14 +284,14 @@ const char * typeName( TCValueType t )
     long pos = [_stringPool indexOfObject:(string)];
     if( pos != NSNotFound) {
         NSNumber * n = _stringAddress[pos];
+        os_unfair_lock_unlock(&_heapLock);
         result = [[TCValue alloc]initWithLong:[n longValue]];
         [result makePointer:TCVALUE_POINTER_CHAR];
         return result;
     }
+    os_unfair_lock_unlock(&_heapLock);
 
     pos = [self allocateDynamic:string.length+1];
-    [_stringPool addObject:string];
-    [_stringAddress addObject:[[NSNumber alloc]initWithLong:pos]];
     
     // Let's actually copy the string into the memory storage as well.
     
@@ -207,6 +300,22 @@ const char * typeName( TCValueType t )
     }
     [self setChar:0 at:pos+string.length];
     
+    // Another thread may have pooled the same string in the meantime, in
+    // which case its copy is used and this one given back.
+    
+    os_unfair_lock_lock(&_heapLock);
+    long existing = [_stringPool indexOfObject:(string)];
+    if( existing == NSNotFound ) {
+        [_stringPool addObject:string];
+        [_stringAddress addObject:[[NSNumber alloc]initWithLong:pos]];
+        os_unfair_lock_unlock(&_heapLock);
+    } else {
+        long copy = pos;
+        pos = [_stringAddress[existing] longValue];
+        os_unfair_lock_unlock(&_heapLock);
+        [self free:copy];
+    }
+    
     result = [[TCValue alloc]initWithLong:pos];
     [result makePointer:TCVALUE_POINTER_CHAR];
     return result;
@@ -214,10 +323,19 @@ const char * typeName( TCValueType t )
 
 -(long) allocateDynamic:(long)size
 {
-
+    // An execution with a memory budget fails the allocation that would
+    // take it over, and is stopped at the next check.  The budget is
+    // shared by all the threads of the execution.
+    
+    if( !chargeMemory(size))
+        return 0L;
+    
     // First, search list of free'd allocations to see if
-    // we already have one this size to give away.
+    // we already have one this size to give away.  The lists are shared
+    // by every thread running in this storage.
     
+    long address = 0L;
+    os_unfair_lock_lock(&_heapLock);
     for( int ix = 0; ix < _freeList.count; ix++) {
         NSValue * v = [_freeList objectAtIndex:ix];
         NSRange r = v.rangeValue;
@@ -225,32 +343,50 @@ const char * typeName( TCValueType t )
         if( r.length == size) {
             [_freeList removeObjectAtIndex:ix];
             [_allocList addObject:v];
+            address = r.location;
             if(_debug) {
                 NSLog(@"STORAGE: dynalloc %ld byte @ %ld free list #%d",
-                      size, r.location, ix);
+                      size, address, ix);
             }
-            return r.location;
+            break;
         }
     }
     
     // No, we must allocate anew from the storage area
     
-    if((_dynamic - size) <= _current) {
-        NSLog(@"FATAL - dynamic memory exhausted");
-        return 0L;
+    if( address == 0L ) {
+        if((_dynamic - size) <= _current) {
+            os_unfair_lock_unlock(&_heapLock);
+            releaseMemory(size);
+            NSLog(@"FATAL - dynamic memory exhausted");
+            return 0L;
+        }
+        
+        _dynamic = _dynamic - size;
+        address = _dynamic;
+        [_allocList addObject:[NSValue valueWithRange:NSMakeRange(address, size)]];
+        if((_size - _dynamic) > _dynamicMark)
+            _dynamicMark = (_size - _dynamic);
+        if(_debug) {
+            NSLog(@"STORAGE: dynalloc %ld byte @ %ld alloc list #%ld",
+                  size, address, (long) _allocList.count-1);
+        }
     }
+    os_unfair_lock_unlock(&_heapLock);
     
-    _dynamic = _dynamic - size;
-    [_allocList addObject:[NSValue valueWithRange:NSMakeRange(_dynamic, size)]];
-    if(_debug) {
-        NSLog(@"STORAGE: dynalloc %ld byte @ %ld alloc list #%ld",
-              size, _dynamic, _allocList.count-1);
-    }
-
-    if((_size - _dynamic) > _dynamicMark)
-        _dynamicMark = (_size - _dynamic);
+    // Only an allocation that was made is counted.
     
-    return _dynamic;
+    long live = runtimeCounters.allocBytes - runtimeCounters.freeBytes + size;
+    runtimeCounters.allocs++;
+    runtimeCounters.allocBytes += size;
+    if( live > runtimeCounters.peakBytes )
+        runtimeCounters.peakBytes = live;
+
+    if( activeTrace )
+        traceEvent(TCTRACE_ALLOC, 0, address, size);
+    if( activeHeapProfiler )
+        [activeHeapProfiler allocated:address size:size];
+    return address;
 }
 
 /**
@@ -264,6 +400,7 @@ const char * typeName( TCValueType t )
     // Search the allocation list to find the matching
     // allocation record.
     
+    os_unfair_lock_lock(&_heapLock);
     for( int ix = 0; ix < _allocList.count; ix++ ) {
         NSValue *v = _allocList[ix];
         NSRange r = v.rangeValue;
@@ -273,6 +410,14 @@ const char * typeName( TCValueType t )
             // Delete from the allocation list and put on free list
             [_allocList removeObjectAtIndex:ix];
             [_freeList addObject:v];
+            os_unfair_lock_unlock(&_heapLock);
+            runtimeCounters.frees++;
+            runtimeCounters.freeBytes += r.length;
+            releaseMemory(r.length);
+            if( activeTrace )
+                traceEvent(TCTRACE_FREE, 0, r.location, r.length);
+            if( activeHeapProfiler )
+                [activeHeapProfiler freed:r.location size:r.length];
             
             if(_debug)
                 NSLog(@"STORAGE: free %ld bytes at %ld",
@@ -283,11 +428,35 @@ const char * typeName( TCValueType t )
     }
     
     // Not an allocation we know about
+    os_unfair_lock_unlock(&_heapLock);
     if(_debug)
         NSLog(@"STORAGE: attempt to free unallocated memory at %ld", address);
     return 0;
 }
 
+/**
+ Summarize the free list, to see how much of the dynamic storage area is
+ held in blocks waiting to be reused.
+ @param blocks where to store the number of free blocks
+ @param bytes where to store the total bytes in the free blocks
+ @param largest where to store the size of the largest free block
+ */
+
+-(void) freeListBlocks:(long*) blocks bytes:(long*) bytes largest:(long*) largest
+{
+    os_unfair_lock_lock(&_heapLock);
+    *blocks = _freeList.count;
+    *bytes = 0L;
+    *largest = 0L;
+    for( NSValue * v in _freeList ) {
+        NSRange r = v.rangeValue;
+        *bytes += r.length;
+        if((long) r.length > *largest )
+            *largest = r.length;
+    }
+    os_unfair_lock_unlock(&_heapLock);
+}
+
 /**
  Force the storage to be aligned on the natural 'size' boundary.
  @param size the natural alignment size.  If the current
@@ -301,6 +470,14 @@ const char * typeName( TCValueType t )
 {
     // Adjust the pointer to be a multiple of the storage size
     
+    TCStorageStack * stack = TCTHREAD_STACK;
+    if( stack != nil ) {
+        long pad = stack.current % size;
+        if( pad )
+            stack.current = stack.current + (size-pad);
+        return;
+    }
+    
     long pad = _current % size;
     if( pad ) {
         _current = _current + (size-pad);
@@ -315,6 +492,18 @@ const char * typeName( TCValueType t )
 
 -(long) allocateAuto:(long)size
 {
+    TCStorageStack * stack = TCTHREAD_STACK;
+    if( stack != nil ) {
+        [self align:size];
+        long address = stack.current;
+        if( address + size > stack.limit ) {
+            NSLog(@"Memory exhausted");
+            return 0L;
+        }
+        stack.current = address + size;
+        return address;
+    }
+    
     if( _current + size > _size) {
         NSLog(@"Memory exhausted");
         return 0L;
@@ -336,8 +525,42 @@ const char * typeName( TCValueType t )
     return newAddr;
 }
 
+/**
+ Locate the external region that contains a range of virtual addresses.
+ @param address the virtual address of the first byte
+ @param length the number of bytes in the range
+ @param region where to copy the region
+ @returns YES if the range is entirely within one region
+ */
+
+-(BOOL) regionFor:(long) address length:(long) length into:(TCStorageRegion*) region
+{
+    // Another thread can map a region, which may move the array, so the
+    // region is copied out under the lock.
+    
+    BOOL found = NO;
+    os_unfair_lock_lock(&_regionLock);
+    TCStorageRegion * r = _regions.mutableBytes;
+    long count = _regions.length / sizeof(TCStorageRegion);
+    
+    for( long ix = 0; ix < count; ix++, r++ ) {
+        if( address >= r->address && address < r->address + r->length ) {
+            // Written so a huge length cannot wrap around the test.
+            found = length >= 0L && length <= r->length - (address - r->address);
+            if( found )
+                *region = *r;
+            break;
+        }
+    }
+    os_unfair_lock_unlock(&_regionLock);
+    return found;
+}
+
 -(BOOL) isFault:(long) address
 {
+    TCStorageRegion r;
+    if( address >= TCSTORAGE_EXTERNAL_BASE )
+        return ![self regionFor:address length:1L into:&r];
    if( address < 0L || address > _size )
        return YES;
     if((address >= _current) && (address < _dynamic))
@@ -345,8 +568,332 @@ const char * typeName( TCValueType t )
     return NO;
 }
 
+/**
+ Determine if an entire range of bytes is addressable.  A range is valid
+ only if it lies completely within the automatic area, completely within
+ the dynamic area, or completely within one external region; it cannot
+ span the unallocated space between them.
+ @param address the virtual address of the first byte
+ @param length the number of bytes in the range
+ @returns YES if every byte of the range can be read
+ */
+
+-(BOOL) isValidRange:(long) address length:(long) length
+{
+    return [self pointerTo:address length:length forWrite:NO] != NULL;
+}
+
+/**
+ Translate a range of virtual addresses into a real pointer that can be
+ used to access all the bytes of the range at once.
+ @param address the virtual address of the first byte
+ @param length the number of bytes in the range
+ @param write YES if the bytes will be written, in which case read-only
+ external regions are treated as a fault
+ @returns a pointer to the first byte, or NULL if the range is not
+ entirely addressable
+ */
+
+-(char*) pointerTo:(long) address length:(long) length forWrite:(BOOL) write
+{
+    if( address >= TCSTORAGE_EXTERNAL_BASE ) {
+        TCStorageRegion r;
+        if( ![self regionFor:address length:length into:&r] || (write && r.readOnly))
+            return NULL;
+        return r.data + (address - r.address);
+    }
+    
+    if( length < 0L || address < 0L || address > _size || length > _size - address )
+        return NULL;
+    if( length == 0L )
+        return _buffer + address;
+    if( address + length <= _current )
+        return _buffer + address;
+    if( address >= _dynamic )
+        return _buffer + address;
+    return NULL;
+}
+
+/**
+ Translate a real pointer back into a virtual address, for a pointer that
+ native code returns.  This is the reverse of pointerTo:length:forWrite:.
+ @param pointer the real pointer
+ @returns the virtual address, or 0 if the pointer is not into the storage
+ buffer or a mapped external region
+ */
+
+-(long) addressOf:(const char*) pointer
+{
+    if( pointer >= _buffer && pointer < _buffer + _size )
+        return pointer - _buffer;
+    
+    long address = 0L;
+    os_unfair_lock_lock(&_regionLock);
+    TCStorageRegion * r = _regions.mutableBytes;
+    long count = _regions.length / sizeof(TCStorageRegion);
+    for( long ix = 0; ix < count; ix++, r++ ) {
+        if( pointer >= r->data && pointer < r->data + r->length ) {
+            address = r->address + (pointer - r->data);
+            break;
+        }
+    }
+    os_unfair_lock_unlock(&_regionLock);
+    return address;
+}
+
+/**
+ Find the length of a null-terminated string in storage.  The search for
+ the terminator is bounded by the end of the storage area that contains
+ the string, so a missing terminator cannot run off into unallocated
+ memory.
+ @param address the virtual address of the start of the string
+ @param limit the maximum number of bytes to search
+ @returns the length of the string (not counting the null), the limit if
+ no null was found within that many bytes, or -1 if the string runs out of
+ addressable storage before a terminator is found.
+ */
+
+-(long) stringLength:(long) address limit:(long) limit
+{
+    char * start;
+    long end;
+    
+    if( address >= TCSTORAGE_EXTERNAL_BASE ) {
+        TCStorageRegion r;
+        if( ![self regionFor:address length:1L into:&r] )
+            return -1L;
+        start = r.data + (address - r.address);
+        end = r.address + r.length;
+    }
+    else {
+        if([self isFault:address] || address >= _size)
+            return -1L;
+        start = _buffer + address;
+        end = (address < _current) ? _current : _size;
+    }
+    
+    long count = end - address;
+    if( limit < count )
+        count = limit;
+    
+    char * terminator = memchr(start, 0, count);
+    if( terminator != NULL )
+        return terminator - start;
+    if( count == limit )
+        return limit;
+    return -1L;
+}
+
+#pragma mark - External Regions
+
+/**
+ Make the bytes of an NSData object addressable by the TinyC program,
+ without copying them.  The data object is retained until the region is
+ unmapped, so a memory-mapped NSData keeps its file mapped for as long as
+ the program can see it.
+ @param data the bytes to map.  If the region is writable this must be
+ an NSMutableData whose length will not change while it is mapped.
+ @param writable YES if the program may store into the region
+ @returns the virtual address of the first byte of the region, or 0 if
+ the data cannot be mapped
+ */
+
+-(long) mapExternal:(NSData*) data writable:(BOOL) writable
+{
+    if( data == nil || (writable && ![data isKindOfClass:[NSMutableData class]]))
+        return 0L;
+    
+    void * bytes = writable ? [(NSMutableData*) data mutableBytes] : (void*) data.bytes;
+    return [self mapBytes:bytes length:data.length writable:writable owner:data];
+}
+
+/**
+ Make a block of memory owned by the caller addressable by the TinyC
+ program, without copying it.  The program reads and writes the caller's
+ memory in place.
+ @param bytes the first byte of the block
+ @param length the number of bytes in the block
+ @param writable YES if the program may store into the region
+ @param owner an object to retain while the region is mapped, or nil if
+ the caller guarantees the memory outlives the mapping
+ @returns the virtual address of the first byte of the region, or 0 if
+ the block cannot be mapped
+ */
+
+-(long) mapBytes:(void*) bytes length:(long) length writable:(BOOL) writable owner:(id) owner
+{
+    if( length < 0L || (bytes == NULL && length > 0L))
+        return 0L;
+    
+    TCStorageRegion r;
+    r.length = length;
+    r.readOnly = !writable;
+    r.data = bytes ? (char*) bytes : "";
+    
+    // Leave at least one unmapped page after each region so running off
+    // the end of one region faults instead of landing in the next one.
+    
+    os_unfair_lock_lock(&_regionLock);
+    r.address = _nextExternal;
+    _nextExternal += ((r.length + 4095L) / 4096L + 1L) * 4096L;
+    [_regions appendBytes:&r length:sizeof(r)];
+    [_regionData addObject:owner ? owner : [NSNull null]];
+    os_unfair_lock_unlock(&_regionLock);
+    
+    if(_debug)
+        NSLog(@"STORAGE: map %ld external bytes at %ld%s", r.length, r.address,
+              r.readOnly ? " (read-only)" : "");
+    return r.address;
+}
+
+/**
+ Get the length of an external region.
+ @param address the virtual address of the start of the region
+ @returns the length of the region in bytes, or -1 if no region starts
+ at the address
+ */
+
+-(long) externalLength:(long) address
+{
+    TCStorageRegion r;
+    if( ![self regionFor:address length:0L into:&r] || r.address != address )
+        return -1L;
+    return r.length;
+}
+
+/**
+ Remove an external region from the address space, and release the data
+ object that backs it.
+ @param address the virtual address of the start of the region
+ @returns YES if a region was unmapped
+ */
+
+-(BOOL) unmapExternal:(long) address
+{
+    // The owner is released once the lock is dropped.
+    
+    id owner = nil;
+    os_unfair_lock_lock(&_regionLock);
+    TCStorageRegion * r = _regions.mutableBytes;
+    long count = _regions.length / sizeof(TCStorageRegion);
+    
+    for( long ix = 0; ix < count; ix++ ) {
+        if( r[ix].address == address ) {
+            if(_debug)
+                NSLog(@"STORAGE: unmap %ld external bytes at %ld", r[ix].length, address);
+            [_regions replaceBytesInRange:NSMakeRange(ix * sizeof(TCStorageRegion), sizeof(TCStorageRegion))
+                                withBytes:NULL
+                                   length:0];
+            owner = _regionData[ix];
+            [_regionData removeObjectAtIndex:ix];
+            break;
+        }
+    }
+    os_unfair_lock_unlock(&_regionLock);
+    return owner != nil;
+}
+
+#pragma mark - Files
+
+/**
+ Register an open file so the TinyC program can refer to it by handle.
+ @param file the open FILE pointer
+ @returns the handle for the file, which is never zero
+ */
+
+-(long) addFile:(FILE*) file
+{
+    NSValue * entry = [NSValue valueWithPointer:file];
+    os_unfair_lock_lock(&_fileLock);
+    long handle = 0L;
+    for( long ix = 0; ix < (long) _files.count; ix++ ) {
+        if( _files[ix] == [NSNull null] ) {
+            _files[ix] = entry;
+            handle = ix + 1;
+            break;
+        }
+    }
+    if( handle == 0L ) {
+        [_files addObject:entry];
+        handle = _files.count;
+    }
+    os_unfair_lock_unlock(&_fileLock);
+    return handle;
+}
+
+/**
+ Find the FILE pointer for a handle.
+ @param handle the handle returned when the file was added
+ @returns the file, or NULL if the handle is not open
+ */
+
+-(FILE*) fileForHandle:(long) handle
+{
+    FILE * file = NULL;
+    os_unfair_lock_lock(&_fileLock);
+    if( handle >= 1L && handle <= (long) _files.count ) {
+        id entry = _files[handle - 1];
+        if( entry != [NSNull null] )
+            file = (FILE*)[entry pointerValue];
+    }
+    os_unfair_lock_unlock(&_fileLock);
+    return file;
+}
+
+/**
+ Close a file and release its handle.
+ @param handle the handle returned when the file was added
+ @returns zero if the file was closed, or EOF if the handle is not open
+ or the close failed
+ */
+
+-(int) closeFile:(long) handle
+{
+    // The handle is released under the lock, so only one thread can
+    // close the file.
+    
+    FILE * file = NULL;
+    os_unfair_lock_lock(&_fileLock);
+    if( handle >= 1L && handle <= (long) _files.count && _files[handle - 1] != [NSNull null] ) {
+        file = (FILE*)[_files[handle - 1] pointerValue];
+        _files[handle - 1] = [NSNull null];
+    }
+    os_unfair_lock_unlock(&_fileLock);
+    if( file == NULL )
+        return EOF;
+    return fclose(file);
+}
+
 #pragma mark - Memory Accessors
 
+/**
+ Translate a single virtual address for one of the typed accessors.  In
+ the storage buffer this is the same test as isFault:, so the accessors
+ behave exactly as they always have; only external regions are checked
+ for the full width of the access and for write protection.
+ @param address the virtual address of the value
+ @param width the size of the value in bytes
+ @param write YES if the value is to be stored
+ */
+
+-(char*) pointerTo:(long) address width:(long) width forWrite:(BOOL) write
+{
+    if( write )
+        runtimeCounters.writes++;
+    else
+        runtimeCounters.reads++;
+    
+    if( address >= TCSTORAGE_EXTERNAL_BASE ) {
+        TCStorageRegion r;
+        if( ![self regionFor:address length:width into:&r] || (write && r.readOnly))
+            return NULL;
+        return r.data + (address - r.address);
+    }
+    if([self isFault:address])
+        return NULL;
+    return _buffer + address;
+}
+
 -(TCValue*) getValue:(long)address ofType:(TCValueType) type
 {
     
@@ -362,6 +909,10 @@ const char * typeName( TCValueType t )
                 v = [[TCValue alloc]initWithDouble:[self getDouble:address]];
                 break;
                 
+            case TCVALUE_FLOAT:
+                v = [[TCValue alloc]initWithFloat:[self getFloat:address]];
+                break;
+                
             case TCVALUE_BOOLEAN:
             case TCVALUE_CHAR:
                 v = [[TCValue alloc]initWithInt:(int)[self getChar:address]];
@@ -414,6 +965,9 @@ const char * typeName( TCValueType t )
             case TCVALUE_DOUBLE:
                 [self setDouble:value.getDouble at:address];
                 break;
+            case TCVALUE_FLOAT:
+                [self setFloat:value.getFloat at:address];
+                break;
 
             default:
                 NSLog(@"FATAL - storage setValue type %s %d not implemented", typeName(value.getType), value.getType);
@@ -423,80 +977,100 @@ const char * typeName( TCValueType t )
 
 -(char) getChar:(long)address
 {
-    
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(char) forWrite:NO];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return 0;
     }
-    char result = _buffer[address];
+    char result = *p;
     if(_debug)
         NSLog(@"STORAGE: read char %d from %ld", result, address);
+    if( activeTrace )
+        traceEvent(TCTRACE_READ, TCVALUE_CHAR, address, (long) result);
     
     return result;
 }
 
 -(void) setChar:(char)value at:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(char) forWrite:YES];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return;
     }
-    _buffer[address] = value;
+    if( activeTrace )
+        traceEvent(TCTRACE_WRITE, TCVALUE_CHAR, address, (long) value);
+    *p = value;
 }
 
 -(int) getInt:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(int) forWrite:NO];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return 0;
     }
-    int result = *((int*)(&( _buffer[address])));
+    int result = *(int*) p;
     if(_debug)
         NSLog(@"STORAGE: read int %d from %ld", result, address);
+    if( activeTrace )
+        traceEvent(TCTRACE_READ, TCVALUE_INT, address, (long) result);
     return result;
 }
 
 -(void) setInt:(int)value at:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(int) forWrite:YES];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return;
     }
-    *(int*)&( _buffer[address]) = value;
+    if( activeTrace )
+        traceEvent(TCTRACE_WRITE, TCVALUE_INT, address, (long) value);
+    *(int*) p = value;
 }
 
 
 -(long) getLong:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(long) forWrite:NO];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return 0;
     }
-    long result = *(long*)&( _buffer[address]);
+    long result = *(long*) p;
     if(_debug)
         NSLog(@"STORAGE: read long %ld from %ld", result, address);
+    if( activeTrace )
+        traceEvent(TCTRACE_READ, TCVALUE_LONG, address, (long) result);
     
     return result;
 }
 
 -(void) setLong:(long)value at:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(long) forWrite:YES];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return;
     }
-    *(long*)&( _buffer[address]) = value;
+    if( activeTrace )
+        traceEvent(TCTRACE_WRITE, TCVALUE_LONG, address, value);
+    *(long*) p = value;
 }
 
 -(double) getDouble:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(double) forWrite:NO];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return 0.0;
     }
-    double result = *(double*)&( _buffer[address]);
+    double result = *(double*) p;
     if(_debug)
         NSLog(@"STORAGE: read double %f from %ld", result, address);
+    if( activeTrace )
+        traceEvent(TCTRACE_READ, TCVALUE_DOUBLE, address, *(long*) p);
     
     return result ;
 }
@@ -504,23 +1078,61 @@ const char * typeName( TCValueType t )
 
 -(void) setDouble:(double) value at:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(double) forWrite:YES];
+    if( p == NULL ) {
+        NSLog(@"Address fault %08lX, _current = %ld", address, _current);
+        return;
+    }
+    *(double*) p = value;
+    if( activeTrace )
+        traceEvent(TCTRACE_WRITE, TCVALUE_DOUBLE, address, *(long*) p);
+}
+
+-(float) getFloat:(long)address
+{
+    char * p = [self pointerTo:address width:sizeof(float) forWrite:NO];
+    if( p == NULL ) {
+        NSLog(@"Address fault %08lX, _current = %ld", address, _current);
+        return 0.0f;
+    }
+    float result = *(float*) p;
+    if(_debug)
+        NSLog(@"STORAGE: read float %f from %ld", result, address);
+    if( activeTrace )
+        traceEvent(TCTRACE_READ, TCVALUE_FLOAT, address, (long) *(int*) p);
+    
+    return result ;
+}
+
+
+-(void) setFloat:(float) value at:(long)address
+{
+    char * p = [self pointerTo:address width:sizeof(float) forWrite:YES];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return;
     }
-    *(double*)&( _buffer[address]) = value = value;
+    *(float*) p = value;
+    if( activeTrace )
+        traceEvent(TCTRACE_WRITE, TCVALUE_FLOAT, address, (long) *(int*) p);
 }
 
 -(NSString*) getString:(long)address
 {
-    if([self isFault:address]) {
+    char * p = [self pointerTo:address width:sizeof(char) forWrite:NO];
+    if( p == NULL ) {
         NSLog(@"Address fault %08lX, _current = %ld", address, _current);
         return nil;
     }
     
+    long end = _size;
+    TCStorageRegion r;
+    if( address >= TCSTORAGE_EXTERNAL_BASE && [self regionFor:address length:1L into:&r] )
+        end = r.address + r.length;
+    
     NSMutableString * result = [NSMutableString string];
-    for( long ix = address; ix < _size; ix++ ) {
-        char ch = _buffer[ix];
+    for( long ix = address; ix < end; ix++ ) {
+        char ch = p[ix - address];
         [result appendFormat:@"%c", ch];
         if( ch == 0 )
             break;
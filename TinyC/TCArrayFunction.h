@@ -0,0 +1,63 @@
+//
+//  TCArrayFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Base class for the array_ builtins, which run numeric kernels directly
+//  over int, long, float or double arrays in runtime storage.  The range
+//  of each array argument is checked once, and the loop then works on the
+//  real memory with no TCValue or storage call per element.
+
+#import "TCFunction.h"
+
+/**
+ Run a statement once for each element type an array builtin supports.
+ Within the statement T is the C type of the elements, A is the type
+ used to accumulate them (long or double), and REAL is 1 for float and
+ double elements.
+ */
+#define TCARRAY_DISPATCH(type, ...) \
+    switch(type) { \
+        case TCVALUE_INT: \
+            { typedef int T;    typedef long A;   enum { REAL = 0 }; (void) sizeof(A); __VA_ARGS__; } break; \
+        case TCVALUE_LONG: \
+            { typedef long T;   typedef long A;   enum { REAL = 0 }; (void) sizeof(A); __VA_ARGS__; } break; \
+        case TCVALUE_FLOAT: \
+            { typedef float T;  typedef double A; enum { REAL = 1 }; (void) sizeof(A); __VA_ARGS__; } break; \
+        case TCVALUE_DOUBLE: \
+            { typedef double T; typedef double A; enum { REAL = 1 }; (void) sizeof(A); __VA_ARGS__; } break; \
+        default: \
+            break; \
+    }
+
+@interface TCArrayFunction : TCFunction
+
+/**
+ Get a real pointer to the elements of an array argument.  If the
+ argument is not a pointer to int, long, float or double, or the elements
+ are not all addressable, the error property is set.
+ @param value the argument, which must be a pointer
+ @param count the number of elements the caller will touch
+ @param type set to the type of the elements
+ @param write YES if the function will store into the elements
+ @param position the argument number, starting at 1, for error messages
+ @return a pointer to the first element, or NULL if there was an error
+ */
+-(void*) elementsOf:(TCValue*) value
+              count:(long) count
+               type:(TCValueType*) type
+           forWrite:(BOOL) write
+           argument:(int) position;
+
+/**
+ Make the result of a reduction.  Integer arrays give a long, and float
+ and double arrays give a double.
+ @param type the element type of the array reduced
+ @param integer the result for an integer array
+ @param real the result for a floating point array
+ */
+-(TCValue*) resultFor:(TCValueType) type integer:(long) integer real:(double) real;
+
+@end
@@ -0,0 +1,49 @@
+//
+//  TCArrayFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCArrayFunction.h"
+
+@implementation TCArrayFunction
+
+-(void*) elementsOf:(TCValue *)value
+              count:(long)count
+               type:(TCValueType *)type
+           forWrite:(BOOL)write
+           argument:(int)position
+{
+    TCValueType t = value.getType;
+    if( t > TCVALUE_POINTER )
+        t = t - TCVALUE_POINTER;
+    else
+        t = TCVALUE_UNDEFINED;
+
+    if( t != TCVALUE_INT && t != TCVALUE_LONG && t != TCVALUE_FLOAT && t != TCVALUE_DOUBLE ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:position]];
+        return NULL;
+    }
+    if( count < 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARRAY_BOUNDS
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithLong:count]];
+        return NULL;
+    }
+
+    *type = t;
+    return [self pointerTo:value.getLong count:count size:[TCValue sizeOf:t] forWrite:write];
+}
+
+-(TCValue*) resultFor:(TCValueType)type integer:(long)integer real:(double)real
+{
+    if( type == TCVALUE_FLOAT || type == TCVALUE_DOUBLE )
+        return [[TCValue alloc]initWithDouble:real];
+    return [[TCValue alloc]initWithLong:integer];
+}
+
+@end
@@ -67,32 +67,33 @@
         // See if it is an array reference
         if([parser isNextToken:TOKEN_BRACKET_LEFT]) {
             
-            // Parse the array index expression using the expression parser.
-            // if we get an error, reset the parser position and report that
-            // no lvalue was found.
-            TCExpressionParser * expParser = [[TCExpressionParser alloc]init];
-            TCSyntaxNode * arrayExpression = [expParser parse:parser];
-            if( parser.error) {
-                [parser setPosition:savedPosition];
-                return nil;
-            }
-            if( arrayExpression == nil)
-                return nil;
-            
-            // There has to be a closing bracket after the index expression
-            if(![parser isNextToken:TOKEN_BRACKET_RIGHT]) {
-                parser.error = [[TCError alloc]initWithCode:TCERROR_BRACEMISMATCH usingScanner:parser];
-                return nil;
-            }
+            NSMutableArray * indexes = [NSMutableArray array];
+            do {
+                // Parse the array index expression using the expression parser.
+                // if we get an error, reset the parser position and report that
+                // no lvalue was found.
+                TCExpressionParser * expParser = [[TCExpressionParser alloc]init];
+                TCSyntaxNode * arrayExpression = [expParser parse:parser];
+                if( parser.error) {
+                    [parser setPosition:savedPosition];
+                    return nil;
+                }
+                if( arrayExpression == nil)
+                    return nil;
+                
+                // There has to be a closing bracket after the index expression
+                if(![parser isNextToken:TOKEN_BRACKET_RIGHT]) {
+                    parser.error = [[TCError alloc]initWithCode:TCERROR_BRACEMISMATCH usingScanner:parser];
+                    return nil;
+                }
+                [indexes addObject:arrayExpression];
+            } while([parser isNextToken:TOKEN_BRACKET_LEFT]);
             
             // Change the node type we are returning from a simple address
-            // to an array reference, which has a subnode that is the index
-            // expression.
-            //
-            // @NOTE Later when multidimensional arrays are supported
-            // this can be a list of index expressions.
+            // to an array reference, which has a subnode for each index
+            // expression, outermost dimension first.
             lvalue.nodeType = LANGUAGE_ARRAY;
-            lvalue.subNodes = [NSMutableArray arrayWithArray:@[arrayExpression]];
+            lvalue.subNodes = indexes;
         }
         
         // Was it a pointer dereference of the simple identifier.  If so, then
@@ -0,0 +1,38 @@
+//
+//  TCAtomicFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Base class for the atomic_ builtins, which read and update an int or
+//  long in runtime storage so that threads started with spawn() can share
+//  it safely.  Each operation is sequentially consistent.  The dynamic
+//  area only aligns blocks to four bytes, so a long that is not on an
+//  eight byte boundary is updated under a lock instead of with the
+//  processor's atomic instructions.
+
+#import "TCArrayFunction.h"
+
+typedef enum {
+    TCATOMIC_LOAD,
+    TCATOMIC_STORE,
+    TCATOMIC_ADD,
+    TCATOMIC_CAS
+} TCAtomicOperation;
+
+@interface TCAtomicFunction : TCArrayFunction
+
+/**
+ Perform an atomic operation on the cell the first argument points to.
+ If it is not a pointer to an addressable int or long, the error
+ property is set.
+ @param operation the operation
+ @param arguments the builtin's arguments: the pointer, then the value to
+ store or add, or the expected and desired values for a compare-exchange
+ @return the value loaded, the value stored, or the value the cell held
+ before an add or compare-exchange, or nil if there was an error
+ */
+-(TCValue*) perform:(TCAtomicOperation) operation arguments:(NSArray*) arguments;
+
+@end
@@ -0,0 +1,95 @@
+//
+//  TCAtomicFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCAtomicFunction.h"
+#import <os/lock.h>
+
+/** Guards every cell too badly aligned for the atomic instructions */
+static os_unfair_lock misalignedLock = OS_UNFAIR_LOCK_INIT;
+
+/**
+ Apply an operation to a cell of type T with the compiler's atomic
+ builtins, leaving the result in the long named by result.
+ */
+#define TCATOMIC_APPLY(T, cell, operation, value, desired, result) \
+    switch(operation) { \
+        case TCATOMIC_LOAD: \
+            result = __atomic_load_n((T*) cell, __ATOMIC_SEQ_CST); \
+            break; \
+        case TCATOMIC_STORE: \
+            __atomic_store_n((T*) cell, (T) value, __ATOMIC_SEQ_CST); \
+            result = (T) value; \
+            break; \
+        case TCATOMIC_ADD: \
+            result = __atomic_fetch_add((T*) cell, (T) value, __ATOMIC_SEQ_CST); \
+            break; \
+        case TCATOMIC_CAS: { \
+            T expected = (T) value; \
+            __atomic_compare_exchange_n((T*) cell, &expected, (T) desired, false, \
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST); \
+            result = expected; \
+            break; \
+        } \
+    }
+
+/**
+ Apply an operation to a cell of type T that is not aligned, under the
+ lock.
+ */
+#define TCATOMIC_LOCKED(T, cell, operation, value, desired, result) \
+    { \
+        T old; \
+        os_unfair_lock_lock(&misalignedLock); \
+        memcpy(&old, cell, sizeof(T)); \
+        T updated = old; \
+        switch(operation) { \
+            case TCATOMIC_LOAD: break; \
+            case TCATOMIC_STORE: updated = (T) value; old = updated; break; \
+            case TCATOMIC_ADD: updated = old + (T) value; break; \
+            case TCATOMIC_CAS: if( old == (T) value ) updated = (T) desired; break; \
+        } \
+        memcpy(cell, &updated, sizeof(T)); \
+        os_unfair_lock_unlock(&misalignedLock); \
+        result = old; \
+    }
+
+@implementation TCAtomicFunction
+
+-(TCValue*) perform:(TCAtomicOperation)operation arguments:(NSArray *)arguments
+{
+    TCValueType type = TCVALUE_UNDEFINED;
+    void * cell = [self elementsOf:arguments[0] count:1 type:&type forWrite:YES argument:1];
+    if( cell == NULL )
+        return nil;
+    if( type != TCVALUE_INT && type != TCVALUE_LONG ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:1]];
+        return nil;
+    }
+
+    long value = arguments.count > 1 ? [arguments[1] getLong] : 0L;
+    long desired = arguments.count > 2 ? [arguments[2] getLong] : 0L;
+    long result = 0L;
+
+    if( type == TCVALUE_INT ) {
+        if( ((uintptr_t) cell & (sizeof(int) - 1)) == 0 )
+            TCATOMIC_APPLY(int, cell, operation, value, desired, result)
+        else
+            TCATOMIC_LOCKED(int, cell, operation, value, desired, result)
+        return [[TCValue alloc]initWithInt:(int) result];
+    }
+
+    if( ((uintptr_t) cell & (sizeof(long) - 1)) == 0 )
+        TCATOMIC_APPLY(long, cell, operation, value, desired, result)
+    else
+        TCATOMIC_LOCKED(long, cell, operation, value, desired, result)
+    return [[TCValue alloc]initWithLong:result];
+}
+
+@end
@@ -0,0 +1,44 @@
+//
+//  TCBoundsAnalyzer.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Compile-time pass that finds array indexes which cannot be out of
+//  bounds, so the interpreter can skip checking them.  The common case is
+//  a counted loop such as
+//
+//      for( i = 0; i < 10; i++ )
+//          a[i] = 0;
+//
+//  where a is declared with at least ten elements and the body never
+//  assigns i.  Constant indexes within the declared extent are proven too.
+
+#import <Foundation/Foundation.h>
+
+@class TCSyntaxNode;
+
+@interface TCBoundsAnalyzer : NSObject
+
+{
+    /** Each declared name mapped to its array dimensions, or to NSNull if
+        it is not an array or is declared with more than one shape */
+    NSMutableDictionary * _shapes;
+
+    /** The names whose address is taken with & anywhere in the function
+        being walked */
+    NSMutableSet * _addressed;
+}
+
+/** The number of index expressions proven to be in bounds */
+@property (readonly) long provenCount;
+
+/**
+ Mark the array references in a module whose indexes are known to be in
+ bounds, by setting the provenIndexes of each ARRAY node.
+ @param tree the parse tree of the module
+ */
+-(void) analyze:(TCSyntaxNode*) tree;
+
+@end
@@ -0,0 +1,288 @@
+//
+//  TCBoundsAnalyzer.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCBoundsAnalyzer.h"
+#import "TCSyntaxNode.h"
+#import "TCToken.h"
+#import "TCValue.h"
+
+/**
+ Skip over EXPRESSION nodes that only wrap a single subexpression.
+ */
+static TCSyntaxNode * unwrap( TCSyntaxNode * node )
+{
+    while( node.nodeType == LANGUAGE_EXPRESSION && node.subNodes.count == 1 )
+        node = node.subNodes[0];
+    return node;
+}
+
+/**
+ Get the value of an integer constant node.
+ @return YES if the node is an integer constant
+ */
+static BOOL integerConstant( TCSyntaxNode * node, long * value )
+{
+    node = unwrap(node);
+    if( node.nodeType != LANGUAGE_SCALAR || node.action != TOKEN_INTEGER )
+        return NO;
+    *value = node.spelling.longLongValue;
+    return YES;
+}
+
+/**
+ Is a node a plain reference to the value of a named variable?
+ */
+static BOOL isReference( TCSyntaxNode * node, NSString * name )
+{
+    node = unwrap(node);
+    return node.nodeType == LANGUAGE_REFERENCE && node.subNodes.count == 0 &&
+           [node.spelling isEqualToString:name];
+}
+
+/**
+ Is a node the address of a named variable, either as the target of an
+ assignment or as the operand of &?
+ */
+static BOOL isAddressOf( TCSyntaxNode * node, NSString * name )
+{
+    return node.nodeType == LANGUAGE_ADDRESS && node.subNodes.count == 0 &&
+           [node.spelling isEqualToString:name];
+}
+
+/**
+ Count the places in a tree where the address of a variable is taken.
+ */
+static long addressCount( TCSyntaxNode * node, NSString * name )
+{
+    long count = isAddressOf(node, name) ? 1 : 0;
+    for( TCSyntaxNode * sub in node.subNodes )
+        count += addressCount(sub, name);
+    return count;
+}
+
+/**
+ Collect the names in a tree whose address is taken with &.  Assignment
+ targets are ADDRESS nodes too, so those are skipped.
+ */
+static void collectAddressed( TCSyntaxNode * node, NSMutableSet * names )
+{
+    for( NSUInteger ix = 0; ix < node.subNodes.count; ix++ ) {
+        TCSyntaxNode * sub = node.subNodes[ix];
+        BOOL target = node.nodeType == LANGUAGE_ASSIGNMENT && ix == 0;
+        if( !target && sub.nodeType == LANGUAGE_ADDRESS && sub.subNodes.count == 0 && sub.spelling )
+            [names addObject:sub.spelling];
+        collectAddressed(sub, names);
+    }
+}
+
+/**
+ Count the assignments in a tree of the form name = name + step, where
+ step is a positive constant.  This is how both name++ and ++name are
+ parsed.
+ */
+static long incrementCount( TCSyntaxNode * node, NSString * name )
+{
+    long count = 0;
+    if( node.nodeType == LANGUAGE_ASSIGNMENT && node.subNodes.count == 2 &&
+        isAddressOf(node.subNodes[0], name)) {
+        TCSyntaxNode * sum = unwrap(node.subNodes[1]);
+        long step = 0;
+        if( sum.nodeType == LANGUAGE_DIADIC && sum.action == TOKEN_ADD && sum.subNodes.count == 2 &&
+            isReference(sum.subNodes[0], name) && integerConstant(sum.subNodes[1], &step) && step > 0 )
+            count++;
+    }
+    for( TCSyntaxNode * sub in node.subNodes )
+        count += incrementCount(sub, name);
+    return count;
+}
+
+@implementation TCBoundsAnalyzer
+
+-(instancetype) init
+{
+    if(( self = [super init])) {
+        _shapes = [NSMutableDictionary dictionary];
+        _provenCount = 0L;
+    }
+    return self;
+}
+
+-(void) analyze:(TCSyntaxNode *)tree
+{
+    [self collectShapes:tree];
+    [self walk:tree ranges:[NSMutableDictionary dictionary] locals:[NSMutableDictionary dictionary]];
+}
+
+/**
+ Record the shape of every name declared in the module.  Array references
+ are only resolved at runtime, so an index can only be proven against a
+ name that has the same shape everywhere it is declared.
+ */
+-(void) collectShapes:(TCSyntaxNode*) node
+{
+    if( node.nodeType == LANGUAGE_NAME && node.spelling ) {
+        id shape = node.dimensions ? node.dimensions : [NSNull null];
+        id previous = _shapes[node.spelling];
+        if( previous == nil )
+            _shapes[node.spelling] = shape;
+        else if( ![previous isEqual:shape] )
+            _shapes[node.spelling] = [NSNull null];
+    }
+    for( TCSyntaxNode * sub in node.subNodes )
+        [self collectShapes:sub];
+}
+
+/**
+ See if a FOR loop counts a local integer variable up from a non-negative
+ constant to a constant limit.
+ @param loop the FOR node
+ @param locals the variables declared in the enclosing function, mapped
+ to their types
+ @param limit set to the exclusive upper bound of the variable in the body
+ @return the name of the loop variable, or nil if the loop does not qualify
+ */
+-(NSString*) inductionVariable:(TCSyntaxNode*) loop locals:(NSDictionary*) locals limit:(long*) limit
+{
+    // The initializer must be name = constant.  Globals are not considered,
+    // as a function called from the body could change them, and neither is
+    // a variable whose address is taken anywhere in the function, as it
+    // could be changed through the pointer.
+
+    TCSyntaxNode * init = unwrap(loop.subNodes[0]);
+    if( init.nodeType != LANGUAGE_ASSIGNMENT || init.subNodes.count != 2 )
+        return nil;
+    TCSyntaxNode * target = init.subNodes[0];
+    NSString * name = target.spelling;
+    if( !isAddressOf(target, name))
+        return nil;
+    int type = [locals[name] intValue];
+    if( [_addressed containsObject:name] )
+        return nil;
+    if( type != TCVALUE_INT && type != TCVALUE_LONG )
+        return nil;
+    long start = 0;
+    if( !integerConstant(init.subNodes[1], &start) || start < 0 )
+        return nil;
+
+    // The termination test must be name < constant or name <= constant.
+
+    TCSyntaxNode * term = unwrap(loop.subNodes[1]);
+    long bound = 0;
+    if( term.nodeType != LANGUAGE_RELATION || term.subNodes.count != 2 ||
+        !isReference(term.subNodes[0], name) || !integerConstant(term.subNodes[1], &bound))
+        return nil;
+    if( term.action == TOKEN_LESS_OR_EQUAL )
+        bound++;
+    else if( term.action != TOKEN_LESS )
+        return nil;
+
+    // The increment clause may only step the variable upward, and the body
+    // must not change it at all.
+
+    TCSyntaxNode * increment = loop.subNodes[2];
+    long steps = incrementCount(increment, name);
+    if( steps == 0 || steps != addressCount(increment, name))
+        return nil;
+    if( addressCount(loop.subNodes[3], name) > 0 )
+        return nil;
+
+    *limit = bound;
+    return name;
+}
+
+/**
+ Mark the indexes of an ARRAY node that are proven to be in bounds.
+ */
+-(void) markArray:(TCSyntaxNode*) node ranges:(NSDictionary*) ranges
+{
+    id shape = _shapes[node.spelling];
+    if( ![shape isKindOfClass:[NSArray class]] )
+        return;
+    NSArray * dimensions = shape;
+
+    unsigned int proven = 0;
+    for( int ix = 0; ix < node.subNodes.count && ix < dimensions.count; ix++ ) {
+        long extent = [dimensions[ix] longValue];
+        TCSyntaxNode * index = unwrap(node.subNodes[ix]);
+        long value = 0;
+
+        if( integerConstant(index, &value)) {
+            if( value >= 0 && value < extent )
+                proven |= 1U << ix;
+        } else if( index.nodeType == LANGUAGE_REFERENCE && index.spelling ) {
+            NSNumber * limit = ranges[index.spelling];
+            if( isReference(index, index.spelling) && limit && limit.longValue <= extent )
+                proven |= 1U << ix;
+        }
+    }
+    if( proven ) {
+        node.provenIndexes = proven;
+        _provenCount += __builtin_popcount(proven);
+    }
+}
+
+/**
+ Walk the tree, keeping track of the loop variables whose range is known
+ and the local variables of the current function.  Blocks and functions
+ start new scopes, and a declaration hides any loop variable of the same
+ name for the rest of its scope.
+ */
+-(void) walk:(TCSyntaxNode*) node ranges:(NSMutableDictionary*) ranges locals:(NSMutableDictionary*) locals
+{
+    switch( node.nodeType ) {
+
+        case LANGUAGE_ENTRYPOINT:
+            ranges = [NSMutableDictionary dictionary];
+            locals = [NSMutableDictionary dictionary];
+            _addressed = [NSMutableSet set];
+            collectAddressed(node, _addressed);
+            break;
+
+        case LANGUAGE_BLOCK:
+            ranges = [ranges mutableCopy];
+            locals = [locals mutableCopy];
+            break;
+
+        case LANGUAGE_DECLARE:
+            for( TCSyntaxNode * name in node.subNodes ) {
+                if( name.spelling == nil )
+                    continue;
+                [ranges removeObjectForKey:name.spelling];
+                locals[name.spelling] = [NSNumber numberWithInt:name.action];
+            }
+            break;
+
+        case LANGUAGE_ARRAY:
+            [self markArray:node ranges:ranges];
+            break;
+
+        case LANGUAGE_FOR:
+        {
+            long limit = 0;
+            NSString * name = [self inductionVariable:node locals:locals limit:&limit];
+            for( int ix = 0; ix < 3; ix++ )
+                [self walk:node.subNodes[ix] ranges:ranges locals:locals];
+
+            NSMutableDictionary * bodyRanges = ranges;
+            if( name ) {
+                bodyRanges = [ranges mutableCopy];
+                bodyRanges[name] = [NSNumber numberWithLong:limit];
+            }
+            [self walk:node.subNodes[3] ranges:bodyRanges locals:locals];
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    for( TCSyntaxNode * sub in node.subNodes )
+        [self walk:sub ranges:ranges locals:locals];
+}
+
+@end
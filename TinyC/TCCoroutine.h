@@ -0,0 +1,104 @@
+//
+//  TCCoroutine.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  A TinyC function running as a coroutine.  It runs until it calls
+//  yield(), which hands a value back to whoever resumed it, and carries on
+//  from the same point the next time it is resumed.
+//
+//  The interpreter walks the tree recursively, so the place a coroutine is
+//  suspended is a host call stack.  Each coroutine therefore runs on its
+//  own host thread, and control is handed back and forth with a pair of
+//  semaphores, so exactly one of the coroutine and its resumer is running
+//  at any time.  Its automatic storage is a block of the dynamic area that
+//  its thread adopts as its stack in the storage manager.  The interpreter's
+//  per-thread hooks (counters, limits, profilers, trace, random generator
+//  and scheduler slice) are handed across with control.
+
+#import <Foundation/Foundation.h>
+#import "TCValue.h"
+#import "TCError.h"
+
+@class TCSyntaxNode;
+@class TCStorageManager;
+@class TCRuntimeSymbolTable;
+
+/** The bytes of automatic storage given to each coroutine */
+#define TCCOROUTINE_STACK 16384L
+
+/** The size of the host stack of each coroutine thread */
+#define TCCOROUTINE_HOST_STACK (8L * 1024L * 1024L)
+
+@interface TCCoroutine : NSObject
+
+/** The number a program uses to refer to the coroutine */
+@property (readonly) long handle;
+
+/** Has the function returned? */
+@property (readonly) BOOL done;
+
+/** The error that ended the function, or that stopped a resume */
+@property TCError * error;
+
+/**
+ Create a coroutine for a function.  It does not start running until it
+ is first resumed.
+ @param entry the ENTRYPOINT of the function
+ @param arguments the values of the function's parameters
+ @param symbols the symbols the function can see
+ @param storage the runtime storage of the program
+ @return the coroutine, or nil if there is no storage for its stack
+ */
+-(instancetype) initWithEntry:(TCSyntaxNode*) entry
+                    arguments:(NSArray*) arguments
+                      symbols:(TCRuntimeSymbolTable*) symbols
+                      storage:(TCStorageManager*) storage;
+
+/**
+ Find a coroutine from its handle.  A program can only use the
+ coroutines it made.
+ @param handle the handle
+ @param storage the runtime storage of the program asking
+ @return the coroutine, or nil if the program has no such coroutine
+ */
++(TCCoroutine*) coroutineFor:(long) handle storage:(TCStorageManager*) storage;
+
+/**
+ Get the coroutine running on this thread.
+ @return the coroutine, or nil if a program's main code is running
+ */
++(TCCoroutine*) current;
+
+/**
+ Run the coroutine until it yields or returns.
+ @param value the value the suspended yield() returns
+ @return the value yielded, or the function result when it returns, or nil
+ if there was an error, which is stored in the error property
+ */
+-(TCValue*) resume:(TCValue*) value;
+
+/**
+ Suspend the running coroutine and hand a value to its resumer.  This is
+ called on the coroutine's own thread.
+ @param value the value to hand back
+ @return the value passed to the next resume, or nil if the coroutine is
+ being released and should unwind
+ */
+-(TCValue*) yield:(TCValue*) value;
+
+/**
+ Release the coroutine.  If it is suspended it is made to unwind first,
+ and its storage is freed.
+ */
+-(void) cancel;
+
+/**
+ Release every coroutine of a program, as at the end of its execution.
+ @param storage the runtime storage of the program
+ */
++(void) cancelAllInStorage:(TCStorageManager*) storage;
+
+@end
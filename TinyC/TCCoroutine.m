@@ -0,0 +1,279 @@
+//
+//  TCCoroutine.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCCoroutine.h"
+#import "TCSyntaxNode.h"
+#import "TCStorageManager.h"
+#import "TCExecutionContext.h"
+#import "TCRuntimeSymbolTable.h"
+#import "TCMetrics.h"
+#import "TCProfiler.h"
+#import "TCHeapProfiler.h"
+#import "TCTraceBuffer.h"
+#import "TCRandom.h"
+#import "TCScheduler.h"
+#import "TCThread.h"
+
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+/** The live coroutines of every program, by handle */
+static NSMutableDictionary * coroutines = nil;
+
+/** The handle to give the next coroutine */
+static long nextHandle = 1L;
+
+/** The coroutine running on this thread, or nil for a program's main thread */
+static __thread __unsafe_unretained TCCoroutine * currentCoroutine = nil;
+
+/**
+ The interpreter hooks are per-thread, so they are carried across each
+ switch between a coroutine's thread and its resumer's.
+ */
+typedef struct {
+    __unsafe_unretained TCProfiler * profiler;
+    __unsafe_unretained TCHeapProfiler * heapProfiler;
+    TCTraceRing * trace;
+    TCRandomState * random;
+    __unsafe_unretained TCRuntimeSymbolTable * globals;
+    TCSlice * slice;
+    TCRuntimeCounters counters;
+    TCRuntimeLimits limits;
+} TCCoroutineHooks;
+
+static void saveHooks(TCCoroutineHooks * hooks)
+{
+    hooks->profiler = activeProfiler;
+    hooks->heapProfiler = activeHeapProfiler;
+    hooks->trace = activeTrace;
+    hooks->random = activeRandom;
+    hooks->globals = activeGlobals;
+    hooks->slice = activeSlice;
+    hooks->counters = runtimeCounters;
+    hooks->limits = runtimeLimits;
+}
+
+static void installHooks(TCCoroutineHooks * hooks)
+{
+    activeProfiler = hooks->profiler;
+    activeHeapProfiler = hooks->heapProfiler;
+    activeTrace = hooks->trace;
+    activeRandom = hooks->random;
+    activeGlobals = hooks->globals;
+    activeSlice = hooks->slice;
+    runtimeCounters = hooks->counters;
+    runtimeLimits = hooks->limits;
+}
+
+@implementation TCCoroutine
+
+{
+    TCSyntaxNode * _entry;
+    NSArray * _arguments;
+    TCRuntimeSymbolTable * _symbols;
+    TCStorageManager * _storage;
+    TCExecutionContext * _module;
+
+    /** Signalled to let the coroutine run */
+    dispatch_semaphore_t _run;
+
+    /** Signalled when the coroutine yields or returns */
+    dispatch_semaphore_t _pause;
+
+    /** The value passed across the last switch, in either direction */
+    TCValue * _transfer;
+
+    /** The hooks passed across the last switch */
+    TCCoroutineHooks _hooks;
+
+    /** The coroutine's automatic stack, adopted by its thread */
+    TCStorageStack * _stack;
+
+    /** The address of the block holding the automatic stack */
+    long _stackAddress;
+
+    BOOL _started;
+    BOOL _cancelled;
+}
+
+-(instancetype) initWithEntry:(TCSyntaxNode *)entry
+                    arguments:(NSArray *)arguments
+                      symbols:(TCRuntimeSymbolTable *)symbols
+                      storage:(TCStorageManager *)storage
+{
+    if(( self = [super init])) {
+        _stackAddress = [storage allocateDynamic:TCCOROUTINE_STACK];
+        if( _stackAddress == 0L )
+            return nil;
+
+        _entry = entry;
+        _arguments = arguments;
+        _symbols = symbols;
+        _storage = storage;
+        _module = activeContext;
+        _run = dispatch_semaphore_create(0);
+        _pause = dispatch_semaphore_create(0);
+
+        _stack = [[TCStorageStack alloc]init];
+        _stack.base = _stackAddress;
+        _stack.current = _stackAddress;
+        _stack.limit = _stackAddress + TCCOROUTINE_STACK;
+
+        @synchronized([TCCoroutine class]) {
+            if( coroutines == nil )
+                coroutines = [NSMutableDictionary dictionary];
+            _handle = nextHandle++;
+            coroutines[@(_handle)] = self;
+        }
+    }
+    return self;
+}
+
++(TCCoroutine*) coroutineFor:(long)handle storage:(TCStorageManager *)storage
+{
+    TCCoroutine * coroutine = nil;
+    @synchronized([TCCoroutine class]) {
+        coroutine = coroutines[@(handle)];
+    }
+    return (coroutine && coroutine->_storage == storage) ? coroutine : nil;
+}
+
++(TCCoroutine*) current
+{
+    return currentCoroutine;
+}
+
+/**
+ Run the function on the coroutine's thread.  When it returns, control
+ goes back to the resumer for the last time.
+ */
+-(void) main
+{
+    @autoreleasepool {
+        installHooks(&_hooks);
+        currentCoroutine = self;
+        [_storage adoptStack:_stack];
+        runtimeCounters.calls++;
+        TCExecutionContext * context = [[TCExecutionContext alloc]initWithStorage:_storage];
+        context.debug = _module.debug;
+        context.assertAbort = _module.assertAbort;
+        context.module = _module.module;
+        context.symbols = _symbols;
+        activeContext = context;
+
+        TCValue * result = [context execute:_entry entryPoint:nil withArguments:_arguments];
+        if( !_cancelled )
+            _error = context.error;
+        _transfer = result;
+        _done = YES;
+        saveHooks(&_hooks);
+        dispatch_semaphore_signal(_pause);
+    }
+}
+
+/**
+ Hand control to the coroutine and wait for it to hand it back.
+ */
+-(void) switchTo
+{
+    TCExecutionContext * savedContext = activeContext;
+    saveHooks(&_hooks);
+
+    if( !_started ) {
+        _started = YES;
+        NSThread * thread = [[NSThread alloc]initWithTarget:self selector:@selector(main) object:nil];
+        thread.stackSize = TCCOROUTINE_HOST_STACK;
+        [thread start];
+    }
+    else
+        dispatch_semaphore_signal(_run);
+    dispatch_semaphore_wait(_pause, DISPATCH_TIME_FOREVER);
+
+    runtimeCounters = _hooks.counters;
+    runtimeLimits = _hooks.limits;
+    activeContext = savedContext;
+}
+
+/**
+ Give the stack block back to the dynamic area, once the function has
+ returned or will never run.
+ */
+-(void) releaseStack
+{
+    if( _stackAddress != 0L ) {
+        [_storage free:_stackAddress];
+        _stackAddress = 0L;
+    }
+}
+
+-(TCValue*) resume:(TCValue *)value
+{
+    if( _done ) {
+        _error = [[TCError alloc]initWithCode:TCERROR_COROUTINE
+                                       atNode:nil
+                                 withArgument:@"resume of a coroutine that has returned"];
+        return nil;
+    }
+    if( currentCoroutine == self ) {
+        _error = [[TCError alloc]initWithCode:TCERROR_COROUTINE
+                                       atNode:nil
+                                 withArgument:@"a coroutine cannot resume itself"];
+        return nil;
+    }
+
+    _transfer = value;
+    [self switchTo];
+
+    if( _done )
+        [self releaseStack];
+    return _error ? nil : _transfer;
+}
+
+-(TCValue*) yield:(TCValue *)value
+{
+    _transfer = value;
+    TCExecutionContext * context = activeContext;
+
+    saveHooks(&_hooks);
+    dispatch_semaphore_signal(_pause);
+    dispatch_semaphore_wait(_run, DISPATCH_TIME_FOREVER);
+    installHooks(&_hooks);
+
+    activeContext = context;
+    if( _cancelled )
+        return nil;
+    return _transfer;
+}
+
+-(void) cancel
+{
+    // A suspended coroutine is woken with the cancelled flag set, so its
+    // yield() fails and the function unwinds, releasing its thread.
+
+    if( _started && !_done ) {
+        _cancelled = YES;
+        [self switchTo];
+    }
+    [self releaseStack];
+    _done = YES;
+    @synchronized([TCCoroutine class]) {
+        [coroutines removeObjectForKey:@(_handle)];
+    }
+}
+
++(void) cancelAllInStorage:(TCStorageManager *)storage
+{
+    NSArray * live = nil;
+    @synchronized([TCCoroutine class]) {
+        live = [coroutines allValues];
+    }
+    for( TCCoroutine * coroutine in live )
+        if( coroutine->_storage == storage )
+            [coroutine cancel];
+}
+
+@end
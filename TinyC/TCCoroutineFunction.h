@@ -0,0 +1,24 @@
+//
+//  TCCoroutineFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Base class for the builtins that operate on a coroutine made by
+//  coroutine_new().  See TCCoroutine for how coroutines run.
+
+#import "TCFunction.h"
+#import "TCCoroutine.h"
+
+@interface TCCoroutineFunction : TCFunction
+
+/**
+ Find the coroutine a handle refers to.  If there is none, the error
+ property is set.
+ @param handle the value passed as the handle
+ @return the coroutine, or nil if the handle is not valid
+ */
+-(TCCoroutine*) coroutineFor:(TCValue*) handle;
+
+@end
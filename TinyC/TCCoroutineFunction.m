@@ -0,0 +1,23 @@
+//
+//  TCCoroutineFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCCoroutineFunction.h"
+
+@implementation TCCoroutineFunction
+
+-(TCCoroutine*) coroutineFor:(TCValue *)handle
+{
+    TCCoroutine * coroutine = [TCCoroutine coroutineFor:handle.getLong storage:self.storage];
+    if( coroutine == nil )
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:1]];
+    return coroutine;
+}
+
+@end
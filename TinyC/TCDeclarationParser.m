@@ -13,6 +13,7 @@
 #import "TCToken.h"
 #import "TCTypeParser.h"
 #import "TCSyntaxNode.h"
+#import "TCRuntimeSymbol.h"
 
 TCValueType tokenToType( TokenType tok )
 {
@@ -119,25 +120,58 @@ TCValueType tokenToType( TokenType tok )
         varData.spelling = [scanner lastSpelling];
         
         // See if this is an array declaration. This would be followed by
-        // "[", expression, "]".  In this case, we convert the type to a
-        // pointer, but preallocate the space it points to based on the
-        // array size.
+        // "[", expression, "]", once for each dimension.  In this case, we
+        // convert the type to a pointer, but preallocate the space it points
+        // to based on the array size.  The dimensions are kept on the name
+        // so the row-major strides can be worked out once, when the array
+        // is created.
         
         if([scanner isNextToken:TOKEN_BRACKET_LEFT]) {
             
-            // We need an initializer here, which can be parsed
-            // as a constant literal.
-            
-            TCExpressionParser * initExpression = [[TCExpressionParser alloc]init];
-            TCSyntaxNode * expression = [initExpression parse:scanner];
-            if( expression == nil)
-                return nil;
-            TCExpressionInterpreter * initInterp = [[TCExpressionInterpreter alloc]init];
-            TCValue * initValue = [initInterp evaluate:expression withSymbols:nil];
-            if( initValue == nil)
-                return nil;
+            NSMutableArray * dimensions = [NSMutableArray array];
+            long arraySize = 1;
+            long elementSize = MAX([TCValue sizeOf:decl.action], 1);
+            do {
+                
+                // We need an initializer here, which can be parsed
+                // as a constant literal.
+                
+                TCExpressionParser * initExpression = [[TCExpressionParser alloc]init];
+                TCSyntaxNode * expression = [initExpression parse:scanner];
+                if( expression == nil)
+                    return nil;
+                TCExpressionInterpreter * initInterp = [[TCExpressionInterpreter alloc]init];
+                TCValue * initValue = [initInterp evaluate:expression withSymbols:nil];
+                if( initValue == nil)
+                    return nil;
+                
+                // The size in bytes of the whole array must fit in a long,
+                // or the allocation and the strides would wrap.
+                
+                long extent = initValue.getLong;
+                if( extent <= 0 || extent > LONG_MAX / elementSize / arraySize ) {
+                    scanner.error = [[TCError alloc]initWithCode:TCERROR_ARRAY_BOUNDS
+                                                    usingScanner:scanner
+                                                   withArgument:[NSNumber numberWithLong:extent]];
+                    return nil;
+                }
+                if( dimensions.count == TCSYMBOL_MAX_DIMENSIONS ) {
+                    scanner.error = [[TCError alloc]initWithCode:TCERROR_ARRAY_RANK
+                                                    usingScanner:scanner
+                                                   withArgument:varData.spelling];
+                    return nil;
+                }
+                [dimensions addObject:[NSNumber numberWithLong:extent]];
+                arraySize *= extent;
+                
+                if(![scanner isNextToken:TOKEN_BRACKET_RIGHT]) {
+                    scanner.error = [[TCError alloc]initWithCode:TCERROR_BRACKETMISMATCH
+                                                    usingScanner:scanner
+                                                   withArgument:nil];
+                    return nil;
+                }
+            } while([scanner isNextToken:TOKEN_BRACKET_LEFT]);
             
-            long arraySize = initValue.getLong;
             // Generate a tree containing a call to _array with the right size.
             // Create two arguments, the size and the type code to pass as
             // parameters.
@@ -153,13 +187,7 @@ TCValueType tokenToType( TokenType tok )
             allocator.subNodes = [NSMutableArray arrayWithArray:@[arg1, arg2]];
             varData.action = decl.action + TCVALUE_POINTER;
             varData.subNodes = [NSMutableArray arrayWithArray: @[allocator]];
-            
-            if(![scanner isNextToken:TOKEN_BRACKET_RIGHT]) {
-                scanner.error = [[TCError alloc]initWithCode:TCERROR_BRACKETMISMATCH
-                                                usingScanner:scanner
-                                               withArgument:nil];
-                return nil;
-            }
+            varData.dimensions = dimensions;
             
         }
         else if([scanner isNextToken:TOKEN_ASSIGNMENT]) {
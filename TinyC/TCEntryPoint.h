@@ -0,0 +1,103 @@
+//
+//  TCEntryPoint.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  A resolved handle to a single function in a compiled TinyC program.  The
+//  entry point is located once, the argument values are created once with
+//  the parameter types, and each call just stores new scalars into them
+//  and runs the function body.  The program's global initialization is not
+//  re-run, and no strings are allocated in runtime storage.
+
+#import <Foundation/Foundation.h>
+#import "TCValue.h"
+#import "TCError.h"
+
+@class TCSyntaxNode;
+@class TCRuntimeSymbolTable;
+@class TCStorageManager;
+@class TCRandom;
+
+/**
+ A single scalar argument or result.  Which member is used depends on the
+ declared type of the parameter or function: doubleValue for float and
+ double, and longValue for every other type, including pointers.
+ */
+typedef union {
+    long longValue;
+    double doubleValue;
+} TCScalar;
+
+@interface TCEntryPoint : NSObject
+
+{
+    /** The ENTRYPOINT node of the function */
+    TCSyntaxNode * _entry;
+    
+    /** The module the function belongs to */
+    TCSyntaxNode * _module;
+    
+    /** The global symbols created by the runtime initialization */
+    TCRuntimeSymbolTable * _globals;
+    
+    /** The runtime storage of the program */
+    TCStorageManager * _storage;
+    
+    /** One argument value per parameter, reused on every call */
+    NSMutableArray * _arguments;
+}
+
+/** The name of the function */
+@property (readonly) NSString * name;
+
+/** The number of parameters the function declares */
+@property (readonly) int parameterCount;
+
+/** The declared return type of the function */
+@property (readonly) TCValueType returnType;
+
+/** Produce trace records when the function runs */
+@property BOOL debug;
+
+/** Are calls to _assert that fail considered fatal? */
+@property BOOL assertAbort;
+
+/** The random number generator the function draws from while it runs;
+    the TinyC object gives each entry point its own stream */
+@property TCRandom * random;
+
+/**
+ Create a handle for a function.  This is normally done by the TinyC
+ object's entryPoint: method rather than directly.
+ @param entry the ENTRYPOINT node of the function
+ @param module the module containing the function
+ @param globals the global symbol table, or nil if there are no globals
+ @param storage the runtime storage of the program
+ @return a new handle
+ */
+-(instancetype) initWithEntry:(TCSyntaxNode*) entry
+                       module:(TCSyntaxNode*) module
+                      globals:(TCRuntimeSymbolTable*) globals
+                      storage:(TCStorageManager*) storage;
+
+/**
+ Get the declared type of a parameter.
+ @param index the zero-based parameter number
+ @return the type, or TCVALUE_UNDEFINED if there is no such parameter
+ */
+-(TCValueType) typeOfParameter:(int) index;
+
+/**
+ Call the function.
+ @param arguments one scalar for each parameter
+ @param count the number of scalars in the arguments array, which must
+ match the number of parameters
+ @param result where to store the function result, or NULL if it is not
+ wanted.  It is not changed for a void function.
+ @return nil if the call succeeded, else a description of the error
+ */
+-(TCError*) call:(const TCScalar*) arguments count:(int) count result:(TCScalar*) result;
+
+@end
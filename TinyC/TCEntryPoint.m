@@ -0,0 +1,132 @@
+//
+//  TCEntryPoint.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCEntryPoint.h"
+#import "TCSyntaxNode.h"
+#import "TCExecutionContext.h"
+#import "TCRuntimeSymbolTable.h"
+#import "TCStorageManager.h"
+#import "TCMetrics.h"
+#import "TCRandom.h"
+#import "TCThread.h"
+
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+@implementation TCEntryPoint
+
+#pragma mark - Initialization
+
+-(instancetype) initWithEntry:(TCSyntaxNode *)entry
+                       module:(TCSyntaxNode *)module
+                      globals:(TCRuntimeSymbolTable *)globals
+                      storage:(TCStorageManager *)storage
+{
+    if(( self = [super init])) {
+        _entry = entry;
+        _module = module;
+        _globals = globals;
+        _storage = storage;
+        _name = entry.spelling;
+        
+        // The first subnode is the return type and the last is the body;
+        // everything in between is a parameter declaration.
+        
+        TCSyntaxNode * returnInfo = entry.subNodes[0];
+        _returnType = (TCValueType) returnInfo.action;
+        _parameterCount = (int) entry.subNodes.count - 2;
+        
+        // Make an argument value of exactly the parameter type, so the
+        // entrypoint never has to cast it.
+        
+        _arguments = [NSMutableArray arrayWithCapacity:_parameterCount];
+        for( int ix = 0; ix < _parameterCount; ix++ ) {
+            TCValueType type = [self typeOfParameter:ix];
+            TCValue * value = nil;
+            
+            if( type > TCVALUE_POINTER )
+                value = [[[TCValue alloc]initWithLong:0L] makePointer:type - TCVALUE_POINTER];
+            else if( type == TCVALUE_DOUBLE )
+                value = [[TCValue alloc]initWithDouble:0.0];
+            else if( type == TCVALUE_FLOAT )
+                value = [[TCValue alloc]initWithFloat:0.0f];
+            else if( type == TCVALUE_LONG )
+                value = [[TCValue alloc]initWithLong:0L];
+            else if( type == TCVALUE_CHAR )
+                value = [[TCValue alloc]initWithChar:0];
+            else
+                value = [[TCValue alloc]initWithInt:0];
+            [_arguments addObject:value];
+        }
+    }
+    return self;
+}
+
+-(TCValueType) typeOfParameter:(int) index
+{
+    if( index < 0 || index >= _parameterCount )
+        return TCVALUE_UNDEFINED;
+    TCSyntaxNode * parameter = _entry.subNodes[index + 1];
+    return (TCValueType) parameter.action;
+}
+
+#pragma mark - Execution
+
+-(TCError*) call:(const TCScalar *)arguments count:(int)count result:(TCScalar *)result
+{
+    if( count != _parameterCount ) {
+        return [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH
+                                     atNode:_entry
+                               withArgument:nil];
+    }
+    
+    for( int ix = 0; ix < count; ix++ ) {
+        TCValue * value = _arguments[ix];
+        TCValueType type = value.getType;
+        if( type == TCVALUE_DOUBLE || type == TCVALUE_FLOAT )
+            [value assignDouble:arguments[ix].doubleValue];
+        else
+            [value assignLong:arguments[ix].longValue];
+    }
+    
+    // Run the function in a new context whose symbols are the globals, the
+    // same way a call from inside the program would.
+    
+    runtimeCounters.calls++;
+    TCExecutionContext * savedContext = activeContext;
+    TCExecutionContext * callContext = [[TCExecutionContext alloc]initWithStorage:_storage];
+    callContext.debug = _debug;
+    callContext.assertAbort = _assertAbort;
+    callContext.module = _module;
+    callContext.symbols = _globals;
+    activeContext = callContext;
+    TCRuntimeSymbolTable * savedGlobals = activeGlobals;
+    activeGlobals = _globals;
+    TCRandomState * savedRandom = activeRandom;
+    if( _random )
+        [_random start];
+    
+    TCValue * value = [callContext execute:_entry entryPoint:nil withArguments:_arguments];
+    TCError * error = callContext.error;
+    
+    activeContext = savedContext;
+    activeGlobals = savedGlobals;
+    activeRandom = savedRandom;
+    
+    if( error != nil )
+        return error;
+    
+    if( result != NULL && value != nil && _returnType != TCVALUE_VOID ) {
+        if( _returnType == TCVALUE_DOUBLE || _returnType == TCVALUE_FLOAT )
+            result->doubleValue = value.getDouble;
+        else
+            result->longValue = value.getLong;
+    }
+    return nil;
+}
+
+@end
@@ -43,6 +43,18 @@ typedef enum {
     TCERROR_INV_LVALUE,
     TCERROR_VOIDRETURN,
     TCERROR_RETURNVALUE,
+    TCERROR_FORMAT_SPEC,
+    TCERROR_FORMAT_ARGCOUNT,
+    TCERROR_FORMAT_ARGTYPE,
+    TCERROR_ADDRESS_FAULT,
+    TCERROR_HOST_BUFFER,
+    TCERROR_ARRAY_BOUNDS,
+    TCERROR_ARRAY_RANK,
+    TCERROR_ARG_TYPE,
+    TCERROR_EXTERN,
+    TCERROR_COROUTINE,
+    TCERROR_LIMIT,
+    TCERROR_THREAD,
     TCERROR__LASTERROR
 } TCErrorType;
 
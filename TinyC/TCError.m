@@ -82,6 +82,30 @@
             return @"Cannot return a value from a void function";
         case TCERROR_RETURNVALUE:
             return @"Non-void function requires return value";
+        case TCERROR_FORMAT_SPEC:
+            return @"Unsupported format specification \"%@\"";
+        case TCERROR_FORMAT_ARGCOUNT:
+            return @"Format requires %@ argument(s)";
+        case TCERROR_FORMAT_ARGTYPE:
+            return @"Format argument %@ has the wrong type";
+        case TCERROR_ADDRESS_FAULT:
+            return @"Address fault at %@";
+        case TCERROR_HOST_BUFFER:
+            return @"Unable to map host buffer \"%@\"";
+        case TCERROR_ARRAY_BOUNDS:
+            return @"Array index %@ out of bounds";
+        case TCERROR_ARRAY_RANK:
+            return @"Wrong number of array dimensions for %@";
+        case TCERROR_ARG_TYPE:
+            return @"Argument %@ has the wrong type";
+        case TCERROR_EXTERN:
+            return @"Unable to bind external function %@";
+        case TCERROR_COROUTINE:
+            return @"Coroutine error, %@";
+        case TCERROR_LIMIT:
+            return @"Execution limit exceeded, %@";
+        case TCERROR_THREAD:
+            return @"Thread error, %@";
         case TCERROR_BREAK:
             return @"!BREAK";
         case TCERROR_RETURN:
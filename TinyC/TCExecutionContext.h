@@ -14,6 +14,7 @@
 #import "TCStorageManager.h"
 
 @class TCFunction;
+@class TCTier;
 
 int typeSize(int t );
 
@@ -22,6 +23,16 @@ int typeSize(int t );
 {
     TCStorageManager* _storage;
     BOOL  _isCoRoutine;
+    
+    /** The argument values for the parameters in importedArguments */
+    NSMutableArray * _importedValues;
+    
+    /** The argument value for the parameter being declared, if any */
+    TCValue * _importedValue;
+    
+    /** The tier of the function this context is running, which counts
+        its loop trips */
+    TCTier * _tier;
 }
 
 @property TCSyntaxNode * module;
@@ -15,8 +15,15 @@
 #import "TCExpressionInterpreter.h"
 #import "TCFunction.h"
 #import "TinyC.h"
+#import "TCProfiler.h"
+#import "TCMetrics.h"
+#import "TCTraceBuffer.h"
+#import "TCHeapProfiler.h"
+#import "TCScheduler.h"
+#import "TCTier.h"
+#import "TCForeignFunction.h"
 
-TCExecutionContext* activeContext;
+__thread __unsafe_unretained TCExecutionContext* activeContext;
 
 #pragma mark - Utilities
 
@@ -187,6 +194,13 @@ TCValue* coerceType(TCValue* value, TokenType theType)
     
     int baseType = 0;
     int ix = 0;
+    
+    runtimeCounters.nodes++;
+    if( activeProfiler )
+        [activeProfiler node:tree];
+    if( activeTrace )
+        traceNode(tree.nodeType, tree.position);
+    
     // Execute a statement or a block.
     
     switch( tree.nodeType) {
@@ -219,7 +233,10 @@ TCValue* coerceType(TCValue* value, TokenType theType)
             expInt.debug = _debug;
             expInt.context = self;
             
-            return [expInt evaluate:tree withSymbols:_symbols];
+            result = [expInt evaluate:tree withSymbols:_symbols];
+            if( result == nil )
+                _error = expInt.error;
+            return result;
         }
 #pragma mark > dereference
 
@@ -238,8 +255,11 @@ TCValue* coerceType(TCValue* value, TokenType theType)
                 return nil;
             }
             
-            // @NODE need the base type of what we are dereferencing here!
+            // The pointer's type says what it points to.  An address that
+            // has lost its pointer type is assumed to point to an int.
             int baseType = TCVALUE_INT;
+            if( address.getType > TCVALUE_POINTER )
+                baseType = address.getType - TCVALUE_POINTER;
             
             return [_storage getValue:address.getLong ofType:baseType];
         }
@@ -313,8 +333,8 @@ TCValue* coerceType(TCValue* value, TokenType theType)
             self.returnInfo = tree.subNodes[0];
             
             // The next ones are the argument list; the count not be less
-            // than number of arguments provided. Assign the values to the
-            //local variable initializer field.
+            // than number of arguments provided. Collect the values to
+            // declare with each parameter when the body's block starts.
             
             if( arguments.count < (tree.subNodes.count - 2)) {
                 _error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:tree withArgument:nil];
@@ -323,6 +343,7 @@ TCValue* coerceType(TCValue* value, TokenType theType)
             
             if( tree.subNodes.count > 2 ) {
                 _importedArguments = [NSMutableArray array];
+                _importedValues = [NSMutableArray array];
                 for( int ix = 0; ix < arguments.count; ix++ ) {
                     TCValue* argValue = (TCValue*) arguments[ix];
                     if((ix+1) >= tree.subNodes.count-1 ) {
@@ -335,23 +356,80 @@ TCValue* coerceType(TCValue* value, TokenType theType)
                     
                     // See if we need to cast each argument to the type
                     // of the caller so we don't read storage values incorrectly!!
+                    // The declared type is on the name, as the DECLARE
+                    // only has the base type and would lose a pointer.
+                    // A pointer or integer passed for a pointer is taken
+                    // as an address, in a new value so the caller's is
+                    // not retyped.
                     
-                    if( argValue.getType != localArg.action) {
+                    TCValueType declaredType = localArgName.action;
+                    if( argValue.getType != declaredType) {
                         if( _debug)
-                            NSLog(@"TRACE:   Casting function parm #%d to %s", ix+1, typeMap(localArg.action));
-                        argValue = [argValue castTo:localArg.action];
+                            NSLog(@"TRACE:   Casting function parm #%d to %s", ix+1, typeMap(declaredType));
+                        TCValueType argType = argValue.getType;
+                        if( declaredType > TCVALUE_POINTER &&
+                            (argType > TCVALUE_POINTER || argType == TCVALUE_CHAR ||
+                             argType == TCVALUE_INT || argType == TCVALUE_LONG))
+                            argValue = [[[TCValue alloc]initWithLong:argValue.getLong] makePointer:declaredType - TCVALUE_POINTER];
+                        else
+                            argValue = [argValue castTo:declaredType];
                     }
-                    localArgName.argument = argValue;
+                    if( argValue == nil ) {
+                        _error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                                       atNode:tree
+                                                 withArgument:[NSNumber numberWithInt:ix+1]];
+                        _importedArguments = nil;
+                        _importedValues = nil;
+                        return nil;
+                    }
+                    
+                    // The value goes with the declaration rather than onto
+                    // the tree, which other threads may be running too.
+                    
                     [_importedArguments addObject:localArg ];
+                    [_importedValues addObject:argValue];
                     
                     if(_debug)
-                        NSLog(@"TRACE:   Add arg #%d %@ of type %s to arglist",ix, localArgName.spelling, typeMap(localArg.action));
+                        NSLog(@"TRACE:   Add arg #%d %@ of type %s to arglist",ix, localArgName.spelling, typeMap(declaredType));
                 }
             }
+            // Calls and loop trips are counted toward making a hot
+            // function's optimized copy.  A copy has no tier of its own.
+            
+            _tier = tree.tier;
+            [_tier called];
+            
+            // A call, like a loop back-edge, is where the execution budget
+            // is checked.
+            
+            if( limitExceeded()) {
+                _error = [[TCError alloc]initWithCode:TCERROR_LIMIT atNode:tree withArgument:limitDescription()];
+                return nil;
+            }
+            
             // The final subnode is the code block to execute. Fetch that out and let's run it.
             
+            if( activeProfiler )
+                [activeProfiler enter:tree.spelling];
+            if( activeTrace )
+                traceEvent(TCTRACE_CALL, 0, (long) arguments.count, 0L);
+            if( activeHeapProfiler )
+                [activeHeapProfiler enter:tree.spelling];
+            
+            // A call is a point where a scheduled task can be preempted.
+            
+            sliceCheck();
+            
             tree = tree.subNodes[tree.subNodes.count-1];
-            return [self execute:tree];
+            result = [self execute:tree];
+            
+            if( activeProfiler )
+                [activeProfiler exit];
+            if( activeTrace )
+                traceEvent(TCTRACE_RETURN, 0, result.getLong, 0L);
+            if( activeHeapProfiler )
+                [activeHeapProfiler exit];
+            return result;
             
         }
 #pragma mark > block
@@ -370,14 +448,18 @@ TCValue* coerceType(TCValue* value, TokenType theType)
             
             if( _importedArguments ) {
                 NSArray * tempArglist = [_importedArguments copy];
+                NSArray * tempValues = _importedValues;
                 _importedArguments = nil;
+                _importedValues = nil;
                 if( _debug)
                     NSLog(@"TRACE:   Importing %d arguments to local symbol table",
                           (int)tempArglist.count);
                 
                 for( int ix = 0; ix < tempArglist.count; ix ++ ) {
                     TCSyntaxNode * argDecl = (TCSyntaxNode*) tempArglist[ix];
+                    _importedValue = tempValues[ix];
                     [self execute:argDecl];
+                    _importedValue = nil;
                 }
                 tempArglist = nil;
             }
@@ -450,7 +532,11 @@ TCValue* coerceType(TCValue* value, TokenType theType)
                 // Special case; if this is a string constant then allocate storage for
                 // it and then return value.
                 if( value.getType == TCVALUE_STRING && actualType >= TCVALUE_POINTER) {
+                    if( activeHeapProfiler )
+                        activeHeapProfiler.site = tree;
                     value = [_storage allocateString:value.getString];
+                    if( activeHeapProfiler )
+                        activeHeapProfiler.site = nil;
                 }
                 else
                     value = [value castTo:actualType];
@@ -548,10 +634,12 @@ TCValue* coerceType(TCValue* value, TokenType theType)
                 else
                     NSLog(@"FATAL ERROR - NO STORAGE AVAILABLE");
                 
-                // Is there a static initial value?
+                // Is there a static initial value?  A parameter's is the
+                // argument passed to it.
                 
-                if( declaration.argument && _storage)
-                    [_lastSymbol setValue: (TCValue*)declaration.argument storage:_storage];
+                TCValue * initial = _importedValue ? _importedValue : (TCValue*)declaration.argument;
+                if( initial && _storage)
+                    [_lastSymbol setValue:initial storage:_storage];
                 else if( !_storage)
                     NSLog(@"C_ERROR: declaration initializer with no storage allocation");
                 
@@ -575,6 +663,15 @@ TCValue* coerceType(TCValue* value, TokenType theType)
                     [_lastSymbol setValue:initValue storage:_storage];
                     _lastSymbol.size = typeSize(baseType);
                     
+                    // A declared array keeps its shape and base address, so
+                    // element addresses need no storage reads to work out.
+                    
+                    if( declaration.dimensions ) {
+                        [_lastSymbol setDimensions:declaration.dimensions
+                                       elementSize:[TCValue sizeOf:declaration.action]];
+                        _lastSymbol.arrayBase = initValue.getLong;
+                    }
+                    
                 }
                 
                 if( _debug) {
@@ -604,6 +701,16 @@ TCValue* coerceType(TCValue* value, TokenType theType)
             TCValue * condition = nil;
             while(1) {
                 
+                // Each trip around the loop is counted and can be
+                // preempted or stopped by the execution budget.
+                runtimeCounters.iterations++;
+                [_tier looped];
+                sliceCheck();
+                if( limitExceeded()) {
+                    _error = [[TCError alloc]initWithCode:TCERROR_LIMIT atNode:tree withArgument:limitDescription()];
+                    return nil;
+                }
+                
                 condition = [self execute:termClause withSymbols:_symbols];
                 if( self.error)
                     return nil;
@@ -644,6 +751,14 @@ TCValue* coerceType(TCValue* value, TokenType theType)
             TCValue * condition = nil;
             while(1) {
                 
+                runtimeCounters.iterations++;
+                [_tier looped];
+                sliceCheck();
+                if( limitExceeded()) {
+                    _error = [[TCError alloc]initWithCode:TCERROR_LIMIT atNode:tree withArgument:limitDescription()];
+                    return nil;
+                }
+                
                 condition = [self execute:termClause withSymbols:_symbols];
                 if( self.error)
                     return nil;
@@ -697,7 +812,12 @@ TCValue* coerceType(TCValue* value, TokenType theType)
             if( entry.nodeType != LANGUAGE_ENTRYPOINT)
                 continue;
             if( [entry.spelling isEqualToString:entryName]) {
-                return entry;
+                
+                // A hot function is called in its optimized form once
+                // that is ready.
+                
+                TCSyntaxNode * promoted = entry.tier.promoted;
+                return promoted ? promoted : entry;
             }
         }
     }
@@ -708,6 +828,19 @@ TCValue* coerceType(TCValue* value, TokenType theType)
 
 -(TCFunction*) findBuiltin:(NSString*) name
 {
+    // A function declared extern is bound when the module is compiled,
+    // and the bound function is kept on its EXTERN node.  Like a builtin,
+    // each call gets an instance of its own to hold its error.
+    
+    TCSyntaxNode * tree = activeContext.module;
+    if( tree.nodeType == LANGUAGE_MODULE ) {
+        for( TCSyntaxNode * entry in tree.subNodes ) {
+            if( entry.nodeType == LANGUAGE_EXTERN && [entry.spelling isEqualToString:name]
+               && [entry.argument isKindOfClass:[TCForeignFunction class]])
+                return [[TCForeignFunction alloc]initWithBinding:(TCForeignFunction*) entry.argument];
+        }
+    }
+    
     NSString * functionClassName = [NSString stringWithFormat:@"TC%@Function", name];
     
     TCFunction * f = [[NSClassFromString(functionClassName) alloc] init];
@@ -14,11 +14,15 @@
 #import "TCExecutionContext.h"
 #import "NSString+NSStringFormatting.h"
 #import "TCFunction.h"
+#import "TCProfiler.h"
+#import "TCMetrics.h"
+#import "TCTraceBuffer.h"
+#import "TCHeapProfiler.h"
 
 
 char* typeMap(TCValueType);
 
-extern TCExecutionContext* activeContext;
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
 
 @implementation TCExpressionInterpreter
 
@@ -40,6 +44,12 @@ extern TCExecutionContext* activeContext;
 -(TCValue*) evaluate:(TCSyntaxNode *)node withSymbols:(TCRuntimeSymbolTable*) symbols
 {
     
+    runtimeCounters.nodes++;
+    if( activeProfiler )
+        [activeProfiler node:node];
+    if( activeTrace )
+        traceNode(node.nodeType, node.position);
+    
     switch( node.nodeType) {
             
             // A pointer
@@ -103,8 +113,11 @@ extern TCExecutionContext* activeContext;
                 return nil;
             }
             
-            // @NODE need the base type of what we are dereferencing here!
+            // The pointer's type says what it points to.  An address that
+            // has lost its pointer type is assumed to point to an int.
             int baseType = TCVALUE_INT;
+            if( address.getType > TCVALUE_POINTER )
+                baseType = address.getType - TCVALUE_POINTER;
             
             return [_storage getValue:address.getLong ofType:baseType];
         }
@@ -168,6 +181,53 @@ extern TCExecutionContext* activeContext;
                 return nil;
             }
             
+            // A declared array has a fixed base address and its strides were
+            // worked out when it was created, so the address is the base plus
+            // the sum of each index times the stride of its dimension.  Each
+            // index is checked against its extent unless the bounds analysis
+            // has already proven it is in range.
+            
+            long count = node.subNodes.count;
+            int rank = targetSymbol.rank;
+            if( rank > 0 ) {
+                if( count != rank ) {
+                    _error = [[TCError alloc]initWithCode:TCERROR_ARRAY_RANK
+                                                   atNode:node
+                                             withArgument:node.spelling];
+                    return nil;
+                }
+                const long * extents = targetSymbol.extents;
+                const long * strides = targetSymbol.strides;
+                unsigned int proven = node.provenIndexes;
+                long address = targetSymbol.arrayBase;
+                
+                for( int ix = 0; ix < rank; ix++ ) {
+                    TCValue * indexValue = [self evaluate:node.subNodes[ix] withSymbols:symbols];
+                    if( indexValue == nil )
+                        return nil;
+                    long index = indexValue.getLong;
+                    if( !(proven & (1U << ix)) && (index < 0 || index >= extents[ix])) {
+                        _error = [[TCError alloc]initWithCode:TCERROR_ARRAY_BOUNDS
+                                                       atNode:node
+                                                 withArgument:[NSNumber numberWithLong:index]];
+                        return nil;
+                    }
+                    address += index * strides[ix];
+                }
+                TCValue * reference = [[TCValue alloc]initWithLong:address];
+                return [reference makePointer:(targetSymbol.type - TCVALUE_POINTER)];
+            }
+            
+            // Otherwise this is a pointer being indexed, which has only one
+            // dimension and no known extent.
+            
+            if( count != 1 ) {
+                _error = [[TCError alloc]initWithCode:TCERROR_ARRAY_RANK
+                                               atNode:node
+                                         withArgument:node.spelling];
+                return nil;
+            }
+            
             // The offset is the stride (size of base type) times the index.  Get the
             // stride from the symbol table's declaration
             
@@ -179,6 +239,8 @@ extern TCExecutionContext* activeContext;
             // Calculate the index by executing the index expression
             
             TCValue * indexValue = [self evaluate:node.subNodes[0] withSymbols:symbols];
+            if( indexValue == nil )
+                return nil;
             
             // Calculate the resulting address, and make it into a pointer to the base type
             // of the appropriate address.
@@ -236,6 +298,11 @@ extern TCExecutionContext* activeContext;
                         NSLog(@"TRACE:   Load double %@", node.spelling);
                     return [[TCValue alloc]initWithDouble:[node.spelling doubleValue]];
                     
+                case TOKEN_FLOAT:
+                    if(_debug)
+                        NSLog(@"TRACE:   Load float %@", node.spelling);
+                    return [[TCValue alloc]initWithFloat:[node.spelling floatValue]];
+                    
                 case TOKEN_STRING: {
                     // Do a little extra work here to handle escapes.
                     
@@ -439,6 +506,7 @@ extern TCExecutionContext* activeContext;
             NSLog(@"TRACE:   Found entry point at %@, creating new frame", entry);
         
         
+        runtimeCounters.calls++;
         TCExecutionContext * savedContext = activeContext;
         TCExecutionContext * newContext = [[TCExecutionContext alloc]initWithStorage:self.storage];
         newContext.debug = activeContext.debug;
@@ -480,11 +548,27 @@ extern TCExecutionContext* activeContext;
     TCFunction * f = [activeContext findBuiltin:name];
     
     if( f != nil ) {
+        runtimeCounters.builtinCalls++;
+        if( activeTrace )
+            traceEvent(TCTRACE_BUILTIN, 0, (long) arguments.count, 0L);
         if(_debug)
             NSLog(@"TRACE:   dynamic execution of \"%@\" function", name);
         f.storage = _storage;
+        f.node = node;
+        if( activeHeapProfiler )
+            activeHeapProfiler.site = node;
         TCValue * result = [f execute:arguments inContext:_context];
+        if( activeHeapProfiler )
+            activeHeapProfiler.site = nil;
         _error = f.error;
+        
+        // A builtin that allocated past the memory budget stops the
+        // program here, rather than handing back a NULL pointer.
+        
+        if( _error == nil && runtimeLimits.exceeded != TCLIMIT_NONE ) {
+            _error = [[TCError alloc]initWithCode:TCERROR_LIMIT atNode:node withArgument:limitDescription()];
+            return nil;
+        }
         return result;
     }
     
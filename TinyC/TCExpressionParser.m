@@ -117,22 +117,28 @@
     }
     
     
-    // Is it an array reference?
+    // Is it an array reference?  There is an index expression for
+    // each dimension, as in m[i][j].
     
     if([parser isNextToken:TOKEN_BRACKET_LEFT]) {
-        TCSyntaxNode * arrayExpression = [self parseRelations:parser];
-        if( arrayExpression == nil)
-            return nil;
-        if(![parser isNextToken:TOKEN_BRACKET_RIGHT]) {
-            parser.error = [[TCError alloc]initWithCode:TCERROR_BRACEMISMATCH usingScanner:parser];
-            return nil;
-        }
+        NSMutableArray * indexes = [NSMutableArray array];
+        do {
+            TCSyntaxNode * arrayExpression = [self parseRelations:parser];
+            if( arrayExpression == nil)
+                return nil;
+            if(![parser isNextToken:TOKEN_BRACKET_RIGHT]) {
+                parser.error = [[TCError alloc]initWithCode:TCERROR_BRACEMISMATCH usingScanner:parser];
+                return nil;
+            }
+            [indexes addObject:arrayExpression];
+        } while([parser isNextToken:TOKEN_BRACKET_LEFT]);
+        
         TCSyntaxNode * deref = [TCSyntaxNode node:LANGUAGE_DEREFERENCE usingScanner:parser];
         deref.position = parser.tokenPosition;
         deref.spelling = atom.spelling;
         deref.subNodes = [NSMutableArray arrayWithArray:@[atom]];
         atom.nodeType = LANGUAGE_ARRAY;
-        atom.subNodes = [NSMutableArray arrayWithArray:@[arrayExpression]];
+        atom.subNodes = indexes;
         
         return deref;
     }
@@ -355,6 +361,13 @@
         atom.spelling = [parser lastSpelling];
         return atom;
     }
+    else if([parser isNextToken:TOKEN_FLOAT]) {
+        TCSyntaxNode *atom = [TCSyntaxNode node:LANGUAGE_SCALAR usingScanner:parser];
+        atom.position = parser.tokenPosition;
+        atom.action = TOKEN_FLOAT;
+        atom.spelling = [parser lastSpelling];
+        return atom;
+    }
     else if([parser isNextToken:TOKEN_STRING]) {
         TCSyntaxNode * atom = [TCSyntaxNode node:LANGUAGE_SCALAR usingScanner:parser];
         atom.position = parser.tokenPosition;
@@ -0,0 +1,80 @@
+//
+//  TCForeignFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  A function in a shared library, declared in a TinyC module with
+//
+//      extern "libfast.so" double dot(double * x, double * y, long n);
+//
+//  The library is opened with dlopen when the module is compiled and the
+//  symbol bound once.  Each call converts the arguments to the declared
+//  parameter types, translates pointers from runtime addresses into real
+//  addresses in the storage buffer, and converts the result back.
+//
+//  No libffi is needed: the call is made through a prototype with six
+//  integer and eight floating point parameters, which the x86-64 and arm64
+//  calling conventions both pass in registers, each class numbered on its
+//  own.  A function can have at most that many parameters of each class,
+//  and cannot be variadic.
+//
+//  A pointer argument is checked to address one element of its type in
+//  the storage buffer, and no more: the foreign code is trusted to stay
+//  within the object, so a function that works on an array should take
+//  its length as a parameter, as dot does above.
+
+#import "TCFunction.h"
+
+/** The most integer and pointer parameters a foreign function can take */
+#define TCFOREIGN_MAX_INTEGERS 6
+
+/** The most float and double parameters a foreign function can take */
+#define TCFOREIGN_MAX_REALS 8
+
+@interface TCForeignFunction : TCFunction
+
+{
+    /** The handle from dlopen, or NULL when searching loaded libraries */
+    void * _library;
+
+    /** The address of the function */
+    void * _symbol;
+
+    /** The declared type of each parameter */
+    TCValueType * _parameters;
+
+    /** The number of parameters */
+    int _count;
+
+    /** The bound function a per-call instance was made from, which owns
+        the library handle and the parameter types */
+    TCForeignFunction * _binding;
+}
+
+/** The name of the function */
+@property (readonly) NSString * name;
+
+/** The declared return type */
+@property (readonly) TCValueType returnType;
+
+/**
+ Load the library named by an EXTERN node and bind its function.
+ @param node the EXTERN node
+ @param error set to a description of the problem if the function cannot
+ be bound
+ @return the bound function, or nil if there was an error
+ */
+-(instancetype) initWithPrototype:(TCSyntaxNode*) node error:(TCError**) error;
+
+/**
+ Make an instance for one call of a bound function.  A call sets the
+ storage, node and error of the function object, and calls can be made
+ from several threads at once, so each gets its own.
+ @param binding the function bound from the EXTERN node
+ @return the instance to call
+ */
+-(instancetype) initWithBinding:(TCForeignFunction*) binding;
+
+@end
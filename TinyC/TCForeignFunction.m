@@ -0,0 +1,189 @@
+//
+//  TCForeignFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCForeignFunction.h"
+#import "TCSyntaxNode.h"
+#include <dlfcn.h>
+
+/**
+ The prototypes a foreign function is called through, one for each class
+ of return value.
+ */
+typedef long (*TCForeignLong)(long, long, long, long, long, long,
+                              double, double, double, double, double, double, double, double);
+typedef double (*TCForeignDouble)(long, long, long, long, long, long,
+                                  double, double, double, double, double, double, double, double);
+typedef float (*TCForeignFloat)(long, long, long, long, long, long,
+                                double, double, double, double, double, double, double, double);
+
+/**
+ A float is passed in the low half of a floating point register, so it is
+ stored into the low half of a double that fills the register.
+ */
+typedef union {
+    double d;
+    float f;
+} TCForeignReal;
+
+@implementation TCForeignFunction
+
+-(instancetype) initWithPrototype:(TCSyntaxNode *)node error:(TCError *__autoreleasing *)error
+{
+    if(( self = [super init])) {
+        _name = node.spelling;
+        _returnType = (TCValueType)[node.subNodes[0] action];
+        _count = (int) node.subNodes.count - 1;
+        _parameters = calloc(MAX(_count, 1), sizeof(TCValueType));
+
+        int integers = 0;
+        int reals = 0;
+        for( int ix = 0; ix < _count; ix++ ) {
+            // The DECLARE only has the base type; the pointer flag is on
+            // the parameter's name.
+
+            TCValueType type = (TCValueType)[[node.subNodes[ix + 1] subNodes][0] action];
+            _parameters[ix] = type;
+            if( type == TCVALUE_FLOAT || type == TCVALUE_DOUBLE )
+                reals++;
+            else if( type > TCVALUE_POINTER || (type >= TCVALUE_CHAR && type <= TCVALUE_LONG))
+                integers++;
+            else {
+                *error = [[TCError alloc]initWithCode:TCERROR_EXTERN
+                                               atNode:node
+                                         withArgument:[NSString stringWithFormat:@"%@, parameter %d has an unsupported type",
+                                                       _name, ix + 1]];
+                return nil;
+            }
+        }
+        if( integers > TCFOREIGN_MAX_INTEGERS || reals > TCFOREIGN_MAX_REALS ) {
+            *error = [[TCError alloc]initWithCode:TCERROR_EXTERN
+                                           atNode:node
+                                     withArgument:[NSString stringWithFormat:@"%@, too many parameters", _name]];
+            return nil;
+        }
+
+        NSString * path = (NSString*) node.argument;
+        if( path != nil ) {
+            _library = dlopen([path UTF8String], RTLD_NOW | RTLD_LOCAL);
+            if( _library == NULL ) {
+                *error = [[TCError alloc]initWithCode:TCERROR_EXTERN
+                                               atNode:node
+                                         withArgument:[NSString stringWithFormat:@"%@, %s", _name, dlerror()]];
+                return nil;
+            }
+        }
+        _symbol = dlsym(_library ? _library : RTLD_DEFAULT, [_name UTF8String]);
+        if( _symbol == NULL ) {
+            *error = [[TCError alloc]initWithCode:TCERROR_EXTERN
+                                           atNode:node
+                                     withArgument:[NSString stringWithFormat:@"%@, symbol not found", _name]];
+            return nil;
+        }
+    }
+    return self;
+}
+
+-(instancetype) initWithBinding:(TCForeignFunction *)binding
+{
+    if(( self = [super init])) {
+        _binding = binding;
+        _name = binding.name;
+        _returnType = binding.returnType;
+        _count = binding->_count;
+        _parameters = binding->_parameters;
+        _symbol = binding->_symbol;
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    if( _binding )
+        return;
+    free(_parameters);
+    if( _library )
+        dlclose(_library);
+}
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext *)context
+{
+    self.error = nil;
+    if( arguments.count != _count ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    // Sort the arguments into the integer and floating point registers,
+    // in order within each class.
+
+    long integers[TCFOREIGN_MAX_INTEGERS] = { 0 };
+    TCForeignReal reals[TCFOREIGN_MAX_REALS];
+    memset(reals, 0, sizeof(reals));
+    int ni = 0;
+    int nr = 0;
+
+    for( int ix = 0; ix < _count; ix++ ) {
+        TCValue * value = arguments[ix];
+        TCValueType type = _parameters[ix];
+
+        // Only the first element a pointer addresses can be checked, as
+        // the extent the foreign code touches is not known here.
+
+        if( type > TCVALUE_POINTER ) {
+            long address = value.getLong;
+            char * pointer = NULL;
+            if( address != 0L ) {
+                pointer = [self pointerTo:address length:[TCValue sizeOf:type - TCVALUE_POINTER] forWrite:NO];
+                if( pointer == NULL )
+                    return nil;
+            }
+            integers[ni++] = (long) pointer;
+        }
+        else if( type == TCVALUE_DOUBLE )
+            reals[nr++].d = value.getDouble;
+        else if( type == TCVALUE_FLOAT )
+            reals[nr++].f = value.getFloat;
+        else if( type == TCVALUE_CHAR )
+            integers[ni++] = (char) value.getLong;
+        else if( type == TCVALUE_LONG )
+            integers[ni++] = value.getLong;
+        else
+            integers[ni++] = (int) value.getLong;
+    }
+
+#define TCFOREIGN_ARGUMENTS \
+    integers[0], integers[1], integers[2], integers[3], integers[4], integers[5], \
+    reals[0].d, reals[1].d, reals[2].d, reals[3].d, reals[4].d, reals[5].d, reals[6].d, reals[7].d
+
+    if( _returnType == TCVALUE_DOUBLE )
+        return [[TCValue alloc]initWithDouble:((TCForeignDouble)_symbol)(TCFOREIGN_ARGUMENTS)];
+    if( _returnType == TCVALUE_FLOAT )
+        return [[TCValue alloc]initWithFloat:((TCForeignFloat)_symbol)(TCFOREIGN_ARGUMENTS)];
+
+    long result = ((TCForeignLong)_symbol)(TCFOREIGN_ARGUMENTS);
+
+    // Only the low bits of a narrower result are defined.  A pointer is
+    // mapped back to a runtime address, and is 0 if it points outside the
+    // program's storage.
+
+    if( _returnType > TCVALUE_POINTER )
+        return [[[TCValue alloc]initWithLong:[self.storage addressOf:(const char*) result]]
+                makePointer:_returnType - TCVALUE_POINTER];
+    switch( _returnType ) {
+        case TCVALUE_VOID:
+            return [[TCValue alloc]initWithInt:0];
+        case TCVALUE_CHAR:
+            return [[TCValue alloc]initWithChar:(char) result];
+        case TCVALUE_LONG:
+            return [[TCValue alloc]initWithLong:result];
+        default:
+            return [[TCValue alloc]initWithInt:(int) result];
+    }
+}
+
+@end
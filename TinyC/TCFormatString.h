@@ -0,0 +1,113 @@
+//
+//  TCFormatString.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  A pre-compiled printf() format string.  The format is parsed once into
+//  a list of directives, each of which is either a chunk of literal text
+//  (with C escapes already converted) or a single typed conversion.  At
+//  runtime the directives are walked in order and the output is appended
+//  directly to a byte buffer, so there is no re-parsing of the format or
+//  of the escape sequences on each call.
+
+#import <Foundation/Foundation.h>
+#import "TCValue.h"
+#import "TCError.h"
+#import "TCStorageManager.h"
+
+/**
+ The kind of each directive in a compiled format string.
+ */
+typedef enum {
+    /** Literal text copied to the output as-is */
+    TCFORMAT_LITERAL,
+
+    /** An integer conversion (%d, %i, %u, %x, %X, %o, %c) */
+    TCFORMAT_INTEGER,
+
+    /** A floating point conversion (%f, %e, %E, %g, %G) */
+    TCFORMAT_DOUBLE,
+
+    /** A string conversion (%s) */
+    TCFORMAT_STRING,
+
+    /** A pointer conversion (%p) */
+    TCFORMAT_POINTER
+} TCFormatDirectiveKind;
+
+@interface TCFormatString : NSObject
+
+{
+    /** Array of directive structures, in output order */
+    NSMutableData * _directives;
+
+    /** The literal text of the format, with escapes already converted */
+    NSMutableData * _literals;
+}
+
+/** The number of arguments consumed by the conversions in the format */
+@property (readonly) int argumentCount;
+
+/** The error found while compiling the format, if any.  The compiled
+    format is shared by every call, on any thread, so errors found while
+    formatting are returned to the caller rather than stored here. */
+@property TCError * error;
+
+/**
+ Compile a format string.  Any error in the format is reported in the
+ error property of the resulting object.
+
+ @param format the text of the format, with escapes not yet processed
+ @return a new instance of the compiled format
+ */
+-(instancetype) initWithString:(NSString*) format;
+
+/**
+ Compile a format string stored as a C string, such as a format that
+ was computed by the program and lives in runtime storage.
+
+ @param format the text of the format, with escapes not yet processed
+ @return a new instance of the compiled format
+ */
+-(instancetype) initWithUTF8String:(const char*) format;
+
+/**
+ Determine the kind of value the given conversion expects.
+
+ @param index the zero-based index of the conversion in the format
+ @return the directive kind for the argument at that position
+ */
+-(TCFormatDirectiveKind) kindOfArgument:(int) index;
+
+/**
+ Determine if a value of the given type can be used for a conversion.
+
+ @param index the zero-based index of the conversion in the format
+ @param type the type of the value that will be passed for the conversion
+ @return YES if the value type can be formatted by the conversion
+ */
+-(BOOL) acceptsArgument:(int) index ofType:(TCValueType) type;
+
+/**
+ Format a list of arguments and append the result to a byte buffer.  This
+ keeps no state in the format, so it can be called from several threads
+ at once.
+
+ @param arguments the TCValue arguments to the call
+ @param first the index in the arguments array of the first value to
+ be formatted (the format itself usually occupies index 0)
+ @param storage the runtime storage used to resolve char* arguments
+ @param buffer the buffer the formatted output is appended to
+ @param error set to describe why, if the arguments do not match the format
+ @return the number of bytes appended, or -1 if the arguments do not
+ match the format.
+ */
+-(long) appendArguments:(NSArray*) arguments
+                   from:(int) first
+                storage:(TCStorageManager*) storage
+                     to:(NSMutableData*) buffer
+                  error:(TCError**) error;
+
+@end
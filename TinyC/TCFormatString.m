@@ -0,0 +1,418 @@
+//
+//  TCFormatString.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCFormatString.h"
+
+/** Longest native format specification we will build for a conversion */
+#define TCFORMAT_SPEC_SIZE 24
+
+/**
+ A single compiled directive.  Literal directives refer to a range of the
+ literal text buffer; conversion directives carry a native printf() spec
+ that has already been rewritten to match the C type we pass at runtime.
+ */
+typedef struct {
+    TCFormatDirectiveKind kind;
+    char conversion;
+    BOOL plain;
+    long offset;
+    long length;
+    char spec[TCFORMAT_SPEC_SIZE];
+} TCFormatDirective;
+
+/**
+ Map the character following a backslash to the character it represents.
+ This is the same set of escapes handled by the escapeString method of
+ the NSString formatting category.
+ */
+static char escapedCharacter(char ch)
+{
+    switch(ch) {
+        case 'n':
+            return '\n';
+        case 't':
+            return '\t';
+        case '0':
+            return 0;
+        default:
+            return ch;
+    }
+}
+
+/**
+ Append text to a buffer, converting escapes as we go.  Runs of text that
+ have no escapes are appended as a single block.  An escaped null ends the
+ text, just as it would end the C string.
+ */
+static void appendEscaped(NSMutableData * buffer, const char * text, long length)
+{
+    const char * end = text + length;
+    while( text < end ) {
+        const char * slash = memchr(text, '\\', end - text);
+        if( slash == NULL ) {
+            [buffer appendBytes:text length:(end - text)];
+            return;
+        }
+        [buffer appendBytes:text length:(slash - text)];
+        if( slash + 1 >= end ) {
+            [buffer appendBytes:slash length:1];
+            return;
+        }
+        char ch = escapedCharacter(slash[1]);
+        if( ch == 0 )
+            return;
+        [buffer appendBytes:&ch length:1];
+        text = slash + 2;
+    }
+}
+
+/**
+ Format a single native value using a printf() spec and append the result
+ to a buffer.  Short results are formatted on the stack; longer ones are
+ formatted directly into the tail of the output buffer.
+ */
+static void appendFormatted(NSMutableData * buffer, const char * spec, ...)
+{
+    char local[64];
+    va_list args;
+
+    va_start(args, spec);
+    int length = vsnprintf(local, sizeof(local), spec, args);
+    va_end(args);
+
+    if( length < 0 )
+        return;
+    if( length < (int) sizeof(local)) {
+        [buffer appendBytes:local length:length];
+        return;
+    }
+
+    long base = buffer.length;
+    [buffer increaseLengthBy:length + 1];
+    va_start(args, spec);
+    vsnprintf((char*) buffer.mutableBytes + base, length + 1, spec, args);
+    va_end(args);
+    [buffer setLength:base + length];
+}
+
+@implementation TCFormatString
+
+#pragma mark - Initialization
+
+-(instancetype) initWithString:(NSString *)format
+{
+    return [self initWithUTF8String:format ? [format UTF8String] : ""];
+}
+
+-(instancetype) initWithUTF8String:(const char *)format
+{
+    if(( self = [super init])) {
+        _directives = [NSMutableData data];
+        _literals = [NSMutableData data];
+        _argumentCount = 0;
+        _error = nil;
+        [self compile:format];
+    }
+    return self;
+}
+
+#pragma mark - Compilation
+
+/**
+ Add a literal directive for any text accumulated since the last
+ conversion directive.
+ @param start the offset in the literal buffer where the text starts
+ */
+-(void) flushLiteralFrom:(long) start
+{
+    long length = _literals.length - start;
+    if( length <= 0 )
+        return;
+
+    TCFormatDirective d;
+    memset(&d, 0, sizeof(d));
+    d.kind = TCFORMAT_LITERAL;
+    d.offset = start;
+    d.length = length;
+    [_directives appendBytes:&d length:sizeof(d)];
+}
+
+/**
+ Parse the format text into the directive list.  Conversions are
+ rewritten so that integer values are always passed as long, and
+ anything we cannot format is reported as an error.
+ @param format the format text
+ */
+-(void) compile:(const char *) format
+{
+    long literalStart = 0;
+    const char * cp = format;
+
+    while( *cp ) {
+        char ch = *cp;
+
+        // Escapes are converted once, here, rather than on every call.
+        // An escaped null ends the format just as it would in C.
+
+        if( ch == '\\' ) {
+            if( cp[1] == 0 ) {
+                [_literals appendBytes:cp length:1];
+                cp++;
+                continue;
+            }
+            ch = escapedCharacter(cp[1]);
+            if( ch == 0 )
+                break;
+            [_literals appendBytes:&ch length:1];
+            cp += 2;
+            continue;
+        }
+
+        if( ch != '%' ) {
+            [_literals appendBytes:cp length:1];
+            cp++;
+            continue;
+        }
+
+        if( cp[1] == '%' ) {
+            [_literals appendBytes:cp length:1];
+            cp += 2;
+            continue;
+        }
+
+        // It's a conversion.  Capture the flags, width, and precision
+        // as-is, skip any length modifiers, and find the conversion.
+
+        const char * start = cp++;
+        while( *cp && strchr("-+ #0", *cp))
+            cp++;
+        while( isdigit(*cp))
+            cp++;
+        if( *cp == '.' ) {
+            cp++;
+            while( isdigit(*cp))
+                cp++;
+        }
+        const char * modifiers = cp;
+        while( *cp && strchr("hlLqjzt", *cp))
+            cp++;
+
+        TCFormatDirective d;
+        memset(&d, 0, sizeof(d));
+        d.conversion = *cp;
+        d.plain = (modifiers - start == 1);
+
+        const char * lengthModifier = "";
+        switch( d.conversion ) {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                d.kind = TCFORMAT_INTEGER;
+                lengthModifier = "l";
+                break;
+
+            case 'c':
+                d.kind = TCFORMAT_INTEGER;
+                break;
+
+            case 'f':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                d.kind = TCFORMAT_DOUBLE;
+                break;
+
+            case 's':
+                d.kind = TCFORMAT_STRING;
+                break;
+
+            case 'p':
+                d.kind = TCFORMAT_POINTER;
+                break;
+
+            default:
+                _error = [[TCError alloc]initWithCode:TCERROR_FORMAT_SPEC
+                                               atNode:nil
+                                         withArgument:[[NSString alloc]initWithBytes:start
+                                                                               length:(*cp ? cp - start + 1 : cp - start)
+                                                                             encoding:NSUTF8StringEncoding]];
+                return;
+        }
+
+        int specLength = snprintf(d.spec, TCFORMAT_SPEC_SIZE, "%.*s%s%c",
+                                  (int)(modifiers - start), start, lengthModifier, d.conversion);
+        if( specLength >= TCFORMAT_SPEC_SIZE ) {
+            _error = [[TCError alloc]initWithCode:TCERROR_FORMAT_SPEC
+                                           atNode:nil
+                                     withArgument:[[NSString alloc]initWithBytes:start
+                                                                           length:(cp - start + 1)
+                                                                         encoding:NSUTF8StringEncoding]];
+            return;
+        }
+
+        [self flushLiteralFrom:literalStart];
+        [_directives appendBytes:&d length:sizeof(d)];
+        literalStart = _literals.length;
+        _argumentCount++;
+        cp++;
+    }
+    [self flushLiteralFrom:literalStart];
+}
+
+#pragma mark - Validation
+
+-(TCFormatDirectiveKind) kindOfArgument:(int)index
+{
+    const TCFormatDirective * d = _directives.bytes;
+    long count = _directives.length / sizeof(TCFormatDirective);
+
+    for( long ix = 0; ix < count; ix++ ) {
+        if( d[ix].kind == TCFORMAT_LITERAL )
+            continue;
+        if( index-- == 0 )
+            return d[ix].kind;
+    }
+    return TCFORMAT_LITERAL;
+}
+
+-(BOOL) acceptsArgument:(int)index ofType:(TCValueType)type
+{
+    switch([self kindOfArgument:index]) {
+        case TCFORMAT_INTEGER:
+        case TCFORMAT_POINTER:
+            return type != TCVALUE_STRING && type != TCVALUE_UNDEFINED && type != TCVALUE_VOID;
+
+        case TCFORMAT_DOUBLE:
+            return type < TCVALUE_POINTER && type != TCVALUE_STRING &&
+                   type != TCVALUE_UNDEFINED && type != TCVALUE_VOID;
+
+        case TCFORMAT_STRING:
+            return type == TCVALUE_STRING || type == TCVALUE_POINTER_CHAR;
+
+        default:
+            return NO;
+    }
+}
+
+#pragma mark - Formatting
+
+/**
+ Locate the text for a %s argument.  This is either a compiler-generated
+ string value, or a char* into runtime storage, which must be a valid
+ address and is bounded by the end of the area that contains it.
+ */
+-(const char*) textOf:(TCValue*) value storage:(TCStorageManager*) storage length:(long*) length
+{
+    if( value.getType == TCVALUE_STRING ) {
+        const char * text = [value.getString UTF8String];
+        *length = text ? strlen(text) : 0;
+        return text;
+    }
+
+    long address = value.getLong;
+    *length = [storage stringLength:address limit:LONG_MAX];
+    if( *length < 0 )
+        return NULL;
+    return [storage pointerTo:address length:*length forWrite:NO];
+}
+
+-(long) appendArguments:(NSArray *)arguments
+                   from:(int)first
+                storage:(TCStorageManager *)storage
+                     to:(NSMutableData *)buffer
+                  error:(TCError **)error
+{
+    long startingLength = buffer.length;
+    NSMutableData * scratch = nil;
+
+    if( (long) arguments.count - first != _argumentCount ) {
+        *error = [[TCError alloc]initWithCode:TCERROR_FORMAT_ARGCOUNT
+                                       atNode:nil
+                                 withArgument:[NSNumber numberWithInt:_argumentCount]];
+        return -1;
+    }
+
+    const TCFormatDirective * d = _directives.bytes;
+    long count = _directives.length / sizeof(TCFormatDirective);
+    const char * literals = _literals.bytes;
+    int argp = first;
+
+    for( long ix = 0; ix < count; ix++, d++ ) {
+        if( d->kind == TCFORMAT_LITERAL ) {
+            [buffer appendBytes:literals + d->offset length:d->length];
+            continue;
+        }
+
+        TCValue * value = arguments[argp];
+        if(![self acceptsArgument:(argp - first) ofType:value.getType]) {
+            *error = [[TCError alloc]initWithCode:TCERROR_FORMAT_ARGTYPE
+                                           atNode:nil
+                                     withArgument:[NSNumber numberWithInt:(argp - first + 1)]];
+            return -1;
+        }
+        argp++;
+
+        switch( d->kind ) {
+            case TCFORMAT_INTEGER:
+                if( d->conversion == 'c' )
+                    appendFormatted(buffer, d->spec, (int) value.getLong);
+                else
+                    appendFormatted(buffer, d->spec, value.getLong);
+                break;
+
+            case TCFORMAT_DOUBLE:
+                appendFormatted(buffer, d->spec, value.getDouble);
+                break;
+
+            case TCFORMAT_POINTER:
+                appendFormatted(buffer, d->spec, (void*) value.getLong);
+                break;
+
+            case TCFORMAT_STRING:
+            {
+                long length = 0;
+                const char * text = [self textOf:value storage:storage length:&length];
+                if( text == NULL ) {
+                    *error = [[TCError alloc]initWithCode:TCERROR_FORMAT_ARGTYPE
+                                                   atNode:nil
+                                             withArgument:[NSNumber numberWithInt:(argp - first)]];
+                    return -1;
+                }
+
+                // Escapes in string arguments are converted on output, the
+                // same as the formatting category always did.
+
+                if( d->plain ) {
+                    appendEscaped(buffer, text, length);
+                } else {
+                    // The escaped text is formatted from a buffer of the
+                    // call's own.
+
+                    if( scratch == nil )
+                        scratch = [NSMutableData dataWithCapacity:length + 1];
+                    [scratch setLength:0];
+                    appendEscaped(scratch, text, length);
+                    [scratch appendBytes:"" length:1];
+                    appendFormatted(buffer, d->spec, scratch.bytes);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return buffer.length - startingLength;
+}
+
+@end
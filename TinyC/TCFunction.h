@@ -17,6 +17,50 @@
 @property TCStorageManager *storage;
 @property TCError *error;
 
+/** The CALL node that invoked this function, if any */
+@property TCSyntaxNode *node;
+
 -(TCValue*) execute:(NSArray*) arguments inContext:(TCExecutionContext*) context;
 
+/**
+ Get the length of a null-terminated string in runtime storage.  If the
+ string is not addressable, the error property is set to an address fault.
+ @param address the virtual address of the string
+ @param limit the maximum number of bytes to search for the terminator
+ @return the length of the string, or -1 if it is not addressable
+ */
+-(long) stringLength:(long) address limit:(long) limit;
+
+/**
+ Get a real pointer to a range of runtime storage, so the function can
+ work on all of it at once.  If the range cannot be accessed, the error
+ property is set to an address fault.
+ @param address the virtual address of the start of the range
+ @param length the number of bytes in the range
+ @param write YES if the function will store into the range
+ @return a pointer to the first byte, or NULL if it is not addressable
+ */
+-(char*) pointerTo:(long) address length:(long) length forWrite:(BOOL) write;
+
+/**
+ Get a real pointer to an array of elements in runtime storage.  A count
+ and size whose product does not fit in a length are an address fault,
+ the same as a range that cannot be accessed.
+ @param address the virtual address of the first element
+ @param count the number of elements
+ @param size the size of each element in bytes
+ @param write YES if the function will store into the array
+ @return a pointer to the first byte, or NULL if it is not addressable
+ */
+-(char*) pointerTo:(long) address count:(long) count size:(long) size forWrite:(BOOL) write;
+
+/**
+ Get the text of a string argument as a C string.  The argument can be a
+ char* into runtime storage or a string constant.  If the string is not
+ addressable, the error property is set to an address fault.
+ @param value the argument value
+ @return the null-terminated text, or NULL if it is not addressable
+ */
+-(const char*) cString:(TCValue*) value;
+
 @end
@@ -16,4 +16,49 @@
     return nil;
 }
 
+-(long) stringLength:(long) address limit:(long) limit
+{
+    long length = [self.storage stringLength:address limit:limit];
+    if( length < 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ADDRESS_FAULT
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithLong:address]];
+    }
+    return length;
+}
+
+-(char*) pointerTo:(long) address length:(long) length forWrite:(BOOL) write
+{
+    char * pointer = [self.storage pointerTo:address length:length forWrite:write];
+    if( pointer == NULL ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ADDRESS_FAULT
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithLong:address]];
+    }
+    return pointer;
+}
+
+-(char*) pointerTo:(long) address count:(long) count size:(long) size forWrite:(BOOL) write
+{
+    if( size <= 0L || count < 0L || count > LONG_MAX / size ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ADDRESS_FAULT
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithLong:address]];
+        return NULL;
+    }
+    return [self pointerTo:address length:count * size forWrite:write];
+}
+
+-(const char*) cString:(TCValue*) value
+{
+    if( value.getType == TCVALUE_STRING )
+        return [value.getString UTF8String];
+    
+    long address = value.getLong;
+    long length = [self stringLength:address limit:LONG_MAX];
+    if( length < 0 )
+        return NULL;
+    return [self pointerTo:address length:length + 1 forWrite:NO];
+}
+
 @end
@@ -0,0 +1,109 @@
+//
+//  TCHeapProfiler.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Heap profiler used by the -dh option.  Every dynamic allocation is
+//  charged to a call site: the call stack of TinyC functions plus the
+//  source line of the node that asked for the storage (usually a call to
+//  malloc(), or a string constant stored through a pointer).  At exit the
+//  profiler reports the bytes still allocated by each site, which sites
+//  made up the heap when it was at its largest, a histogram of allocation
+//  sizes, and how fragmented the storage manager's free list is.
+
+#import <Foundation/Foundation.h>
+
+@class TCSyntaxNode;
+@class TCLexicalScanner;
+@class TCStorageManager;
+@class TCHeapProfiler;
+
+/** The heap profiler for the execution running on this thread, or nil if not profiling */
+extern __thread __unsafe_unretained TCHeapProfiler * activeHeapProfiler;
+
+/** Number of power-of-two buckets in the allocation size histogram */
+#define TCHEAP_BUCKETS 32
+
+@interface TCHeapProfiler : NSObject
+
+{
+    /** The scanner used to map node positions to source lines */
+    TCLexicalScanner * _scanner;
+
+    /** Site description to index into the _sites array */
+    NSMutableDictionary * _siteIndex;
+
+    /** The description of each site, in the same order as _sites */
+    NSMutableArray * _siteKeys;
+
+    /** Array of per-site counter structures */
+    NSMutableData * _sites;
+
+    /** Live allocations; each address maps to the index of its site */
+    NSMutableDictionary * _live;
+
+    /** The names of the active functions, outermost first */
+    NSMutableArray * _stack;
+
+    /** The folded form of _stack, used to build site descriptions */
+    NSString * _stackKey;
+
+    /** Live bytes for each site at the time of the peak */
+    NSMutableData * _peakSites;
+
+    /** Number of allocations in each size bucket */
+    long _histogram[TCHEAP_BUCKETS];
+
+    /** Bytes currently allocated */
+    long _liveBytes;
+
+    /** The largest value of _liveBytes seen */
+    long _peakBytes;
+}
+
+/** The node whose execution is allocating storage, if any */
+@property TCSyntaxNode * site;
+
+/**
+ Create a heap profiler for a compiled program.
+ @param scanner the scanner that holds the program's source and line map
+ @return a new heap profiler
+ */
+-(instancetype) initWithScanner:(TCLexicalScanner*) scanner;
+
+/**
+ Record entry to a function.
+ @param name the name of the function
+ */
+-(void) enter:(NSString*) name;
+
+/**
+ Record the return from the most recently entered function.
+ */
+-(void) exit;
+
+/**
+ Record a dynamic allocation, charged to the current site.
+ @param address the address of the new storage
+ @param size the number of bytes allocated
+ */
+-(void) allocated:(long) address size:(long) size;
+
+/**
+ Record the release of a dynamic allocation.
+ @param address the address of the storage
+ @param size the number of bytes released
+ */
+-(void) freed:(long) address size:(long) size;
+
+/**
+ Write the heap report.
+ @param file where to write the report
+ @param storage the storage manager, for the state of its free list
+ @param limit the maximum number of sites to list in each section
+ */
+-(void) report:(FILE*) file storage:(TCStorageManager*) storage sites:(int) limit;
+
+@end
@@ -0,0 +1,222 @@
+//
+//  TCHeapProfiler.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCHeapProfiler.h"
+#import "TCSyntaxNode.h"
+#import "TCLexicalScanner.h"
+#import "TCStorageManager.h"
+
+__thread __unsafe_unretained TCHeapProfiler * activeHeapProfiler = nil;
+
+/** Counters kept for each allocation site */
+typedef struct {
+    long allocs;
+    long allocBytes;
+    long frees;
+    long freeBytes;
+    long liveBlocks;
+    long liveBytes;
+} TCHeapSite;
+
+@implementation TCHeapProfiler
+
+#pragma mark - Initialization
+
+-(instancetype) initWithScanner:(TCLexicalScanner *)scanner
+{
+    if(( self = [super init])) {
+        _scanner = scanner;
+        _siteIndex = [NSMutableDictionary dictionary];
+        _siteKeys = [NSMutableArray array];
+        _sites = [NSMutableData data];
+        _live = [NSMutableDictionary dictionary];
+        _stack = [NSMutableArray array];
+        _stackKey = @"";
+        _peakSites = [NSMutableData data];
+        memset(_histogram, 0, sizeof(_histogram));
+        _liveBytes = 0L;
+        _peakBytes = 0L;
+    }
+    return self;
+}
+
+#pragma mark - Accumulation
+
+-(void) enter:(NSString *)name
+{
+    [_stack addObject:name];
+    _stackKey = [_stack componentsJoinedByString:@";"];
+}
+
+-(void) exit
+{
+    if( _stack.count == 0 )
+        return;
+    [_stack removeLastObject];
+    _stackKey = [_stack componentsJoinedByString:@";"];
+}
+
+/**
+ Find the index of the current site, adding it if this is the first
+ allocation made there.  A site is the call stack plus the source line
+ and name of the node doing the allocation.
+ */
+-(long) currentSite
+{
+    NSString * where = @"(runtime)";
+    if( _site != nil ) {
+        long line = _site.position > 0 ? [_scanner lineNumberAtPosition:_site.position] : -1L;
+        NSString * what = _site.nodeType == LANGUAGE_CALL ? _site.spelling : @"string";
+        where = line >= 0 ? [NSString stringWithFormat:@"line %ld %@", line + 1, what] : what;
+    }
+    NSString * key = _stackKey.length ? [NSString stringWithFormat:@"%@ @ %@", _stackKey, where] : where;
+
+    NSNumber * index = _siteIndex[key];
+    if( index == nil ) {
+        index = [NSNumber numberWithLong:_siteKeys.count];
+        _siteIndex[key] = index;
+        [_siteKeys addObject:key];
+        [_sites increaseLengthBy:sizeof(TCHeapSite)];
+    }
+    return index.longValue;
+}
+
+-(void) allocated:(long)address size:(long)size
+{
+    long index = [self currentSite];
+    TCHeapSite * site = (TCHeapSite*) _sites.mutableBytes + index;
+    site->allocs++;
+    site->allocBytes += size;
+    site->liveBlocks++;
+    site->liveBytes += size;
+    _live[[NSNumber numberWithLong:address]] = [NSNumber numberWithLong:index];
+
+    int bucket = 0;
+    while( bucket < TCHEAP_BUCKETS - 1 && (1L << bucket) < size )
+        bucket++;
+    _histogram[bucket]++;
+
+    // When the heap reaches a new peak, remember what it is made of.
+
+    _liveBytes += size;
+    if( _liveBytes > _peakBytes ) {
+        _peakBytes = _liveBytes;
+        long count = _siteKeys.count;
+        [_peakSites setLength:count * sizeof(long)];
+        long * peak = _peakSites.mutableBytes;
+        const TCHeapSite * sites = _sites.bytes;
+        for( long ix = 0; ix < count; ix++ )
+            peak[ix] = sites[ix].liveBytes;
+    }
+}
+
+-(void) freed:(long)address size:(long)size
+{
+    NSNumber * key = [NSNumber numberWithLong:address];
+    NSNumber * index = _live[key];
+    if( index == nil )
+        return;
+    [_live removeObjectForKey:key];
+
+    TCHeapSite * site = (TCHeapSite*) _sites.mutableBytes + index.longValue;
+    site->frees++;
+    site->freeBytes += size;
+    site->liveBlocks--;
+    site->liveBytes -= size;
+    _liveBytes -= size;
+}
+
+#pragma mark - Output
+
+/**
+ Get the indexes of the sites with a non-zero value, largest first.
+ */
+-(NSArray*) sitesByValue:(const long*) values stride:(long) stride count:(long) count
+{
+    NSMutableArray * order = [NSMutableArray array];
+    for( long ix = 0; ix < count; ix++ )
+        if( values[ix * stride] > 0 )
+            [order addObject:[NSNumber numberWithLong:ix]];
+    [order sortUsingComparator:^NSComparisonResult(NSNumber * a, NSNumber * b) {
+        long va = values[a.longValue * stride];
+        long vb = values[b.longValue * stride];
+        return va > vb ? NSOrderedAscending : (va < vb ? NSOrderedDescending : NSOrderedSame);
+    }];
+    return order;
+}
+
+-(void) report:(FILE *)file storage:(TCStorageManager *)storage sites:(int)limit
+{
+    const TCHeapSite * sites = _sites.bytes;
+    long count = _siteKeys.count;
+    long allocs = 0, allocBytes = 0, frees = 0, freeBytes = 0;
+    for( long ix = 0; ix < count; ix++ ) {
+        allocs += sites[ix].allocs;
+        allocBytes += sites[ix].allocBytes;
+        frees += sites[ix].frees;
+        freeBytes += sites[ix].freeBytes;
+    }
+
+    fprintf(file, "HEAP: %ld allocations (%ld bytes), %ld frees (%ld bytes), peak %ld bytes\n\n",
+            allocs, allocBytes, frees, freeBytes, _peakBytes);
+
+    // Storage still allocated at exit, which is leaked unless the program
+    // meant to keep it for its whole run.
+
+    fprintf(file, "Live at exit:\n%10s %8s %8s  %s\n", "bytes", "blocks", "allocs", "site");
+    NSArray * order = [self sitesByValue:(count ? &sites[0].liveBytes : NULL) stride:sizeof(TCHeapSite) / sizeof(long) count:count];
+    int listed = 0;
+    for( NSNumber * n in order ) {
+        if( listed++ >= limit )
+            break;
+        const TCHeapSite * s = &sites[n.longValue];
+        fprintf(file, "%10ld %8ld %8ld  %s\n", s->liveBytes, s->liveBlocks, s->allocs,
+                [_siteKeys[n.longValue] UTF8String]);
+    }
+    if( order.count == 0 )
+        fprintf(file, "%10s\n", "none");
+
+    // What the heap was made of at its largest.
+
+    long peakCount = _peakSites.length / sizeof(long);
+    const long * peak = _peakSites.bytes;
+    fprintf(file, "\nAt peak:\n%10s %7s  %s\n", "bytes", "share", "site");
+    order = [self sitesByValue:peak stride:1 count:peakCount];
+    listed = 0;
+    for( NSNumber * n in order ) {
+        if( listed++ >= limit )
+            break;
+        fprintf(file, "%10ld %6.1f%%  %s\n", peak[n.longValue],
+                _peakBytes > 0 ? 100.0 * peak[n.longValue] / _peakBytes : 0.0,
+                [_siteKeys[n.longValue] UTF8String]);
+    }
+
+    // Allocation sizes, in power-of-two buckets.
+
+    fprintf(file, "\nAllocation sizes:\n%12s %10s\n", "up to", "count");
+    for( int bucket = 0; bucket < TCHEAP_BUCKETS; bucket++ ) {
+        if( _histogram[bucket] == 0 )
+            continue;
+        if( bucket == TCHEAP_BUCKETS - 1 )
+            fprintf(file, "%12s %10ld\n", "larger", _histogram[bucket]);
+        else
+            fprintf(file, "%12ld %10ld\n", 1L << bucket, _histogram[bucket]);
+    }
+
+    // The free list only reuses a block for a request of exactly the same
+    // size, so bytes on it are only useful to identical allocations.
+
+    long freeBlocks = 0, freeListBytes = 0, largest = 0;
+    [storage freeListBlocks:&freeBlocks bytes:&freeListBytes largest:&largest];
+    long region = storage.size - storage.dynamic;
+    fprintf(file, "\nFree list: %ld blocks, %ld bytes, largest %ld; dynamic region %ld bytes, %.1f%% on the free list\n",
+            freeBlocks, freeListBytes, largest, region,
+            region > 0 ? 100.0 * freeListBytes / region : 0.0);
+}
+
+@end
@@ -0,0 +1,74 @@
+//
+//  TCInputBuffer.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  A large refillable buffer over a file descriptor.  The stdin builtins
+//  (getchar, readline, and read) all share the single standardInput
+//  instance, so data buffered by one of them is seen by the others, and
+//  memory use is the same no matter how much input is piped in.
+
+#import <Foundation/Foundation.h>
+
+/** Default size of the input buffer, in bytes */
+#define TCINPUT_BUFFER_SIZE 65536L
+
+@interface TCInputBuffer : NSObject
+
+{
+    /** The buffered bytes; valid data is from _start up to _end */
+    char * _buffer;
+    long _capacity;
+    long _start;
+    long _end;
+    
+    /** The file descriptor the buffer is filled from */
+    int _fd;
+    
+    /** Set once a read returns end-of-file */
+    BOOL _eof;
+}
+
+/**
+ The shared buffer that reads the process's standard input.
+ @return the standard input buffer
+ */
++(instancetype) standardInput;
+
+/**
+ Create a buffer over an open file descriptor.
+ @param fd the descriptor to read from
+ @param capacity the size of the buffer in bytes
+ @return a new instance of the buffer
+ */
+-(instancetype) initWithDescriptor:(int) fd capacity:(long) capacity;
+
+/**
+ Read a single character.
+ @return the character as an unsigned value, or EOF at end of input
+ */
+-(int) getChar;
+
+/**
+ Read a line into a caller's buffer, in the manner of fgets().  At most
+ size-1 bytes are stored, and the line is always null terminated.  The
+ newline, if one was found within that many bytes, is included.
+ @param dest where to store the line
+ @param size the size of the destination, in bytes
+ @return the number of bytes stored (not counting the null), or 0 at
+ end of input
+ */
+-(long) readLine:(char*) dest size:(long) size;
+
+/**
+ Read up to length bytes.  Buffered data is returned first; large reads
+ then go straight from the descriptor to the destination.
+ @param dest where to store the bytes
+ @param length the maximum number of bytes to read
+ @return the number of bytes stored, or 0 at end of input
+ */
+-(long) read:(char*) dest length:(long) length;
+
+@end
@@ -0,0 +1,157 @@
+//
+//  TCInputBuffer.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCInputBuffer.h"
+#import <unistd.h>
+#import <errno.h>
+
+@implementation TCInputBuffer
+
+#pragma mark - Initialization
+
++(instancetype) standardInput
+{
+    static TCInputBuffer * standardInput = nil;
+    static dispatch_once_t once;
+    
+    dispatch_once(&once, ^{
+        standardInput = [[TCInputBuffer alloc]initWithDescriptor:STDIN_FILENO
+                                                        capacity:TCINPUT_BUFFER_SIZE];
+    });
+    return standardInput;
+}
+
+-(instancetype) initWithDescriptor:(int) fd capacity:(long) capacity
+{
+    if(( self = [super init])) {
+        _buffer = malloc(capacity);
+        if( !_buffer )
+            return nil;
+        _capacity = capacity;
+        _start = 0L;
+        _end = 0L;
+        _fd = fd;
+        _eof = NO;
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    free(_buffer);
+}
+
+#pragma mark - Buffer Management
+
+/**
+ Add more data to the buffer.  Any unread bytes are first moved to the
+ front so there is as much room as possible after them.
+ @return the number of bytes added, or 0 at end of input
+ */
+-(long) fill
+{
+    if( _eof )
+        return 0L;
+    
+    if( _start > 0L ) {
+        memmove(_buffer, _buffer + _start, _end - _start);
+        _end -= _start;
+        _start = 0L;
+    }
+    if( _end == _capacity )
+        return 0L;
+    
+    ssize_t count;
+    do {
+        count = read(_fd, _buffer + _end, _capacity - _end);
+    } while( count < 0 && errno == EINTR );
+    
+    if( count <= 0 ) {
+        _eof = YES;
+        return 0L;
+    }
+    _end += count;
+    return count;
+}
+
+#pragma mark - Reading
+
+-(int) getChar
+{
+    if( _start == _end && [self fill] == 0L )
+        return EOF;
+    return (unsigned char) _buffer[_start++];
+}
+
+-(long) readLine:(char*) dest size:(long) size
+{
+    if( size <= 0L )
+        return 0L;
+    
+    long stored = 0L;
+    long room = size - 1L;
+    
+    // Copy whole runs of buffered data at a time, using memchr() to find
+    // the end of the line, and only refill when the buffer is drained.
+    
+    while( stored < room ) {
+        if( _start == _end && [self fill] == 0L )
+            break;
+        
+        long available = _end - _start;
+        if( available > room - stored )
+            available = room - stored;
+        
+        char * newline = memchr(_buffer + _start, '\n', available);
+        long count = newline ? (newline - (_buffer + _start)) + 1L : available;
+        
+        memcpy(dest + stored, _buffer + _start, count);
+        _start += count;
+        stored += count;
+        if( newline )
+            break;
+    }
+    
+    dest[stored] = 0;
+    return stored;
+}
+
+-(long) read:(char*) dest length:(long) length
+{
+    if( length <= 0L )
+        return 0L;
+    
+    if( _start == _end ) {
+        
+        // Nothing is buffered.  A request at least as big as the buffer
+        // is read directly, since copying it through would gain nothing.
+        
+        if( length >= _capacity && !_eof ) {
+            ssize_t count;
+            do {
+                count = read(_fd, dest, length);
+            } while( count < 0 && errno == EINTR );
+            if( count <= 0 ) {
+                _eof = YES;
+                return 0L;
+            }
+            return count;
+        }
+        if([self fill] == 0L )
+            return 0L;
+    }
+    
+    long count = _end - _start;
+    if( count > length )
+        count = length;
+    memcpy(dest, _buffer + _start, count);
+    _start += count;
+    return count;
+}
+
+@end
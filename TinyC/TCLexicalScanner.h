@@ -61,6 +61,7 @@
 -(void) dump;
 -(NSString*) getLineAtLine:(long)lineNumber;
 -(NSString*) getLineAtPosition:(long) position;
+-(long) lineNumberAtPosition:(long) position;
 -(NSString*) currentLineText;
 -(long) currentLineNumber;
 
@@ -123,6 +123,7 @@
         [self addSpelling:@"break" forToken:TOKEN_BREAK];
         [self addSpelling:@"continue" forToken:TOKEN_CONTINUE];
         [self addSpelling:@"%" forToken:TOKEN_PERCENT];
+        [self addSpelling:@"extern" forToken:TOKEN_EXTERN];
         [self doNotPersist];
         
     }
@@ -300,6 +301,29 @@
 }
 
 
+//
+//  Find the (zero-based) line number that contains a character position
+//  in the source buffer, or -1 if it is not within any line.  The line
+//  map is in order, so this is a binary search.
+//
+-(long) lineNumberAtPosition:(long) position
+{
+    long low = 0;
+    long high = (long) lineMap.count - 1;
+    
+    while( low <= high ) {
+        long mid = (low + high) / 2;
+        NSRange r = [lineMap[mid] rangeValue];
+        if( position < (long) r.location )
+            high = mid - 1;
+        else if( position > (long)(r.location + r.length))
+            low = mid + 1;
+        else
+            return mid;
+    }
+    return -1L;
+}
+
 -(NSString*) getLineAtLine:(long)lineNumber
 {
     if(lineNumber < 0 || lineNumber >= lineMap.count)
@@ -631,6 +655,15 @@
         if( isInteger && (double_value == (int)double_value)) {
             [lastToken setType:TOKEN_INTEGER];
         }
+        else if( !isInteger && charPos < len &&
+                 ([buffer characterAtIndex:charPos] == 'f' || [buffer characterAtIndex:charPos] == 'F')) {
+            
+            // A float constant like 1.5f.  The suffix is skipped but is
+            // not part of the spelling.
+            
+            charPos++;
+            [lastToken setType:TOKEN_FLOAT];
+        }
         else {
             [lastToken setType:TOKEN_DOUBLE];
         }
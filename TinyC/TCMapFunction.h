@@ -0,0 +1,114 @@
+//
+//  TCMapFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Base class for the map_ builtins, which give TinyC programs a hash map
+//  keyed by long or by char* string.  The map is an open-addressing table
+//  with linear probing that lives in the dynamic storage region, so it is
+//  counted by -dm, -M and -dh like any other allocation.  A map handle is
+//  the address of its header.  String keys are copied into storage owned
+//  by the map, so the caller may reuse its key buffer.  Values are longs;
+//  a pointer can be stored as one.
+
+#import "TCFunction.h"
+
+/** Identifies a valid map header */
+#define TCMAP_MAGIC 0x50414d4354L
+
+/** The number of slots in a new map; always a power of two */
+#define TCMAP_MIN_CAPACITY 16L
+
+/** Slot hash values that do not hold an entry */
+#define TCMAP_EMPTY   0L
+#define TCMAP_DELETED 1L
+
+/**
+ The header of a map, at the address that is the map's handle.
+ */
+typedef struct {
+    long magic;
+    long stringKeys;
+    long count;
+    long used;
+    long capacity;
+    long slots;
+} TCMapHeader;
+
+/**
+ One slot of the table.  The hash is TCMAP_EMPTY or TCMAP_DELETED for a
+ slot with no entry; live hashes are always larger.  For a string map the
+ key is the address of the map's copy of the string.
+ */
+typedef struct {
+    long hash;
+    long key;
+    long value;
+} TCMapSlot;
+
+@interface TCMapFunction : TCFunction
+
+/**
+ Get the header of a map from its handle.  If the handle is not a live
+ map, the error property is set.
+ @param handle the map handle argument
+ @return the header, or NULL if there was an error
+ */
+-(TCMapHeader*) mapOf:(TCValue*) handle;
+
+/**
+ Get the slots of a map.
+ @param map the map header
+ @return the first slot, or NULL if the slots are not addressable
+ */
+-(TCMapSlot*) slotsOf:(TCMapHeader*) map;
+
+/**
+ Work out the hash of a key.  For a string map the text of the key is
+ returned as well.
+ @param key the key argument
+ @param map the map the key is for
+ @param text set to the key text for a string map
+ @param length set to the length of the key text
+ @return the hash, or TCMAP_EMPTY if a string key is not addressable
+ */
+-(long) hashOf:(TCValue*) key map:(TCMapHeader*) map text:(const char**) text length:(long*) length;
+
+/**
+ Look for a key in a map.
+ @param map the map header
+ @param key the key as a long, for a long map
+ @param text the key text, for a string map
+ @param length the length of the key text
+ @param hash the hash of the key
+ @param insert if not NULL, set to the slot a new entry for the key should
+ use when the key is not found
+ @return the index of the slot holding the key, or -1 if it is not found
+ */
+-(long) find:(TCMapHeader*) map
+         key:(long) key
+        text:(const char*) text
+      length:(long) length
+        hash:(long) hash
+      insert:(long*) insert;
+
+/**
+ Make sure a map has room for one more entry, moving the entries to a
+ larger table if it is getting full.
+ @param map the map header
+ @return NO if storage is exhausted
+ */
+-(BOOL) reserve:(TCMapHeader*) map;
+
+/**
+ Get a live slot of a map by index, for iteration.  If the index is not a
+ live slot, the error property is set.
+ @param handle the map handle argument
+ @param index the slot index argument
+ @return the slot, or NULL if there was an error
+ */
+-(TCMapSlot*) slotOf:(TCValue*) handle index:(TCValue*) index;
+
+@end
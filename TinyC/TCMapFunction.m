@@ -0,0 +1,176 @@
+//
+//  TCMapFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCMapFunction.h"
+
+/**
+ Make a live slot hash from a mixed value, keeping it clear of the
+ empty and deleted markers.
+ */
+static long liveHash( unsigned long h )
+{
+    return (long)(h | 2UL);
+}
+
+@implementation TCMapFunction
+
+-(TCMapHeader*) mapOf:(TCValue *)handle
+{
+    TCMapHeader * map = (TCMapHeader*)[self.storage pointerTo:handle.getLong
+                                                       length:sizeof(TCMapHeader)
+                                                     forWrite:YES];
+    if( map == NULL || map->magic != TCMAP_MAGIC ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:1]];
+        return NULL;
+    }
+    return map;
+}
+
+-(TCMapSlot*) slotsOf:(TCMapHeader *)map
+{
+    return (TCMapSlot*)[self pointerTo:map->slots
+                                length:map->capacity * sizeof(TCMapSlot)
+                              forWrite:YES];
+}
+
+-(long) hashOf:(TCValue *)key map:(TCMapHeader *)map text:(const char **)text length:(long *)length
+{
+    // Strings use FNV-1a; longs use the splitmix64 finalizer, so keys that
+    // differ only in their high bits still land in different slots.
+
+    if( map->stringKeys ) {
+        const char * s = [self cString:key];
+        if( s == NULL )
+            return TCMAP_EMPTY;
+        unsigned long h = 14695981039346656037UL;
+        long n = 0;
+        for( ; s[n]; n++ ) {
+            h ^= (unsigned char) s[n];
+            h *= 1099511628211UL;
+        }
+        *text = s;
+        *length = n;
+        return liveHash(h);
+    }
+
+    unsigned long h = (unsigned long) key.getLong;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9UL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebUL;
+    h = h ^ (h >> 31);
+    *text = NULL;
+    *length = 0;
+    return liveHash(h);
+}
+
+-(long) find:(TCMapHeader *)map
+         key:(long)key
+        text:(const char *)text
+      length:(long)length
+        hash:(long)hash
+      insert:(long *)insert
+{
+    TCMapSlot * slots = [self slotsOf:map];
+    if( slots == NULL )
+        return -1L;
+
+    unsigned long mask = map->capacity - 1;
+    long firstDeleted = -1L;
+    unsigned long ix = (unsigned long) hash & mask;
+
+    for( long probes = 0; probes < map->capacity; probes++, ix = (ix + 1) & mask ) {
+        TCMapSlot * slot = slots + ix;
+        if( slot->hash == TCMAP_EMPTY ) {
+            if( insert )
+                *insert = firstDeleted >= 0 ? firstDeleted : (long) ix;
+            return -1L;
+        }
+        if( slot->hash == TCMAP_DELETED ) {
+            if( firstDeleted < 0 )
+                firstDeleted = ix;
+            continue;
+        }
+        if( slot->hash != hash )
+            continue;
+        if( !map->stringKeys ) {
+            if( slot->key == key )
+                return ix;
+            continue;
+        }
+        const char * stored = [self.storage pointerTo:slot->key length:length + 1 forWrite:NO];
+        if( stored && memcmp(stored, text, length + 1) == 0 )
+            return ix;
+    }
+    if( insert )
+        *insert = firstDeleted;
+    return -1L;
+}
+
+-(BOOL) reserve:(TCMapHeader *)map
+{
+    // Keep the table no more than three quarters full, counting deleted
+    // slots, since they lengthen probes just as entries do.
+
+    if( (map->used + 1) * 4 <= map->capacity * 3 )
+        return YES;
+
+    long capacity = TCMAP_MIN_CAPACITY;
+    while( capacity < (map->count + 1) * 2 )
+        capacity <<= 1;
+
+    long address = [self.storage allocateDynamic:capacity * sizeof(TCMapSlot)];
+    TCMapSlot * slots = address ? (TCMapSlot*)[self.storage pointerTo:address
+                                                                length:capacity * sizeof(TCMapSlot)
+                                                              forWrite:YES] : NULL;
+    TCMapSlot * old = [self slotsOf:map];
+    if( slots == NULL || old == NULL )
+        return NO;
+    memset(slots, 0, capacity * sizeof(TCMapSlot));
+
+    // Entries are moved by hash alone; the keys are already known to be
+    // distinct.
+
+    unsigned long mask = capacity - 1;
+    for( long ix = 0; ix < map->capacity; ix++ ) {
+        if( old[ix].hash == TCMAP_EMPTY || old[ix].hash == TCMAP_DELETED )
+            continue;
+        unsigned long to = (unsigned long) old[ix].hash & mask;
+        while( slots[to].hash != TCMAP_EMPTY )
+            to = (to + 1) & mask;
+        slots[to] = old[ix];
+    }
+
+    [self.storage free:map->slots];
+    map->slots = address;
+    map->capacity = capacity;
+    map->used = map->count;
+    return YES;
+}
+
+-(TCMapSlot*) slotOf:(TCValue *)handle index:(TCValue *)index
+{
+    TCMapHeader * map = [self mapOf:handle];
+    if( map == NULL )
+        return NULL;
+    TCMapSlot * slots = [self slotsOf:map];
+    if( slots == NULL )
+        return NULL;
+
+    long ix = index.getLong;
+    if( ix < 0 || ix >= map->capacity ||
+        slots[ix].hash == TCMAP_EMPTY || slots[ix].hash == TCMAP_DELETED ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARRAY_BOUNDS
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithLong:ix]];
+        return NULL;
+    }
+    return slots + ix;
+}
+
+@end
@@ -0,0 +1,158 @@
+//
+//  TCMetrics.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Runtime counters.  These are plain integers in a per-thread structure
+//  that the interpreters and the storage manager bump as they work, so they
+//  are always on and cost one increment each.  The counters are reset at
+//  the start of each execution and read back through [TinyC metrics].
+//  Being per-thread, executions on different threads count separately;
+//  the threads a program starts are merged into its counters when joined,
+//  and share its limits through a TCRuntimeBudget.
+
+#import <Foundation/Foundation.h>
+
+/**
+ The counters kept for an execution.
+ */
+typedef struct {
+    /** Statement and expression nodes executed */
+    long nodes;
+
+    /** Calls to functions written in TinyC */
+    long calls;
+
+    /** Trips around for and while loops */
+    long iterations;
+
+    /** Calls to builtin functions */
+    long builtinCalls;
+
+    /** Typed reads from runtime storage */
+    long reads;
+
+    /** Typed writes to runtime storage */
+    long writes;
+
+    /** Runtime symbol table lookups */
+    long lookups;
+
+    /** Dynamic storage allocations, and the bytes they requested */
+    long allocs;
+    long allocBytes;
+
+    /** Dynamic storage releases, and the bytes they released */
+    long frees;
+    long freeBytes;
+
+    /** The most bytes of dynamic storage allocated at once */
+    long peakBytes;
+
+    /** The nodes already charged to the execution's shared budget */
+    long chargedNodes;
+} TCRuntimeCounters;
+
+/** The counters for the execution running on this thread */
+extern __thread TCRuntimeCounters runtimeCounters;
+
+/** Set all the runtime counters back to zero */
+void resetRuntimeCounters(void);
+
+/**
+ Add the counters of another thread of the same execution to this one's,
+ as when a spawned thread is joined.
+ @param counters the other thread's counters
+ */
+void mergeRuntimeCounters(TCRuntimeCounters * counters);
+
+/**
+ The limit an execution ran into.
+ */
+typedef enum {
+    TCLIMIT_NONE = 0,
+    TCLIMIT_NODES,
+    TCLIMIT_MEMORY
+} TCLimit;
+
+/**
+ What the threads of an execution have used between them, updated
+ atomically.  A thread adds the nodes it has run each time it checks the
+ limits, and each dynamic allocation and release is charged as it
+ happens, so a program cannot get more by starting threads.
+ */
+typedef struct {
+    /** Statement and expression nodes executed by all the threads */
+    long nodes;
+
+    /** Bytes of dynamic storage allocated and not yet freed */
+    long bytes;
+
+    /** The limit that was hit, which stops every thread */
+    TCLimit exceeded;
+} TCRuntimeBudget;
+
+/**
+ The budget of an execution.  A limit of zero means there is none.  The
+ node limit is checked at loop back-edges and calls, which every long
+ running program passes through; the memory limit is checked by each
+ dynamic allocation, which fails once the limit would be passed.
+ */
+typedef struct {
+    /** The most statement and expression nodes to execute */
+    long nodes;
+
+    /** The most bytes of dynamic storage to have allocated at once */
+    long memory;
+
+    /** The limit that was hit, which stops the program */
+    TCLimit exceeded;
+
+    /** What the execution has used across all its threads, or NULL if
+        there are no limits */
+    TCRuntimeBudget * budget;
+} TCRuntimeLimits;
+
+/** The limits of the execution running on this thread */
+extern __thread TCRuntimeLimits runtimeLimits;
+
+/**
+ Charge the nodes this thread has run since it last did so to the shared
+ budget, and see if any thread of the execution has hit a limit.
+ @return YES if a limit has been hit and the program must stop
+ */
+BOOL chargeBudget(void);
+
+/**
+ Has the execution used up its budget?
+ @return YES if a limit has been hit and the program must stop
+ */
+static inline BOOL limitExceeded(void)
+{
+    if( runtimeLimits.budget )
+        return chargeBudget();
+    if( runtimeLimits.nodes && runtimeCounters.nodes > runtimeLimits.nodes )
+        runtimeLimits.exceeded = TCLIMIT_NODES;
+    return runtimeLimits.exceeded != TCLIMIT_NONE;
+}
+
+/**
+ Charge a dynamic allocation to the execution's memory limit.
+ @param size the bytes being allocated
+ @return NO if the allocation would pass the limit, which is then hit
+ */
+BOOL chargeMemory(long size);
+
+/**
+ Give the bytes of a dynamic storage release back to the shared budget.
+ @param size the bytes released
+ */
+void releaseMemory(long size);
+
+/**
+ Describe the limit that was hit, for the error that stops the program.
+ @return the description, or nil if no limit was hit
+ */
+NSString * limitDescription(void);
@@ -0,0 +1,100 @@
+//
+//  TCMetrics.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCMetrics.h"
+
+__thread TCRuntimeCounters runtimeCounters;
+
+__thread TCRuntimeLimits runtimeLimits;
+
+void resetRuntimeCounters(void)
+{
+    memset(&runtimeCounters, 0, sizeof(runtimeCounters));
+}
+
+void mergeRuntimeCounters(TCRuntimeCounters * counters)
+{
+    runtimeCounters.nodes += counters->nodes;
+    runtimeCounters.calls += counters->calls;
+    runtimeCounters.iterations += counters->iterations;
+    runtimeCounters.builtinCalls += counters->builtinCalls;
+    runtimeCounters.reads += counters->reads;
+    runtimeCounters.writes += counters->writes;
+    runtimeCounters.lookups += counters->lookups;
+    runtimeCounters.allocs += counters->allocs;
+    runtimeCounters.allocBytes += counters->allocBytes;
+    runtimeCounters.frees += counters->frees;
+    runtimeCounters.freeBytes += counters->freeBytes;
+    if( counters->peakBytes > runtimeCounters.peakBytes )
+        runtimeCounters.peakBytes = counters->peakBytes;
+
+    // The other thread charged its own nodes to the budget.
+
+    runtimeCounters.chargedNodes += counters->chargedNodes;
+}
+
+/**
+ Record the first limit hit by any thread of the execution.
+ */
+static void budgetExceeded(TCRuntimeBudget * budget, TCLimit limit)
+{
+    TCLimit none = TCLIMIT_NONE;
+    __atomic_compare_exchange_n(&budget->exceeded, &none, limit, false,
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+BOOL chargeBudget(void)
+{
+    TCRuntimeBudget * budget = runtimeLimits.budget;
+    long nodes = __atomic_add_fetch(&budget->nodes,
+                                    runtimeCounters.nodes - runtimeCounters.chargedNodes,
+                                    __ATOMIC_RELAXED);
+    runtimeCounters.chargedNodes = runtimeCounters.nodes;
+    if( runtimeLimits.nodes && nodes > runtimeLimits.nodes )
+        budgetExceeded(budget, TCLIMIT_NODES);
+
+    TCLimit limit = __atomic_load_n(&budget->exceeded, __ATOMIC_RELAXED);
+    if( limit != TCLIMIT_NONE && runtimeLimits.exceeded == TCLIMIT_NONE )
+        runtimeLimits.exceeded = limit;
+    return runtimeLimits.exceeded != TCLIMIT_NONE;
+}
+
+BOOL chargeMemory(long size)
+{
+    TCRuntimeBudget * budget = runtimeLimits.budget;
+    if( budget == NULL || runtimeLimits.memory == 0L )
+        return YES;
+
+    long live = __atomic_add_fetch(&budget->bytes, size, __ATOMIC_RELAXED);
+    if( live > runtimeLimits.memory ) {
+        __atomic_sub_fetch(&budget->bytes, size, __ATOMIC_RELAXED);
+        budgetExceeded(budget, TCLIMIT_MEMORY);
+        runtimeLimits.exceeded = TCLIMIT_MEMORY;
+        return NO;
+    }
+    return YES;
+}
+
+void releaseMemory(long size)
+{
+    TCRuntimeBudget * budget = runtimeLimits.budget;
+    if( budget != NULL )
+        __atomic_sub_fetch(&budget->bytes, size, __ATOMIC_RELAXED);
+}
+
+NSString * limitDescription(void)
+{
+    switch( runtimeLimits.exceeded ) {
+        case TCLIMIT_NODES:
+            return [NSString stringWithFormat:@"more than %ld nodes executed", runtimeLimits.nodes];
+        case TCLIMIT_MEMORY:
+            return [NSString stringWithFormat:@"more than %ld bytes of dynamic storage", runtimeLimits.memory];
+        default:
+            return nil;
+    }
+}
@@ -14,6 +14,97 @@
 #import "TinyC.h"
 
 @implementation TCModuleParser
+
+/**
+ Parse the parameter list of a function, after the opening parenthesis,
+ adding a DECLARE node for each parameter to the function node.
+ @param scanner the scanner positioned after the '('
+ @param decl the function node
+ @return NO if there was a syntax error, which is stored in the scanner
+ */
+-(BOOL) parseParameters:(TCLexicalScanner*) scanner into:(TCSyntaxNode*) decl
+{
+    TCDeclarationParser * dp = [[TCDeclarationParser alloc]init];
+    
+    BOOL requireComma = NO;
+    while(YES) {
+        if([scanner isNextToken:TOKEN_PAREN_RIGHT]) {
+            break;
+        }
+        if( requireComma && ![scanner isNextToken:TOKEN_COMMA]) {
+            scanner.error = [[TCError alloc]initWithCode:TCERROR_EXP_COMMA usingScanner:scanner];
+            return NO;
+        }
+        
+        TCSyntaxNode * arg = [dp parseSingle:scanner];
+        if( scanner.error) {
+            return NO;
+        }
+        if( arg == nil || arg.nodeType != LANGUAGE_DECLARE){
+            scanner.error = [[TCError alloc]initWithCode:TCERROR_EXP_DECLARATION usingScanner:scanner];
+            return NO;
+        }
+        [decl.subNodes addObject:arg];
+        
+        // Later, handle var-args here
+        
+        requireComma = YES;
+    }
+    return YES;
+}
+
+/**
+ Parse the declaration of a function in a shared library, after the
+ extern keyword:
+ 
+     extern "libm.so.6" double cbrt(double x);
+ 
+ The library is optional; without it the function is looked for in the
+ libraries already loaded into the process.
+ @param scanner the scanner positioned after "extern"
+ @return an EXTERN node, or nil if there was a syntax error
+ */
+-(TCSyntaxNode*) parseExtern:(TCLexicalScanner*) scanner
+{
+    TCSyntaxNode * external = [TCSyntaxNode node:LANGUAGE_EXTERN usingScanner:scanner];
+    external.position = scanner.tokenPosition;
+    external.subNodes = [NSMutableArray array];
+    
+    if([scanner isNextToken:TOKEN_STRING])
+        external.argument = scanner.lastSpelling;
+    
+    TCTypeParser * typeDecl = [[TCTypeParser alloc]init];
+    TCSyntaxNode * decl = [typeDecl parse:scanner];
+    if( decl == nil ) {
+        scanner.error = [[TCError alloc]initWithCode:TCERROR_EXP_FUNC usingScanner:scanner];
+        return nil;
+    }
+    if( ![scanner isNextToken:TOKEN_IDENTIFIER]) {
+        scanner.error = [[TCError alloc]initWithCode:TCERROR_EXP_ENTRYPOINT usingScanner:scanner];
+        return nil;
+    }
+    external.spelling = scanner.lastSpelling;
+    
+    // The return type carries the pointer flag in its action, since there
+    // is no body to look at it later.
+    
+    TCSyntaxNode * returnInfo = [TCSyntaxNode node:LANGUAGE_RETURN_TYPE usingScanner:scanner];
+    returnInfo.position = decl.position;
+    returnInfo.action = decl.subNodes.count > 0 ? decl.action + TCVALUE_POINTER : decl.action;
+    [external addNode:returnInfo];
+    
+    if( ![scanner isNextToken:TOKEN_PAREN_LEFT]) {
+        scanner.error = [[TCError alloc]initWithCode:TCERROR_PARENMISMATCH usingScanner:scanner];
+        return nil;
+    }
+    if( ![self parseParameters:scanner into:external] )
+        return nil;
+    if( ![scanner isNextToken:TOKEN_SEMICOLON]) {
+        scanner.error = [[TCError alloc]initWithCode:TCERROR_SEMICOLON usingScanner:scanner];
+        return nil;
+    }
+    return external;
+}
 -(TCSyntaxNode*) parse:(TCLexicalScanner *)scanner
 {
     return [self parse:scanner name:@"__ANONYMOUS__"];
@@ -40,6 +131,16 @@
         if([scanner isAtEnd])
             break;
         
+        // External functions can be declared among the globals.
+        
+        if([scanner isNextToken:TOKEN_EXTERN]) {
+            TCSyntaxNode * external = [self parseExtern:scanner];
+            if( external == nil )
+                return nil;
+            [module addNode:external];
+            continue;
+        }
+        
         long mark = scanner.position;
         
         TCSyntaxNode * global = [globalDeclares parse:scanner];
@@ -76,6 +177,14 @@
         if([scanner isAtEnd])
             break;
         
+        if([scanner isNextToken:TOKEN_EXTERN]) {
+            TCSyntaxNode * external = [self parseExtern:scanner];
+            if( external == nil )
+                return nil;
+            [module.subNodes addObject:external];
+            continue;
+        }
+        
         // Each entry point starts with a type def
         
         TCTypeParser * typeDecl = [[TCTypeParser alloc]init];
@@ -111,32 +220,8 @@
             
             // There are zero or more arguments which look like type definitions
             
-            TCDeclarationParser * dp = [[TCDeclarationParser alloc]init];
-            
-            BOOL requireComma = NO;
-            while(YES) {
-                if([scanner isNextToken:TOKEN_PAREN_RIGHT]) {
-                    break;
-                }
-                if( requireComma && ![scanner isNextToken:TOKEN_COMMA]) {
-                    scanner.error = [[TCError alloc]initWithCode:TCERROR_EXP_COMMA usingScanner:scanner];
-                    return nil;
-                }
-
-                TCSyntaxNode * arg = [dp parseSingle:scanner];
-                if( scanner.error) {
-                    return nil;
-                }
-                if( arg == nil || arg.nodeType != LANGUAGE_DECLARE){
-                    scanner.error = [[TCError alloc]initWithCode:TCERROR_EXP_DECLARATION usingScanner:scanner];
-                    return nil;
-                }
-                [decl.subNodes addObject:arg];
-                
-                // Later, handle var-args here
-                
-                requireComma = YES;
-            }
+            if( ![self parseParameters:scanner into:decl] )
+                return nil;
             
             // Now, need body of function
             
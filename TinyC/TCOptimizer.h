@@ -0,0 +1,72 @@
+//
+//  TCOptimizer.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Pass that rewrites a function's tree so the interpreter has less of it
+//  to walk.  TCTier runs it on a copy of each function that gets hot.  The interpreter runs the tree directly, so the
+//  optimized form is the tree itself rather than a separate instruction
+//  list; the analysis is done in SSA terms all the same.  Each assignment
+//  to a local gives it a new version, and an expression is named by its
+//  operator and the versions of the values it uses, so two expressions
+//  with the same name are known to compute the same value.  The passes are
+//
+//  - dead code: branches with a constant condition, statements after a
+//    return, break or continue, and expressions whose value is discarded
+//    and which have no effect
+//  - loop-invariant code motion: an expression in a loop whose operands
+//    the loop never assigns, such as n * stride, is computed once into a
+//    temporary before the loop
+//  - common subexpressions: an expression computed again with the same
+//    operand versions reuses the variable or temporary holding it
+//  - copy propagation: after x = y, uses of x read y while neither has
+//    changed
+//  - dead stores: a store overwritten before it is read, or to a local
+//    that is never read, is removed, as is the local's declaration
+//
+//  Only locals of type int, long, float and double are tracked, and only
+//  when the function never takes their address or indexes them.  The
+//  interpreter resolves names at runtime and a called function sees its
+//  caller's locals, so a name that any function uses without declaring it
+//  is never tracked in any function.  Division is never moved into a place
+//  it would run when it would not have before, as it can fail.
+
+#import <Foundation/Foundation.h>
+
+@class TCSyntaxNode;
+
+@interface TCOptimizer : NSObject
+
+/** The number of loop-invariant expressions moved out of loops */
+@property (readonly) long hoistedCount;
+
+/** The number of expressions replaced by a value already computed */
+@property (readonly) long commonCount;
+
+/** The number of uses of a copy replaced by the original */
+@property (readonly) long copyCount;
+
+/** The number of stores and declarations removed */
+@property (readonly) long deadStoreCount;
+
+/** The number of statements and expressions removed as unreachable or
+    without effect */
+@property (readonly) long deadCodeCount;
+
+/**
+ Make an optimizer for the functions of a module, finding the names that
+ any of them uses without declaring.
+ @param tree the parse tree of the module
+ */
+-(instancetype) initWithModule:(TCSyntaxNode*) tree;
+
+/**
+ Optimize a function of the module, in place.  The runtime entry point,
+ which declares the globals, is left alone.
+ @param entry the ENTRYPOINT of the function
+ */
+-(void) optimizeFunction:(TCSyntaxNode*) entry;
+
+@end
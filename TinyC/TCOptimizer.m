@@ -0,0 +1,1431 @@
+//
+//  TCOptimizer.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCOptimizer.h"
+#import "TCSyntaxNode.h"
+#import "TCToken.h"
+#import "TCValue.h"
+#import "TinyC.h"
+
+/** The most times the dead store pass is repeated for one function */
+#define TCOPTIMIZER_PASSES 4
+
+/** The nodes the interpreter walks to store a value in a temporary and
+    then read it back, which a common subexpression must save to be
+    worth replacing */
+#define TCOPTIMIZER_TEMPORARY_COST 3
+
+#pragma mark - Variables
+
+/**
+ A variable declared in the function being optimized.
+ */
+@interface TCOptimizerVariable : NSObject
+
+@property NSString * name;
+@property int type;
+@property int number;
+@property BOOL parameter;
+
+/** Can every use of the variable be seen, so that its value can be
+    tracked? */
+@property BOOL tracked;
+
+/** The reads of the variable's value, other than by an assignment to
+    the variable itself that could be removed along with it */
+@property long reads;
+
+/** The references to the variable of every kind */
+@property long uses;
+
+/** The version of the value the variable holds, while numbering values */
+@property long version;
+
+/** The NAME node that declares the variable, the DECLARE holding it, and
+    the BLOCK the DECLARE is a statement of, if any */
+@property TCSyntaxNode * declaration;
+@property TCSyntaxNode * declare;
+@property TCSyntaxNode * block;
+
+@end
+
+@implementation TCOptimizerVariable
+@end
+
+/**
+ A value known to be held in a variable.  The variable at the given
+ version holds either a computed value, or a copy of the source variable
+ at the given version.
+ */
+@interface TCOptimizerValue : NSObject
+
+@property TCOptimizerVariable * variable;
+@property long version;
+@property TCOptimizerVariable * source;
+@property long sourceVersion;
+
+@end
+
+@implementation TCOptimizerValue
+@end
+
+/**
+ A place an expression is computed, found while numbering values.
+ */
+@interface TCOptimizerSite : NSObject
+
+@property TCSyntaxNode * node;
+@property TCSyntaxNode * parent;
+@property NSUInteger index;
+@property long size;
+
+@end
+
+@implementation TCOptimizerSite
+@end
+
+#pragma mark - Helpers
+
+/**
+ Skip over EXPRESSION nodes that only wrap a single subexpression.
+ */
+static TCSyntaxNode * unwrap( TCSyntaxNode * node )
+{
+    while( node.nodeType == LANGUAGE_EXPRESSION && node.subNodes.count == 1 )
+        node = node.subNodes[0];
+    return node;
+}
+
+/**
+ Get the value of an integer constant node.
+ @return YES if the node is an integer constant
+ */
+static BOOL integerConstant( TCSyntaxNode * node, long * value )
+{
+    node = unwrap(node);
+    if( node.nodeType != LANGUAGE_SCALAR || node.action != TOKEN_INTEGER )
+        return NO;
+    *value = node.spelling.longLongValue;
+    return YES;
+}
+
+/**
+ Is a type one whose values the optimizer can track?
+ */
+static BOOL isArithmetic( int type )
+{
+    return type == TCVALUE_INT || type == TCVALUE_LONG ||
+           type == TCVALUE_FLOAT || type == TCVALUE_DOUBLE;
+}
+
+/**
+ Is a node an operator whose value depends only on its operands?
+ */
+static BOOL isOperator( TCSyntaxNode * node )
+{
+    return node.nodeType == LANGUAGE_DIADIC || node.nodeType == LANGUAGE_RELATION ||
+           node.nodeType == LANGUAGE_MONADIC || node.nodeType == LANGUAGE_CAST;
+}
+
+/**
+ Is a statement one that leaves the statements following it unreached?
+ */
+static BOOL isJump( TCSyntaxNode * node )
+{
+    return node.nodeType == LANGUAGE_RETURN || node.nodeType == LANGUAGE_BREAK ||
+           node.nodeType == LANGUAGE_CONTINUE;
+}
+
+/**
+ Does a tree contain a break or continue, which could carry a value
+ stored in it out of the statement sequence it is in?
+ */
+static BOOL containsLoopJump( TCSyntaxNode * node )
+{
+    if( node.nodeType == LANGUAGE_BREAK || node.nodeType == LANGUAGE_CONTINUE )
+        return YES;
+    for( TCSyntaxNode * sub in node.subNodes )
+        if( containsLoopJump(sub))
+            return YES;
+    return NO;
+}
+
+/**
+ Count the nodes of a tree, which is the work the interpreter does to
+ evaluate it.
+ */
+static long nodeCount( TCSyntaxNode * node )
+{
+    long count = 1;
+    for( TCSyntaxNode * sub in node.subNodes )
+        count += nodeCount(sub);
+    return count;
+}
+
+/**
+ Make a node to stand in the place of another.
+ */
+static TCSyntaxNode * nodeLike( SyntaxNodeType type, TCSyntaxNode * like )
+{
+    TCSyntaxNode * node = [TCSyntaxNode node:type usingScanner:like.scanner];
+    node.position = like.position;
+    return node;
+}
+
+/**
+ Work out the type of an operator's result from the types of its
+ operands, the same way the expression interpreter does.
+ @return the type, or TCVALUE_UNDEFINED if it cannot be known
+ */
+static int operatorType( TCSyntaxNode * node, int left, int right )
+{
+    if( !isArithmetic(left) || !isArithmetic(right))
+        return TCVALUE_UNDEFINED;
+
+    switch( node.nodeType ) {
+        case LANGUAGE_DIADIC:
+            switch( node.action ) {
+                case TOKEN_ADD:
+                case TOKEN_SUBTRACT:
+                case TOKEN_ASTERISK:
+                case TOKEN_DIVIDE:
+                case TOKEN_PERCENT:
+                    return MAX(left, right);
+                case TOKEN_BOOLEAN_AND:
+                case TOKEN_BOOLEAN_OR:
+                    return TCVALUE_LONG;
+            }
+            break;
+
+        case LANGUAGE_RELATION:
+            switch( node.action ) {
+                case TOKEN_EQUAL:
+                case TOKEN_NOT_EQUAL:
+                case TOKEN_GREATER:
+                case TOKEN_GREATER_OR_EQUAL:
+                case TOKEN_LESS:
+                case TOKEN_LESS_OR_EQUAL:
+                    return TCVALUE_LONG;
+            }
+            break;
+
+        case LANGUAGE_MONADIC:
+            if( node.action == TOKEN_SUBTRACT )
+                return left;
+            if( node.action == TOKEN_NOT )
+                return TCVALUE_INT;
+            break;
+
+        case LANGUAGE_CAST:
+        {
+            int type = ((TCSyntaxNode*) node.subNodes[0]).action;
+            return isArithmetic(type) ? type : TCVALUE_UNDEFINED;
+        }
+
+        default:
+            break;
+    }
+    return TCVALUE_UNDEFINED;
+}
+
+/**
+ Name the value of an operator from the names of its operands.  The
+ operands of an operator that commutes are put in a fixed order, so a + b
+ and b + a are named alike.
+ @return the name, or nil if the operator's value cannot be named
+ */
+static NSString * operatorKey( TCSyntaxNode * node, NSString * left, NSString * right )
+{
+    if( left == nil )
+        return nil;
+
+    switch( node.nodeType ) {
+        case LANGUAGE_MONADIC:
+            return [NSString stringWithFormat:@"(m%d %@)", node.action, left];
+
+        case LANGUAGE_CAST:
+            return [NSString stringWithFormat:@"(c%d %@)",
+                    ((TCSyntaxNode*) node.subNodes[0]).action, left];
+
+        case LANGUAGE_DIADIC:
+        case LANGUAGE_RELATION:
+        {
+            if( right == nil )
+                return nil;
+            BOOL commutes = node.action == TOKEN_ADD || node.action == TOKEN_ASTERISK ||
+                            node.action == TOKEN_BOOLEAN_AND || node.action == TOKEN_BOOLEAN_OR ||
+                            node.action == TOKEN_EQUAL || node.action == TOKEN_NOT_EQUAL;
+            if( commutes && [left compare:right] == NSOrderedDescending ) {
+                NSString * swap = left;
+                left = right;
+                right = swap;
+            }
+            return [NSString stringWithFormat:@"(%c%d %@ %@)",
+                    node.nodeType == LANGUAGE_DIADIC ? 'd' : 'r', node.action, left, right];
+        }
+
+        default:
+            return nil;
+    }
+}
+
+/**
+ Name a version of a variable.
+ */
+static NSString * versionKey( TCOptimizerVariable * variable )
+{
+    return [NSString stringWithFormat:@"v%d#%ld", variable.number, variable.version];
+}
+
+#pragma mark - Optimizer
+
+@implementation TCOptimizer
+
+{
+    /** Names used in some function without being declared there */
+    NSMutableSet * _freeNames;
+
+    /** Set while the free names are being collected */
+    BOOL _collecting;
+
+    /** The variables of the function being optimized, and the variable
+        each REFERENCE, ADDRESS, ARRAY and NAME node refers to */
+    NSMutableArray * _variables;
+    NSMapTable * _uses;
+
+    /** The scopes of the names being resolved, innermost last */
+    NSMutableArray * _scopes;
+
+    /** The body of the function being optimized */
+    TCSyntaxNode * _body;
+
+    /** The declarations of temporaries made by a pass, to be added to the
+        start of the body when the pass is done */
+    NSMutableArray * _temporaries;
+    long _temporaryCount;
+
+    /** The clock versions of variables are taken from */
+    long _clock;
+
+    /** While hoisting from a loop: the variables the loop writes, the
+        temporary made for each expression hoisted, and the assignments
+        to put before the loop */
+    NSHashTable * _variant;
+    NSMutableDictionary * _hoisted;
+    NSMutableArray * _preheader;
+
+    /** While numbering a statement sequence: the variable holding each
+        named value, the copies held in variables, the places each value
+        is computed, the stores not yet read, and the stores found dead */
+    NSMutableDictionary * _available;
+    NSMapTable * _copies;
+    NSMutableDictionary * _occurrences;
+    NSMapTable * _pending;
+    NSMutableArray * _removed;
+
+    /** Nodes removed from the tree while numbering */
+    NSHashTable * _dead;
+
+    /** While removing dead stores: the variables that are never read */
+    NSHashTable * _deadVariables;
+}
+
+-(instancetype) initWithModule:(TCSyntaxNode *)tree
+{
+    if(( self = [super init])) {
+
+        // A name a function uses without declaring it could be any
+        // function's local, so first find every such name in the module.
+
+        _freeNames = [NSMutableSet set];
+        _collecting = YES;
+        if( tree.nodeType == LANGUAGE_MODULE ) {
+            for( TCSyntaxNode * entry in tree.subNodes )
+                if( entry.nodeType == LANGUAGE_ENTRYPOINT )
+                    [self resolve:entry];
+        }
+        _collecting = NO;
+    }
+    return self;
+}
+
+-(void) optimizeFunction:(TCSyntaxNode *)entry
+{
+    // The runtime entry point only declares the globals.  Each pass changes
+    // the tree, so the names are resolved again before the next.
+
+    TCSyntaxNode * body = entry.subNodes.lastObject;
+    if( entry.nodeType != LANGUAGE_ENTRYPOINT || [entry.spelling isEqualToString:RUNTIME_ENTRYPOINT] )
+        return;
+    if( entry.subNodes.count < 2 || body.nodeType != LANGUAGE_BLOCK )
+        return;
+
+    [self resolve:entry];
+    [self pruneBlock:_body];
+
+    [self resolve:entry];
+    [self hoistLoopsIn:_body];
+    [self declareTemporaries];
+
+    [self resolve:entry];
+    _dead = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    [self numberSequence:_body];
+    _dead = nil;
+    [self declareTemporaries];
+
+    // Removing a store can leave the variables it read unread in turn.
+
+    for( int pass = 0; pass < TCOPTIMIZER_PASSES; pass++ ) {
+        [self resolve:entry];
+        if( ![self removeDeadStores] )
+            break;
+    }
+    [self resolve:entry];
+    [self removeUnusedDeclarations];
+}
+
+#pragma mark - Names
+
+/**
+ Find the variable each name in a function refers to, and count how each
+ is used.
+ */
+-(void) resolve:(TCSyntaxNode*) entry
+{
+    _variables = [NSMutableArray array];
+    _uses = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                  valueOptions:NSPointerFunctionsStrongMemory];
+    _scopes = [NSMutableArray arrayWithObject:[NSMutableDictionary dictionary]];
+    _body = entry.subNodes.lastObject;
+
+    // The parameters are declared in the scope of the body.
+
+    for( NSUInteger ix = 1; ix + 1 < entry.subNodes.count; ix++ ) {
+        TCSyntaxNode * parameters = entry.subNodes[ix];
+        if( parameters.nodeType != LANGUAGE_DECLARE )
+            continue;
+        for( TCSyntaxNode * name in parameters.subNodes )
+            [self declare:name in:parameters block:nil].parameter = YES;
+    }
+    if( _body.nodeType == LANGUAGE_BLOCK ) {
+        for( TCSyntaxNode * statement in _body.subNodes )
+            [self resolve:statement parent:_body updating:nil];
+    }
+    _scopes = nil;
+
+    for( TCOptimizerVariable * variable in _variables )
+        if( [_freeNames containsObject:variable.name] )
+            variable.tracked = NO;
+}
+
+/**
+ Resolve the names in a tree.
+ @param node the tree
+ @param parent the node the tree is a subnode of
+ @param updating the variable being assigned by the expression the tree
+ is part of; reading it there is not counted as a read
+ */
+-(void) resolve:(TCSyntaxNode*) node parent:(TCSyntaxNode*) parent updating:(TCOptimizerVariable*) updating
+{
+    switch( node.nodeType ) {
+        case LANGUAGE_BLOCK:
+            [_scopes addObject:[NSMutableDictionary dictionary]];
+            for( TCSyntaxNode * sub in node.subNodes )
+                [self resolve:sub parent:node updating:updating];
+            [_scopes removeLastObject];
+            return;
+
+        case LANGUAGE_DECLARE:
+            for( TCSyntaxNode * name in node.subNodes ) {
+                for( TCSyntaxNode * sub in name.subNodes )
+                    [self resolve:sub parent:name updating:updating];
+                [self declare:name in:node block:parent];
+            }
+            return;
+
+        case LANGUAGE_ASSIGNMENT:
+        {
+            TCSyntaxNode * target = node.subNodes[0];
+            TCOptimizerVariable * variable = nil;
+            if( target.nodeType == LANGUAGE_ADDRESS && target.spelling && target.subNodes.count == 0 )
+                variable = [self lookup:target];
+            else
+                [self resolve:target parent:node updating:updating];
+
+            for( NSUInteger ix = 1; ix < node.subNodes.count; ix++ )
+                [self resolve:node.subNodes[ix] parent:node updating:variable];
+
+            // A store whose value must still be computed when the store is
+            // removed still needs the variable's old value.
+
+            if( variable && node.subNodes.count > 1 && ![self removable:node.subNodes[1]] &&
+                [self tree:node.subNodes[1] reads:variable] )
+                variable.reads++;
+            return;
+        }
+
+        case LANGUAGE_REFERENCE:
+        {
+            TCOptimizerVariable * variable = [self lookup:node];
+            if( variable && variable != updating )
+                variable.reads++;
+            break;
+        }
+
+        case LANGUAGE_ADDRESS:
+        case LANGUAGE_ARRAY:
+            [self lookup:node].tracked = NO;
+            break;
+
+        default:
+            break;
+    }
+    for( TCSyntaxNode * sub in node.subNodes )
+        [self resolve:sub parent:node updating:updating];
+}
+
+/**
+ Declare a variable in the innermost scope.
+ */
+-(TCOptimizerVariable*) declare:(TCSyntaxNode*) name in:(TCSyntaxNode*) declare block:(TCSyntaxNode*) block
+{
+    TCOptimizerVariable * variable = [[TCOptimizerVariable alloc]init];
+    variable.name = name.spelling;
+    variable.type = name.action;
+    variable.tracked = isArithmetic(name.action) && name.dimensions == nil;
+    variable.number = (int) _variables.count;
+    variable.declaration = name;
+    variable.declare = declare;
+    variable.block = block.nodeType == LANGUAGE_BLOCK ? block : nil;
+    [_variables addObject:variable];
+
+    if( name.spelling ) {
+        ((NSMutableDictionary*) _scopes.lastObject)[name.spelling] = variable;
+        [_uses setObject:variable forKey:name];
+    }
+    return variable;
+}
+
+/**
+ Find the variable a node names, innermost scope first.
+ @return the variable, or nil if the name is not declared in the function
+ */
+-(TCOptimizerVariable*) lookup:(TCSyntaxNode*) node
+{
+    if( node.spelling == nil )
+        return nil;
+    for( NSInteger ix = (NSInteger) _scopes.count - 1; ix >= 0; ix-- ) {
+        TCOptimizerVariable * variable = _scopes[ix][node.spelling];
+        if( variable ) {
+            variable.uses++;
+            [_uses setObject:variable forKey:node];
+            return variable;
+        }
+    }
+    if( _collecting )
+        [_freeNames addObject:node.spelling];
+    return nil;
+}
+
+/**
+ Get the variable a node refers to.
+ */
+-(TCOptimizerVariable*) variableAt:(TCSyntaxNode*) node
+{
+    return [_uses objectForKey:node];
+}
+
+/**
+ Does a tree read the value of a variable?
+ */
+-(BOOL) tree:(TCSyntaxNode*) node reads:(TCOptimizerVariable*) variable
+{
+    if( node.nodeType == LANGUAGE_REFERENCE && [self variableAt:node] == variable )
+        return YES;
+    for( TCSyntaxNode * sub in node.subNodes )
+        if( [self tree:sub reads:variable] )
+            return YES;
+    return NO;
+}
+
+/**
+ Work out the type of an expression's value.
+ @return the type, or TCVALUE_UNDEFINED if it is not one the optimizer
+ can track
+ */
+-(int) typeOf:(TCSyntaxNode*) node
+{
+    switch( node.nodeType ) {
+        case LANGUAGE_SCALAR:
+            switch( node.action ) {
+                case TOKEN_INTEGER:
+                    return TCVALUE_INT;
+                case TOKEN_DOUBLE:
+                    return TCVALUE_DOUBLE;
+                case TOKEN_FLOAT:
+                    return TCVALUE_FLOAT;
+            }
+            return TCVALUE_UNDEFINED;
+
+        case LANGUAGE_REFERENCE:
+        {
+            TCOptimizerVariable * variable = [self variableAt:node];
+            return variable.tracked && node.subNodes.count == 0 ? variable.type : TCVALUE_UNDEFINED;
+        }
+
+        case LANGUAGE_EXPRESSION:
+            return node.subNodes.count == 1 ? [self typeOf:node.subNodes[0]] : TCVALUE_UNDEFINED;
+
+        case LANGUAGE_MONADIC:
+            if( node.subNodes.count != 1 )
+                return TCVALUE_UNDEFINED;
+            return operatorType(node, [self typeOf:node.subNodes[0]], TCVALUE_INT);
+
+        case LANGUAGE_CAST:
+            if( node.subNodes.count != 2 )
+                return TCVALUE_UNDEFINED;
+            return operatorType(node, [self typeOf:node.subNodes[1]], TCVALUE_INT);
+
+        case LANGUAGE_DIADIC:
+        case LANGUAGE_RELATION:
+            if( node.subNodes.count != 2 )
+                return TCVALUE_UNDEFINED;
+            return operatorType(node, [self typeOf:node.subNodes[0]], [self typeOf:node.subNodes[1]]);
+
+        default:
+            return TCVALUE_UNDEFINED;
+    }
+}
+
+/**
+ Can an expression be left unevaluated without changing what the program
+ does?  It must have no effect and be unable to fail.
+ */
+-(BOOL) removable:(TCSyntaxNode*) node
+{
+    NSUInteger first = node.nodeType == LANGUAGE_CAST ? 1 : 0;
+    switch( node.nodeType ) {
+        case LANGUAGE_SCALAR:
+            return YES;
+
+        case LANGUAGE_REFERENCE:
+            return node.subNodes.count == 0 && [self variableAt:node] != nil;
+
+        case LANGUAGE_EXPRESSION:
+            break;
+
+        case LANGUAGE_DIADIC:
+            if( node.action == TOKEN_DIVIDE || node.action == TOKEN_PERCENT )
+                return NO;
+            if( [self typeOf:node] == TCVALUE_UNDEFINED )
+                return NO;
+            break;
+
+        case LANGUAGE_CAST:
+        case LANGUAGE_RELATION:
+        case LANGUAGE_MONADIC:
+            if( [self typeOf:node] == TCVALUE_UNDEFINED )
+                return NO;
+            break;
+
+        default:
+            return NO;
+    }
+    for( NSUInteger ix = first; ix < node.subNodes.count; ix++ )
+        if( ![self removable:node.subNodes[ix]] )
+            return NO;
+    return YES;
+}
+
+#pragma mark - Temporaries
+
+/**
+ Make a temporary variable.  Its declaration is added to the start of the
+ function body when the pass is done.
+ */
+-(TCOptimizerVariable*) temporary:(int) type like:(TCSyntaxNode*) like
+{
+    TCSyntaxNode * declaration = nodeLike(LANGUAGE_NAME, like);
+    declaration.spelling = [NSString stringWithFormat:@".t%ld", ++_temporaryCount];
+    declaration.action = type;
+
+    TCSyntaxNode * declare = nodeLike(LANGUAGE_DECLARE, like);
+    declare.action = type;
+    [declare addNode:declaration];
+    if( _temporaries == nil )
+        _temporaries = [NSMutableArray array];
+    [_temporaries addObject:declare];
+
+    TCOptimizerVariable * variable = [[TCOptimizerVariable alloc]init];
+    variable.name = declaration.spelling;
+    variable.type = type;
+    variable.tracked = YES;
+    variable.number = (int) _variables.count;
+    variable.version = ++_clock;
+    variable.declaration = declaration;
+    variable.declare = declare;
+    variable.block = _body;
+    [_variables addObject:variable];
+    [_uses setObject:variable forKey:declaration];
+    return variable;
+}
+
+-(void) declareTemporaries
+{
+    for( TCSyntaxNode * declare in _temporaries.reverseObjectEnumerator )
+        [_body.subNodes insertObject:declare atIndex:0];
+    _temporaries = nil;
+}
+
+/**
+ Make a node reading a variable, in the place of another node.
+ */
+-(TCSyntaxNode*) referenceTo:(TCOptimizerVariable*) variable like:(TCSyntaxNode*) like
+{
+    TCSyntaxNode * node = nodeLike(LANGUAGE_REFERENCE, like);
+    node.spelling = variable.name;
+    [_uses setObject:variable forKey:node];
+    return node;
+}
+
+/**
+ Make a node storing a value in a variable.
+ */
+-(TCSyntaxNode*) assignmentTo:(TCOptimizerVariable*) variable of:(TCSyntaxNode*) value
+{
+    TCSyntaxNode * target = nodeLike(LANGUAGE_ADDRESS, value);
+    target.spelling = variable.name;
+    [_uses setObject:variable forKey:target];
+
+    TCSyntaxNode * assignment = nodeLike(LANGUAGE_ASSIGNMENT, value);
+    [assignment addNode:target];
+    [assignment addNode:value];
+    return assignment;
+}
+
+#pragma mark - Dead code
+
+/**
+ Remove the statements of a block that cannot be reached or have no
+ effect, and simplify the rest.
+ */
+-(void) pruneBlock:(TCSyntaxNode*) block
+{
+    NSMutableArray * statements = [NSMutableArray array];
+    for( NSUInteger ix = 0; ix < block.subNodes.count; ix++ ) {
+        TCSyntaxNode * statement = [self prune:block.subNodes[ix]];
+        if( statement == nil )
+            continue;
+        [statements addObject:statement];
+        if( isJump(statement)) {
+            _deadCodeCount += block.subNodes.count - ix - 1;
+            break;
+        }
+    }
+    block.subNodes = statements;
+}
+
+/**
+ Simplify a statement.
+ @return the statement to run in its place, or nil if nothing need run
+ */
+-(TCSyntaxNode*) prune:(TCSyntaxNode*) statement
+{
+    long value = 0;
+    switch( statement.nodeType ) {
+        case LANGUAGE_BLOCK:
+            [self pruneBlock:statement];
+            return statement;
+
+        case LANGUAGE_IF:
+            if( integerConstant(statement.subNodes[0], &value)) {
+                _deadCodeCount++;
+                if( value )
+                    return [self prune:statement.subNodes[1]];
+                return statement.subNodes.count > 2 ? [self prune:statement.subNodes[2]] : nil;
+            }
+            for( NSUInteger ix = 1; ix < statement.subNodes.count; ix++ )
+                statement.subNodes[ix] = [self pruneBody:statement.subNodes[ix]];
+            return statement;
+
+        case LANGUAGE_WHILE:
+            if( integerConstant(statement.subNodes[0], &value) && value == 0 ) {
+                _deadCodeCount++;
+                return nil;
+            }
+            statement.subNodes[1] = [self pruneBody:statement.subNodes[1]];
+            return statement;
+
+        case LANGUAGE_FOR:
+            if( integerConstant(statement.subNodes[1], &value) && value == 0 ) {
+                _deadCodeCount++;
+                return [self prune:statement.subNodes[0]];
+            }
+            statement.subNodes[0] = [self pruneBody:statement.subNodes[0]];
+            statement.subNodes[2] = [self pruneBody:statement.subNodes[2]];
+            statement.subNodes[3] = [self pruneBody:statement.subNodes[3]];
+            return statement;
+
+        case LANGUAGE_EXPRESSION:
+        case LANGUAGE_ASSIGNMENT:
+        {
+            // What is left of an expression statement may be an expression
+            // the statement executor does not run on its own.
+
+            TCSyntaxNode * kept = [self discard:statement];
+            if( kept == nil || kept.nodeType == LANGUAGE_EXPRESSION || kept.nodeType == LANGUAGE_ASSIGNMENT )
+                return kept;
+            TCSyntaxNode * wrapper = nodeLike(LANGUAGE_EXPRESSION, kept);
+            [wrapper addNode:kept];
+            return wrapper;
+        }
+
+        default:
+            return statement;
+    }
+}
+
+/**
+ Simplify a statement that must stay in its place, such as the body of a
+ loop, using an empty expression if nothing need run.
+ */
+-(TCSyntaxNode*) pruneBody:(TCSyntaxNode*) statement
+{
+    TCSyntaxNode * pruned = [self prune:statement];
+    return pruned ? pruned : nodeLike(LANGUAGE_EXPRESSION, statement);
+}
+
+/**
+ Simplify an expression whose value is not used.  An assignment to a
+ variable that is never read is dropped, keeping any part of its value
+ that has an effect.
+ @return what must still be evaluated, or nil if nothing need be
+ */
+-(TCSyntaxNode*) discard:(TCSyntaxNode*) node
+{
+    if( [self removable:node] ) {
+        _deadCodeCount++;
+        return nil;
+    }
+    switch( node.nodeType ) {
+        case LANGUAGE_EXPRESSION:
+        {
+            NSMutableArray * kept = [NSMutableArray array];
+            for( TCSyntaxNode * sub in node.subNodes ) {
+                TCSyntaxNode * result = [self discard:sub];
+                if( result )
+                    [kept addObject:result];
+            }
+            if( kept.count == 0 )
+                return nil;
+            node.subNodes = kept;
+            return node;
+        }
+
+        case LANGUAGE_ASSIGNMENT:
+        {
+            TCOptimizerVariable * variable = [self variableAt:node.subNodes[0]];
+            if( variable == nil || ![_deadVariables containsObject:variable] )
+                return node;
+            _deadStoreCount++;
+            return [self discard:node.subNodes[1]];
+        }
+
+        default:
+            return node;
+    }
+}
+
+/**
+ Remove every store to a tracked variable that is never read.
+ @return YES if any store was removed
+ */
+-(BOOL) removeDeadStores
+{
+    _deadVariables = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for( TCOptimizerVariable * variable in _variables )
+        if( variable.tracked && variable.reads == 0 )
+            [_deadVariables addObject:variable];
+
+    long before = _deadStoreCount;
+    if( _deadVariables.count > 0 )
+        [self pruneBlock:_body];
+    _deadVariables = nil;
+    return _deadStoreCount != before;
+}
+
+/**
+ Remove the declarations of variables that are no longer used.  One that
+ another function could see, or whose declaration allocates storage, is
+ kept.
+ */
+-(void) removeUnusedDeclarations
+{
+    for( TCOptimizerVariable * variable in _variables ) {
+        if( variable.parameter || variable.uses > 0 || variable.block == nil )
+            continue;
+        if( variable.declaration.subNodes.count > 0 || [_freeNames containsObject:variable.name] )
+            continue;
+        [variable.declare.subNodes removeObjectIdenticalTo:variable.declaration];
+        if( variable.declare.subNodes.count == 0 )
+            [variable.block.subNodes removeObjectIdenticalTo:variable.declare];
+        _deadStoreCount++;
+    }
+}
+
+#pragma mark - Loop-invariant code motion
+
+/**
+ Hoist the invariant expressions out of each loop in a tree.  Inner loops
+ are done first, so an expression can move out through several loops.
+ Only a loop that is a statement of a block has a place to put them.
+ */
+-(void) hoistLoopsIn:(TCSyntaxNode*) node
+{
+    for( NSUInteger ix = 0; ix < node.subNodes.count; ix++ ) {
+        TCSyntaxNode * statement = node.subNodes[ix];
+        [self hoistLoopsIn:statement];
+        if( node.nodeType != LANGUAGE_BLOCK )
+            continue;
+        if( statement.nodeType != LANGUAGE_FOR && statement.nodeType != LANGUAGE_WHILE )
+            continue;
+
+        for( TCSyntaxNode * assignment in [self hoistInvariants:statement] )
+            [node.subNodes insertObject:assignment atIndex:ix++];
+    }
+}
+
+/**
+ Replace the invariant expressions of a loop with temporaries.
+ @return the assignments of the temporaries, to run before the loop
+ */
+-(NSArray*) hoistInvariants:(TCSyntaxNode*) loop
+{
+    _variant = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    _hoisted = [NSMutableDictionary dictionary];
+    _preheader = [NSMutableArray array];
+    [self collectWrites:loop];
+
+    // The initializer of a FOR runs once anyway.  The condition can itself
+    // be hoisted; any other part that is invariant is a statement with no
+    // effect.
+
+    NSUInteger first = loop.nodeType == LANGUAGE_FOR ? 1 : 0;
+    for( NSUInteger ix = first; ix < loop.subNodes.count; ix++ ) {
+        TCSyntaxNode * part = loop.subNodes[ix];
+        if( [self invariant:part parent:loop index:ix] && ix == first && [self worthHoisting:part] )
+            [self hoist:part parent:loop index:ix];
+    }
+
+    NSArray * preheader = _preheader;
+    _variant = nil;
+    _hoisted = nil;
+    _preheader = nil;
+    return preheader;
+}
+
+/**
+ Collect the variables a tree declares or assigns.
+ */
+-(void) collectWrites:(TCSyntaxNode*) node
+{
+    TCOptimizerVariable * variable = nil;
+    if( node.nodeType == LANGUAGE_NAME )
+        variable = [self variableAt:node];
+    else if( node.nodeType == LANGUAGE_ASSIGNMENT )
+        variable = [self variableAt:node.subNodes[0]];
+    if( variable )
+        [_variant addObject:variable];
+
+    for( TCSyntaxNode * sub in node.subNodes )
+        [self collectWrites:sub];
+}
+
+/**
+ See if a tree has the same value on every trip around the loop, hoisting
+ the largest invariant parts of it if it does not.
+ @return YES if the whole tree is invariant, and can be hoisted by the
+ caller
+ */
+-(BOOL) invariant:(TCSyntaxNode*) node parent:(TCSyntaxNode*) parent index:(NSUInteger) index
+{
+    BOOL movable = NO;
+    NSUInteger first = node.nodeType == LANGUAGE_CAST ? 1 : 0;
+    switch( node.nodeType ) {
+        case LANGUAGE_SCALAR:
+            return [self typeOf:node] != TCVALUE_UNDEFINED;
+
+        case LANGUAGE_REFERENCE:
+        {
+            TCOptimizerVariable * variable = [self variableAt:node];
+            return variable.tracked && node.subNodes.count == 0 && ![_variant containsObject:variable];
+        }
+
+        case LANGUAGE_DIADIC:
+            movable = node.action != TOKEN_DIVIDE && node.action != TOKEN_PERCENT;
+            break;
+
+        case LANGUAGE_CAST:
+        case LANGUAGE_RELATION:
+        case LANGUAGE_MONADIC:
+            movable = YES;
+            break;
+
+        case LANGUAGE_EXPRESSION:
+            movable = node.subNodes.count == 1;
+            break;
+
+        default:
+            break;
+    }
+
+    NSUInteger count = node.subNodes.count;
+    BOOL invariants[count + 1];
+    BOOL all = YES;
+    for( NSUInteger ix = first; ix < count; ix++ ) {
+        invariants[ix] = [self invariant:node.subNodes[ix] parent:node index:ix];
+        all = all && invariants[ix];
+    }
+    if( movable && all && [self typeOf:node] != TCVALUE_UNDEFINED )
+        return YES;
+
+    for( NSUInteger ix = first; ix < count; ix++ )
+        if( invariants[ix] && [self worthHoisting:node.subNodes[ix]] )
+            [self hoist:node.subNodes[ix] parent:node index:ix];
+    return NO;
+}
+
+/**
+ Is an invariant expression worth a temporary?  A constant, a variable or
+ an operator on constants alone is not.
+ */
+-(BOOL) worthHoisting:(TCSyntaxNode*) node
+{
+    node = unwrap(node);
+    return isOperator(node) && [self containsReference:node];
+}
+
+-(BOOL) containsReference:(TCSyntaxNode*) node
+{
+    if( node.nodeType == LANGUAGE_REFERENCE )
+        return YES;
+    for( TCSyntaxNode * sub in node.subNodes )
+        if( [self containsReference:sub] )
+            return YES;
+    return NO;
+}
+
+/**
+ Move an invariant expression into a temporary assigned before the loop.
+ The same expression found twice in the loop shares the temporary.
+ */
+-(void) hoist:(TCSyntaxNode*) node parent:(TCSyntaxNode*) parent index:(NSUInteger) index
+{
+    NSString * shape = [self shapeOf:node];
+    TCOptimizerVariable * temporary = shape ? _hoisted[shape] : nil;
+    if( temporary == nil ) {
+        temporary = [self temporary:[self typeOf:node] like:node];
+        if( shape )
+            _hoisted[shape] = temporary;
+        [_preheader addObject:[self assignmentTo:temporary of:node]];
+        _hoistedCount++;
+    }
+    parent.subNodes[index] = [self referenceTo:temporary like:node];
+}
+
+/**
+ Name an invariant expression by its form.  None of the variables it uses
+ change in the loop, so two with the same form have the same value.
+ */
+-(NSString*) shapeOf:(TCSyntaxNode*) node
+{
+    switch( node.nodeType ) {
+        case LANGUAGE_SCALAR:
+            return [NSString stringWithFormat:@"%d:%@", node.action, node.spelling];
+
+        case LANGUAGE_REFERENCE:
+            return [NSString stringWithFormat:@"v%d", [self variableAt:node].number];
+
+        case LANGUAGE_EXPRESSION:
+            return [self shapeOf:node.subNodes[0]];
+
+        default:
+        {
+            NSUInteger first = node.nodeType == LANGUAGE_CAST ? 1 : 0;
+            NSString * left = node.subNodes.count > first ? [self shapeOf:node.subNodes[first]] : nil;
+            NSString * right = node.subNodes.count > first + 1 ? [self shapeOf:node.subNodes[first + 1]] : nil;
+            return operatorKey(node, left, right);
+        }
+    }
+}
+
+#pragma mark - Value numbering
+
+/**
+ Number the values computed by a sequence of statements.  What is known
+ about values only holds within the sequence; a nested sequence starts
+ with nothing known, as it may run any number of times.
+ */
+-(void) numberSequence:(TCSyntaxNode*) block
+{
+    NSMutableDictionary * available = _available;
+    NSMapTable * copies = _copies;
+    NSMutableDictionary * occurrences = _occurrences;
+    NSMapTable * pending = _pending;
+    NSMutableArray * removed = _removed;
+    [self beginSequence];
+
+    for( NSUInteger ix = 0; ix < block.subNodes.count; ix++ ) {
+        TCSyntaxNode * statement = block.subNodes[ix];
+        [self numberStatement:statement parent:block index:ix];
+        if( isJump(statement))
+            break;
+    }
+    for( TCSyntaxNode * statement in _removed ) {
+        [self markDead:statement];
+        [block.subNodes removeObjectIdenticalTo:statement];
+    }
+    [self commonTemporaries];
+
+    _available = available;
+    _copies = copies;
+    _occurrences = occurrences;
+    _pending = pending;
+    _removed = removed;
+}
+
+/**
+ Number a statement that is the body or a clause of another, as a
+ sequence of its own.
+ */
+-(void) numberNested:(TCSyntaxNode*) parent index:(NSUInteger) index
+{
+    TCSyntaxNode * statement = parent.subNodes[index];
+    if( statement.nodeType == LANGUAGE_BLOCK ) {
+        [self numberSequence:statement];
+        return;
+    }
+
+    NSMutableDictionary * available = _available;
+    NSMapTable * copies = _copies;
+    NSMutableDictionary * occurrences = _occurrences;
+    NSMapTable * pending = _pending;
+    NSMutableArray * removed = _removed;
+    [self beginSequence];
+
+    [self numberStatement:statement parent:parent index:index];
+    [self commonTemporaries];
+
+    _available = available;
+    _copies = copies;
+    _occurrences = occurrences;
+    _pending = pending;
+    _removed = removed;
+}
+
+-(void) beginSequence
+{
+    _available = [NSMutableDictionary dictionary];
+    _copies = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                    valueOptions:NSPointerFunctionsStrongMemory];
+    _occurrences = [NSMutableDictionary dictionary];
+    _pending = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                     valueOptions:NSPointerFunctionsStrongMemory];
+    _removed = [NSMutableArray array];
+}
+
+/**
+ Number the values of a statement.  A store to a variable is kept as
+ pending until the variable is read; a second store to it while the first
+ is pending makes the first dead.
+ */
+-(void) numberStatement:(TCSyntaxNode*) statement parent:(TCSyntaxNode*) parent index:(NSUInteger) index
+{
+    // A value stored before a compound statement can be read after a
+    // break or continue in it, somewhere this sequence does not see.
+
+    switch( statement.nodeType ) {
+        case LANGUAGE_IF:
+        case LANGUAGE_FOR:
+        case LANGUAGE_WHILE:
+        case LANGUAGE_BLOCK:
+            if( containsLoopJump(statement))
+                [_pending removeAllObjects];
+            else
+                [self forgetReadsIn:statement];
+            break;
+        default:
+            break;
+    }
+
+    switch( statement.nodeType ) {
+        case LANGUAGE_DECLARE:
+            [self forgetReadsIn:statement];
+            for( TCSyntaxNode * name in statement.subNodes )
+                [self forgetName:name.spelling];
+            return;
+
+        case LANGUAGE_ASSIGNMENT:
+        {
+            TCOptimizerVariable * variable = [self variableAt:statement.subNodes[0]];
+            [self number:statement parent:parent index:index];
+            if( !variable.tracked || parent.nodeType != LANGUAGE_BLOCK )
+                return;
+
+            TCSyntaxNode * previous = [_pending objectForKey:variable];
+            if( previous ) {
+                [_removed addObject:previous];
+                _deadStoreCount++;
+            }
+            if( [self removable:statement.subNodes[1]] )
+                [_pending setObject:statement forKey:variable];
+            else
+                [_pending removeObjectForKey:variable];
+            return;
+        }
+
+        case LANGUAGE_IF:
+            [self number:statement.subNodes[0] parent:statement index:0];
+            for( NSUInteger ix = 1; ix < statement.subNodes.count; ix++ )
+                [self numberNested:statement index:ix];
+            return;
+
+        case LANGUAGE_FOR:
+            [self numberStatement:statement.subNodes[0] parent:statement index:0];
+            for( NSUInteger ix = 1; ix < statement.subNodes.count; ix++ )
+                [self numberNested:statement index:ix];
+            return;
+
+        case LANGUAGE_WHILE:
+            for( NSUInteger ix = 0; ix < statement.subNodes.count; ix++ )
+                [self numberNested:statement index:ix];
+            return;
+
+        case LANGUAGE_BLOCK:
+            [self numberSequence:statement];
+            return;
+
+        default:
+            [self number:statement parent:parent index:index];
+            return;
+    }
+}
+
+/**
+ Number the value of an expression, replacing it with a variable that
+ already holds the value if there is one.
+ @param node the expression
+ @param parent the node it is a subnode of
+ @param index its place in the parent
+ @return the name of the value, or nil if it cannot be named
+ */
+-(NSString*) number:(TCSyntaxNode*) node parent:(TCSyntaxNode*) parent index:(NSUInteger) index
+{
+    switch( node.nodeType ) {
+        case LANGUAGE_SCALAR:
+            if( [self typeOf:node] == TCVALUE_UNDEFINED )
+                return nil;
+            return [NSString stringWithFormat:@"%d:%@", node.action, node.spelling];
+
+        case LANGUAGE_REFERENCE:
+        {
+            TCOptimizerVariable * variable = [self variableAt:node];
+            if( variable == nil || node.subNodes.count > 0 ) {
+                [self numberAll:node];
+                return nil;
+            }
+            [_pending removeObjectForKey:variable];
+            if( !variable.tracked )
+                return nil;
+
+            TCOptimizerValue * copy = [_copies objectForKey:variable];
+            if( copy && copy.version == variable.version && copy.sourceVersion == copy.source.version ) {
+                parent.subNodes[index] = [self referenceTo:copy.source like:node];
+                [_pending removeObjectForKey:copy.source];
+                _copyCount++;
+                variable = copy.source;
+            }
+            return versionKey(variable);
+        }
+
+        case LANGUAGE_ASSIGNMENT:
+        {
+            TCOptimizerVariable * variable = [self variableAt:node.subNodes[0]];
+            if( variable == nil )
+                [self numberAll:node.subNodes[0]];
+            NSString * key = [self number:node.subNodes[1] parent:node index:1];
+            if( !variable.tracked )
+                return nil;
+
+            variable.version = ++_clock;
+            [_copies removeObjectForKey:variable];
+
+            // Remember what the variable now holds, if its type does not
+            // change the value.
+
+            TCSyntaxNode * value = unwrap(node.subNodes[1]);
+            if( key && [self typeOf:value] == variable.type ) {
+                TCOptimizerValue * held = [[TCOptimizerValue alloc]init];
+                held.variable = variable;
+                held.version = variable.version;
+                if( value.nodeType == LANGUAGE_REFERENCE ) {
+                    held.source = [self variableAt:value];
+                    held.sourceVersion = held.source.version;
+                    if( held.source != variable )
+                        [_copies setObject:held forKey:variable];
+                }
+                else if( isOperator(value))
+                    _available[key] = held;
+            }
+            return versionKey(variable);
+        }
+
+        case LANGUAGE_EXPRESSION:
+        {
+            NSString * first = nil;
+            for( NSUInteger ix = 0; ix < node.subNodes.count; ix++ ) {
+                NSString * key = [self number:node.subNodes[ix] parent:node index:ix];
+                if( ix == 0 )
+                    first = key;
+            }
+            return first;
+        }
+
+        case LANGUAGE_DIADIC:
+        case LANGUAGE_RELATION:
+        case LANGUAGE_MONADIC:
+        case LANGUAGE_CAST:
+        {
+            NSUInteger first = node.nodeType == LANGUAGE_CAST ? 1 : 0;
+            NSString * keys[2] = { nil, nil };
+            BOOL complete = YES;
+            for( NSUInteger ix = first; ix < node.subNodes.count; ix++ ) {
+                NSString * key = [self number:node.subNodes[ix] parent:node index:ix];
+                if( ix - first < 2 )
+                    keys[ix - first] = key;
+                complete = complete && key != nil;
+            }
+            NSString * key = complete ? operatorKey(node, keys[0], keys[1]) : nil;
+            if( key == nil || [self typeOf:node] == TCVALUE_UNDEFINED )
+                return nil;
+
+            TCOptimizerValue * held = _available[key];
+            if( held && held.variable.version == held.version ) {
+                [self markDead:node];
+                parent.subNodes[index] = [self referenceTo:held.variable like:node];
+                [_pending removeObjectForKey:held.variable];
+                _commonCount++;
+                return key;
+            }
+
+            TCOptimizerSite * site = [[TCOptimizerSite alloc]init];
+            site.node = node;
+            site.parent = parent;
+            site.index = index;
+            site.size = nodeCount(node);
+            NSMutableArray * sites = _occurrences[key];
+            if( sites == nil )
+                _occurrences[key] = sites = [NSMutableArray array];
+            [sites addObject:site];
+            return key;
+        }
+
+        default:
+            [self numberAll:node];
+            return nil;
+    }
+}
+
+-(void) numberAll:(TCSyntaxNode*) node
+{
+    for( NSUInteger ix = 0; ix < node.subNodes.count; ix++ )
+        [self number:node.subNodes[ix] parent:node index:ix];
+}
+
+/**
+ Compute each value found more than once in the sequence into a
+ temporary the first time, and read the temporary after that.  The
+ largest are done first, as they contain the smaller.
+ */
+-(void) commonTemporaries
+{
+    NSArray * keys = [_occurrences keysSortedByValueUsingComparator:^NSComparisonResult(NSArray * a, NSArray * b) {
+        long left = ((TCOptimizerSite*) a[0]).size;
+        long right = ((TCOptimizerSite*) b[0]).size;
+        return left > right ? NSOrderedAscending : left < right ? NSOrderedDescending : NSOrderedSame;
+    }];
+
+    for( NSString * key in keys ) {
+        NSMutableArray * sites = [NSMutableArray array];
+        for( TCOptimizerSite * site in _occurrences[key] )
+            if( ![_dead containsObject:site.node] && site.parent.subNodes[site.index] == site.node )
+                [sites addObject:site];
+        if( sites.count < 2 )
+            continue;
+
+        TCOptimizerSite * first = sites[0];
+        if( (long)(sites.count - 1) * (first.size - 1) <= TCOPTIMIZER_TEMPORARY_COST )
+            continue;
+        int type = [self typeOf:first.node];
+        if( type == TCVALUE_UNDEFINED )
+            continue;
+
+        TCOptimizerVariable * temporary = [self temporary:type like:first.node];
+        first.parent.subNodes[first.index] = [self assignmentTo:temporary of:first.node];
+        for( NSUInteger ix = 1; ix < sites.count; ix++ ) {
+            TCOptimizerSite * site = sites[ix];
+            [self markDead:site.node];
+            site.parent.subNodes[site.index] = [self referenceTo:temporary like:site.node];
+        }
+        _commonCount += sites.count - 1;
+    }
+}
+
+/**
+ Note that a tree has been taken out of the function.
+ */
+-(void) markDead:(TCSyntaxNode*) node
+{
+    [_dead addObject:node];
+    for( TCSyntaxNode * sub in node.subNodes )
+        [self markDead:sub];
+}
+
+/**
+ Note every variable a tree reads, so no store pending for it is removed.
+ */
+-(void) forgetReadsIn:(TCSyntaxNode*) node
+{
+    if( node.nodeType == LANGUAGE_REFERENCE ) {
+        TCOptimizerVariable * variable = [self variableAt:node];
+        if( variable )
+            [_pending removeObjectForKey:variable];
+    }
+    for( TCSyntaxNode * sub in node.subNodes )
+        [self forgetReadsIn:sub];
+}
+
+/**
+ Forget the values held in variables of a name, when a new variable of
+ that name is declared, as references to the name now mean the new one.
+ */
+-(void) forgetName:(NSString*) name
+{
+    for( NSString * key in _available.allKeys ) {
+        TCOptimizerValue * held = _available[key];
+        if( [held.variable.name isEqualToString:name] )
+            [_available removeObjectForKey:key];
+    }
+    for( TCOptimizerVariable * variable in [[_copies keyEnumerator] allObjects] ) {
+        TCOptimizerValue * copy = [_copies objectForKey:variable];
+        if( [variable.name isEqualToString:name] || [copy.source.name isEqualToString:name] )
+            [_copies removeObjectForKey:variable];
+    }
+}
+
+@end
@@ -0,0 +1,73 @@
+//
+//  TCParallelFor.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  Runs a TinyC function once for each index of a range, spread over a
+//  pool of worker threads.  The range is split evenly between the workers
+//  up front.  Each worker takes a chunk of indices at a time from the front
+//  of its own share, and when that is used up steals the back half of the
+//  largest share left, so a worker that draws slow indices does not hold up
+//  the rest.  Each worker is a TCThread, with its own automatic storage;
+//  all return before the run does.
+//
+//  The calls run in no particular order, and at the same time, so the
+//  function must follow these rules for the memory it writes:
+//
+//  - Its locals and parameters are its own.
+//  - A global, or a cell in dynamic storage, may be written by the call
+//    for one index only, such as out[i], and must not be read by a call
+//    for any other index.
+//  - Anything shared by calls for different indices, such as a total,
+//    must be updated with the atomic_ builtins.
+//  - malloc() and free() may be called; a block must only be freed by the
+//    call that allocated it.
+//
+//  The profilers and the trace ring are not fed from the workers.
+
+#import <Foundation/Foundation.h>
+#import "TCError.h"
+
+@class TCSyntaxNode;
+@class TCStorageManager;
+@class TCRuntimeSymbolTable;
+
+/** The number of chunks each worker's share is cut into, by default */
+#define TCPARALLEL_CHUNKS 8L
+
+@interface TCParallelFor : NSObject
+
+/** The number of worker threads */
+@property (readonly) int workers;
+
+/** The error that stopped the run, if any */
+@property (readonly) TCError * error;
+
+/**
+ Prepare to run a function over a range.
+ @param entry the ENTRYPOINT of the function, which takes the index
+ @param symbols the symbols the function can see
+ @param storage the runtime storage of the program
+ @param workers the number of worker threads, or 0 for one per processor
+ @return the runner
+ */
+-(instancetype) initWithEntry:(TCSyntaxNode*) entry
+                      symbols:(TCRuntimeSymbolTable*) symbols
+                      storage:(TCStorageManager*) storage
+                      workers:(int) workers;
+
+/**
+ Call the function for each index from start up to but not including
+ end, and wait for every call to return.  After a call fails, no more
+ are started, and the error property is set.
+ @param start the first index
+ @param end the index after the last
+ @param chunk the indices a worker takes at a time, or 0 to choose
+ @return YES if every call returned without an error
+ */
+-(BOOL) runFrom:(long) start to:(long) end chunk:(long) chunk;
+
+@end
@@ -0,0 +1,214 @@
+//
+//  TCParallelFor.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCParallelFor.h"
+#import "TCThread.h"
+#import "TCExecutionContext.h"
+#import "TCValue.h"
+#import <os/lock.h>
+
+/**
+ The indices a worker has still to run.  Its owner takes from next, and
+ thieves take from end.
+ */
+typedef struct {
+    os_unfair_lock lock;
+    long next;
+    long end;
+} TCParallelShare;
+
+@implementation TCParallelFor
+
+{
+    TCSyntaxNode * _entry;
+    TCRuntimeSymbolTable * _symbols;
+    TCStorageManager * _storage;
+
+    /** The share of each worker of the current run, and how many there are */
+    TCParallelShare * _shares;
+    int _count;
+
+    /** The indices a worker takes at a time */
+    long _chunk;
+
+    /** Set when a call fails, so no more are started */
+    int _stop;
+}
+
+-(instancetype) initWithEntry:(TCSyntaxNode *)entry
+                      symbols:(TCRuntimeSymbolTable *)symbols
+                      storage:(TCStorageManager *)storage
+                      workers:(int)workers
+{
+    if(( self = [super init])) {
+        if( workers < 1 )
+            workers = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+        _workers = workers;
+        _entry = entry;
+        _symbols = symbols;
+        _storage = storage;
+    }
+    return self;
+}
+
+/**
+ Take the next chunk from a worker's own share.
+ */
+-(BOOL) take:(int) worker from:(long*) low to:(long*) high
+{
+    TCParallelShare * share = &_shares[worker];
+    os_unfair_lock_lock(&share->lock);
+    BOOL found = share->next < share->end;
+    if( found ) {
+        *low = share->next;
+        *high = share->end - share->next > _chunk ? share->next + _chunk : share->end;
+        share->next = *high;
+    }
+    os_unfair_lock_unlock(&share->lock);
+    return found;
+}
+
+/**
+ Move the back half of the largest other share to a worker's own, which
+ it has used up.  The sizes are read without the locks, so the victim is
+ only a good guess; another thief may get there first, in which case the
+ next largest is tried.
+ */
+-(BOOL) steal:(int) worker
+{
+    while( YES ) {
+        int victim = -1;
+        long most = 0L;
+        for( int ix = 0; ix < _count; ix++ ) {
+            long left = _shares[ix].end - _shares[ix].next;
+            if( ix != worker && left > most ) {
+                most = left;
+                victim = ix;
+            }
+        }
+        if( victim < 0 )
+            return NO;
+
+        TCParallelShare * share = &_shares[victim];
+        long low = 0L, high = 0L;
+        os_unfair_lock_lock(&share->lock);
+        long left = share->end - share->next;
+        if( left > 0 ) {
+            long taken = left > _chunk ? left / 2 : left;
+            high = share->end;
+            low = high - taken;
+            share->end = low;
+        }
+        os_unfair_lock_unlock(&share->lock);
+        if( high == low )
+            continue;
+
+        TCParallelShare * own = &_shares[worker];
+        os_unfair_lock_lock(&own->lock);
+        own->next = low;
+        own->end = high;
+        os_unfair_lock_unlock(&own->lock);
+        return YES;
+    }
+}
+
+/**
+ The work of one worker thread: call the function for its own indices,
+ then for those it can steal, until there are none left or a call fails.
+ */
+-(TCValue*) work:(int) worker inContext:(TCExecutionContext*) context
+{
+    long low = 0L, high = 0L;
+    while( !__atomic_load_n(&_stop, __ATOMIC_RELAXED) ) {
+        if( ![self take:worker from:&low to:&high] ) {
+            if( ![self steal:worker] )
+                break;
+            continue;
+        }
+        @autoreleasepool {
+            for( long ix = low; ix < high; ix++ ) {
+                [context execute:_entry
+                      entryPoint:nil
+                   withArguments:@[ [[TCValue alloc]initWithLong:ix] ]];
+                if( context.error ) {
+                    __atomic_store_n(&_stop, 1, __ATOMIC_RELAXED);
+                    break;
+                }
+            }
+        }
+    }
+    return nil;
+}
+
+-(BOOL) runFrom:(long)start to:(long)end chunk:(long)chunk
+{
+    _error = nil;
+    _stop = 0;
+    long count = 0L;
+    if( __builtin_sub_overflow(end, start, &count)) {
+        _error = [[TCError alloc]initWithCode:TCERROR_ARRAY_BOUNDS
+                                       atNode:nil
+                                 withArgument:[NSNumber numberWithLong:end]];
+        return NO;
+    }
+    if( count <= 0 )
+        return YES;
+
+    // No more workers than there are chunks to give them.
+
+    int workers = _workers;
+    if( chunk < 1 )
+        chunk = MAX(1L, count / (workers * TCPARALLEL_CHUNKS));
+    _chunk = chunk;
+    if( (count - 1) / chunk + 1 < workers )
+        workers = (int)((count - 1) / chunk + 1);
+
+    // The shares differ in size by at most one, with the first count %
+    // workers getting the extra index.  Written so that no product can
+    // overflow, however wide the range.
+
+    TCParallelShare shares[workers];
+    _shares = shares;
+    long size = count / workers;
+    long extra = count % workers;
+    for( int ix = 0; ix < workers; ix++ ) {
+        shares[ix].lock = OS_UNFAIR_LOCK_INIT;
+        shares[ix].next = start + size * ix + MIN(ix, extra);
+        shares[ix].end = start + size * (ix + 1) + MIN(ix + 1, extra);
+    }
+
+    // The share of a worker that could not be started is left for the
+    // others to steal.
+
+    _count = workers;
+    NSMutableArray * threads = [NSMutableArray array];
+    for( int ix = 0; ix < workers; ix++ ) {
+        TCThread * thread = [[TCThread alloc]initWithSymbols:_symbols
+                                                     storage:_storage
+                                                        body:^TCValue*(TCExecutionContext * context) {
+                                                            return [self work:ix inContext:context];
+                                                        }];
+        if( thread )
+            [threads addObject:thread];
+    }
+    if( threads.count == 0 )
+        _error = [[TCError alloc]initWithCode:TCERROR_THREAD
+                                       atNode:nil
+                                 withArgument:@"no storage for a worker stack"];
+
+    for( TCThread * thread in threads ) {
+        [thread join];
+        if( thread.error && _error == nil )
+            _error = thread.error;
+    }
+    _shares = NULL;
+    _count = 0;
+    return _error == nil;
+}
+
+@end
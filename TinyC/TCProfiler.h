@@ -0,0 +1,108 @@
+//
+//  TCProfiler.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Execution profiler used by the -dP option.  The interpreters tell the
+//  profiler about every node they execute and every function entry and
+//  exit.  Time is charged to whatever function and source line were
+//  current since the previous event (self time), and each function also
+//  accumulates the time from its entry to its exit (total time).  The
+//  call stack at each event is kept as a folded string, so the output can
+//  be fed straight to flamegraph tools.
+
+#import <Foundation/Foundation.h>
+
+@class TCSyntaxNode;
+@class TCLexicalScanner;
+@class TCProfiler;
+
+/** The profiler for the execution running on this thread, or nil if not profiling */
+extern __thread __unsafe_unretained TCProfiler * activeProfiler;
+
+@interface TCProfiler : NSObject
+
+{
+    /** The scanner used to map node positions to source lines */
+    TCLexicalScanner * _scanner;
+
+    /** Function name to index into the _functions array */
+    NSMutableDictionary * _functionIndex;
+
+    /** Array of per-function counter structures */
+    NSMutableData * _functions;
+
+    /** Array of per-line counter structures, indexed by line number */
+    NSMutableData * _lines;
+
+    /** Folded call stack to index into the _stackTime array */
+    NSMutableDictionary * _stackIndex;
+
+    /** Self time in nanoseconds for each folded call stack */
+    NSMutableData * _stackTime;
+
+    /** The active call stack; one frame structure per call */
+    NSMutableData * _frames;
+
+    /** The folded call stack string for each entry in _stackTime */
+    NSMutableArray * _stackKeys;
+
+    /** Index in _stackTime for the active call stack */
+    long _currentStack;
+
+    /** The source line that time is being charged to, or -1 */
+    long _currentLine;
+
+    /** The time of the previous event, in nanoseconds */
+    uint64_t _lastTick;
+
+    /** The time the profile was started, in nanoseconds */
+    uint64_t _startTick;
+}
+
+/** The total number of nodes executed */
+@property (readonly) long nodeCount;
+
+/**
+ Create a profiler for a compiled program.
+ @param scanner the scanner that holds the program's source and line map
+ @return a new profiler, with timing started
+ */
+-(instancetype) initWithScanner:(TCLexicalScanner*) scanner;
+
+/**
+ Record the execution of a node.  Nodes with a source position also
+ change the line that time is charged to.
+ @param node the node about to be executed
+ */
+-(void) node:(TCSyntaxNode*) node;
+
+/**
+ Record entry to a function.
+ @param name the name of the function
+ */
+-(void) enter:(NSString*) name;
+
+/**
+ Record the return from the most recently entered function.
+ */
+-(void) exit;
+
+/**
+ Write the sorted report of functions and source lines.
+ @param file where to write the report
+ @param limit the maximum number of lines to list
+ */
+-(void) report:(FILE*) file lines:(int) limit;
+
+/**
+ Write the folded call stacks, one per line, each followed by its self
+ time in microseconds.
+ @param path the name of the file to write
+ @return YES if the file was written
+ */
+-(BOOL) writeFoldedStacks:(NSString*) path;
+
+@end
@@ -0,0 +1,268 @@
+//
+//  TCProfiler.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCProfiler.h"
+#import "TCSyntaxNode.h"
+#import "TCLexicalScanner.h"
+#import <time.h>
+
+__thread __unsafe_unretained TCProfiler * activeProfiler = nil;
+
+/** Counters kept for each function */
+typedef struct {
+    long calls;
+    long nodes;
+    uint64_t selfTime;
+    uint64_t totalTime;
+    int depth;
+} TCProfileFunction;
+
+/** Counters kept for each source line */
+typedef struct {
+    long nodes;
+    uint64_t selfTime;
+} TCProfileLine;
+
+/** What must be restored when a function returns */
+typedef struct {
+    long function;
+    long stack;
+    long line;
+    uint64_t start;
+} TCProfileFrame;
+
+/**
+ Read the monotonic clock.
+ */
+static uint64_t profileClock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+@implementation TCProfiler
+
+#pragma mark - Initialization
+
+-(instancetype) initWithScanner:(TCLexicalScanner *)scanner
+{
+    if(( self = [super init])) {
+        _scanner = scanner;
+        _functionIndex = [NSMutableDictionary dictionary];
+        _functions = [NSMutableData data];
+        _lines = [NSMutableData data];
+        _stackIndex = [NSMutableDictionary dictionary];
+        _stackTime = [NSMutableData data];
+        _stackKeys = [NSMutableArray array];
+        _frames = [NSMutableData data];
+        _currentStack = -1L;
+        _currentLine = -1L;
+        _nodeCount = 0L;
+        _startTick = profileClock();
+        _lastTick = _startTick;
+    }
+    return self;
+}
+
+#pragma mark - Accumulation
+
+/**
+ Get the counters for the function at the top of the call stack, or NULL
+ if no function has been entered yet.
+ */
+-(TCProfileFunction*) currentFunction
+{
+    long depth = _frames.length / sizeof(TCProfileFrame);
+    if( depth == 0 )
+        return NULL;
+    TCProfileFrame * frame = (TCProfileFrame*) _frames.mutableBytes + (depth - 1);
+    return (TCProfileFunction*) _functions.mutableBytes + frame->function;
+}
+
+/**
+ Get the counters for a source line, growing the line table as needed.
+ */
+-(TCProfileLine*) line:(long) line
+{
+    long count = _lines.length / sizeof(TCProfileLine);
+    if( line >= count )
+        [_lines increaseLengthBy:(line - count + 1) * sizeof(TCProfileLine)];
+    return (TCProfileLine*) _lines.mutableBytes + line;
+}
+
+/**
+ Charge the time since the previous event to the current function, line,
+ and call stack.
+ @return the current time
+ */
+-(uint64_t) charge
+{
+    uint64_t now = profileClock();
+    uint64_t delta = now - _lastTick;
+    _lastTick = now;
+    
+    TCProfileFunction * function = [self currentFunction];
+    if( function )
+        function->selfTime += delta;
+    if( _currentLine >= 0 )
+        [self line:_currentLine]->selfTime += delta;
+    if( _currentStack >= 0 )
+        ((uint64_t*) _stackTime.mutableBytes)[_currentStack] += delta;
+    return now;
+}
+
+-(void) node:(TCSyntaxNode *)node
+{
+    [self charge];
+    _nodeCount++;
+    
+    if( node.position > 0 ) {
+        long line = [_scanner lineNumberAtPosition:node.position];
+        if( line >= 0 )
+            _currentLine = line;
+    }
+    
+    TCProfileFunction * function = [self currentFunction];
+    if( function )
+        function->nodes++;
+    if( _currentLine >= 0 )
+        [self line:_currentLine]->nodes++;
+}
+
+-(void) enter:(NSString *)name
+{
+    uint64_t now = [self charge];
+    
+    NSNumber * index = _functionIndex[name];
+    if( index == nil ) {
+        index = [NSNumber numberWithLong:_functions.length / sizeof(TCProfileFunction)];
+        _functionIndex[name] = index;
+        [_functions increaseLengthBy:sizeof(TCProfileFunction)];
+    }
+    
+    TCProfileFunction * function = (TCProfileFunction*) _functions.mutableBytes + index.longValue;
+    function->calls++;
+    function->depth++;
+    
+    TCProfileFrame frame;
+    frame.function = index.longValue;
+    frame.stack = _currentStack;
+    frame.line = _currentLine;
+    frame.start = now;
+    [_frames appendBytes:&frame length:sizeof(frame)];
+    
+    // The folded stack for this call is the caller's stack plus our name.
+    
+    NSString * key = (_currentStack < 0) ? name
+        : [NSString stringWithFormat:@"%@;%@", _stackKeys[_currentStack], name];
+    NSNumber * stack = _stackIndex[key];
+    if( stack == nil ) {
+        stack = [NSNumber numberWithLong:_stackKeys.count];
+        _stackIndex[key] = stack;
+        [_stackKeys addObject:key];
+        [_stackTime increaseLengthBy:sizeof(uint64_t)];
+    }
+    _currentStack = stack.longValue;
+}
+
+-(void) exit
+{
+    long depth = _frames.length / sizeof(TCProfileFrame);
+    if( depth == 0 )
+        return;
+    
+    uint64_t now = [self charge];
+    TCProfileFrame frame = ((TCProfileFrame*) _frames.mutableBytes)[depth - 1];
+    [_frames setLength:(depth - 1) * sizeof(TCProfileFrame)];
+    
+    // Total time only counts the outermost activation of a recursive
+    // function, so recursion does not count the same time twice.
+    
+    TCProfileFunction * function = (TCProfileFunction*) _functions.mutableBytes + frame.function;
+    if( --function->depth == 0 )
+        function->totalTime += now - frame.start;
+    
+    _currentStack = frame.stack;
+    _currentLine = frame.line;
+}
+
+#pragma mark - Output
+
+-(void) report:(FILE *)file lines:(int)limit
+{
+    [self charge];
+    double elapsed = (double)(_lastTick - _startTick) / 1.0e6;
+    
+    fprintf(file, "PROFILE: %ld nodes executed in %.3f ms\n\n", _nodeCount, elapsed);
+    
+    // Functions, by self time
+    
+    NSArray * names = [_functionIndex keysSortedByValueUsingComparator:^NSComparisonResult(NSNumber * a, NSNumber * b) {
+        uint64_t ta = ((TCProfileFunction*) self->_functions.bytes)[a.longValue].selfTime;
+        uint64_t tb = ((TCProfileFunction*) self->_functions.bytes)[b.longValue].selfTime;
+        return ta > tb ? NSOrderedAscending : (ta < tb ? NSOrderedDescending : NSOrderedSame);
+    }];
+    
+    fprintf(file, "%-24s %10s %12s %12s %12s %7s\n",
+            "function", "calls", "nodes", "self ms", "total ms", "self%");
+    for( NSString * name in names ) {
+        TCProfileFunction * f = (TCProfileFunction*) _functions.mutableBytes + [_functionIndex[name] longValue];
+        double selfTime = (double) f->selfTime / 1.0e6;
+        fprintf(file, "%-24s %10ld %12ld %12.3f %12.3f %6.1f%%\n",
+                [name UTF8String], f->calls, f->nodes, selfTime,
+                (double) f->totalTime / 1.0e6,
+                elapsed > 0 ? 100.0 * selfTime / elapsed : 0.0);
+    }
+    
+    // Source lines, by self time
+    
+    long lineCount = _lines.length / sizeof(TCProfileLine);
+    const TCProfileLine * lines = _lines.bytes;
+    NSMutableArray * order = [NSMutableArray array];
+    for( long ix = 0; ix < lineCount; ix++ )
+        if( lines[ix].nodes > 0 )
+            [order addObject:[NSNumber numberWithLong:ix]];
+    [order sortUsingComparator:^NSComparisonResult(NSNumber * a, NSNumber * b) {
+        uint64_t ta = lines[a.longValue].selfTime;
+        uint64_t tb = lines[b.longValue].selfTime;
+        return ta > tb ? NSOrderedAscending : (ta < tb ? NSOrderedDescending : NSOrderedSame);
+    }];
+    
+    fprintf(file, "\n%6s %12s %12s %7s  %s\n", "line", "nodes", "self ms", "self%", "source");
+    int listed = 0;
+    for( NSNumber * n in order ) {
+        if( listed++ >= limit )
+            break;
+        const TCProfileLine * l = &lines[n.longValue];
+        double selfTime = (double) l->selfTime / 1.0e6;
+        NSString * text = [[_scanner getLineAtLine:n.longValue]
+                           stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+        fprintf(file, "%6ld %12ld %12.3f %6.1f%%  %s\n",
+                n.longValue + 1, l->nodes, selfTime,
+                elapsed > 0 ? 100.0 * selfTime / elapsed : 0.0,
+                text ? [text UTF8String] : "");
+    }
+}
+
+-(BOOL) writeFoldedStacks:(NSString *)path
+{
+    FILE * file = fopen([path fileSystemRepresentation], "w");
+    if( file == NULL )
+        return NO;
+    
+    const uint64_t * times = _stackTime.bytes;
+    for( long ix = 0; ix < (long) _stackKeys.count; ix++ ) {
+        uint64_t micros = times[ix] / 1000ULL;
+        if( micros > 0 )
+            fprintf(file, "%s %llu\n", [_stackKeys[ix] UTF8String], (unsigned long long) micros);
+    }
+    return fclose(file) == 0;
+}
+
+@end
@@ -0,0 +1,116 @@
+//
+//  TCRandom.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Random number generator for TinyC programs.  Each TinyC object owns its
+//  own xoshiro256** generator, seeded at the start of every execution, so
+//  a run is reproducible from its seed and does not share state with the
+//  rest of the process.  split hands out a generator whose stream is 2^128
+//  values away from this one, for a resolved entry point or another
+//  execution that should not overlap it.
+
+#import <Foundation/Foundation.h>
+
+/**
+ The state of one generator.
+ */
+typedef struct {
+    uint64_t s[4];
+} TCRandomState;
+
+/** The generator of the execution running on this thread, or NULL if none is running */
+extern __thread TCRandomState * activeRandom;
+
+/** The generator used when no execution is running */
+extern __thread TCRandomState randomFallback;
+
+/**
+ Seed a generator.  The seed is spread over the state with splitmix64, so
+ nearby seeds give unrelated streams.
+ */
+void randomSeed(TCRandomState * state, uint64_t seed);
+
+/**
+ Get the generator the builtins should draw from.
+ */
+static inline TCRandomState * randomCurrent(void)
+{
+    return activeRandom ? activeRandom : &randomFallback;
+}
+
+/**
+ Get the next 64 random bits from a generator.
+ */
+static inline uint64_t randomNext(TCRandomState * state)
+{
+    uint64_t * s = state->s;
+    uint64_t x = s[1] * 5;
+    uint64_t result = ((x << 7) | (x >> 57)) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 45) | (s[3] >> 19);
+    return result;
+}
+
+/**
+ Get a random double in [0, 1), using the top 53 bits.
+ */
+static inline double randomDouble(TCRandomState * state)
+{
+    return (double)(randomNext(state) >> 11) * 0x1.0p-53;
+}
+
+@interface TCRandom : NSObject
+
+{
+    /** The state this generator owns */
+    TCRandomState _state;
+}
+
+/** The seed this generator was last seeded with */
+@property (readonly) unsigned long seed;
+
+/**
+ Create a generator.
+ @param seed the starting seed
+ @return a new generator
+ */
+-(instancetype) initWithSeed:(unsigned long) seed;
+
+/**
+ Start the generator over from a seed.
+ @param seed the new seed
+ */
+-(void) reseed:(unsigned long) seed;
+
+/**
+ Split off an independent stream.  The new generator takes the current
+ state, and this one jumps 2^128 values ahead, so neither will produce
+ the values of the other.  Streams can be split again as needed.
+ @return a new generator
+ */
+-(TCRandom*) split;
+
+/**
+ Get the state of this generator, for code that draws many values.
+ */
+-(TCRandomState*) state;
+
+/**
+ Make this the active generator, so the builtins draw from it.
+ */
+-(void) start;
+
+/**
+ Stop drawing from this generator, if it is the active one.
+ */
+-(void) stop;
+
+@end
@@ -0,0 +1,83 @@
+//
+//  TCRandom.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCRandom.h"
+
+__thread TCRandomState * activeRandom = NULL;
+
+__thread TCRandomState randomFallback = { { 0x9e3779b97f4a7c15UL, 0xbf58476d1ce4e5b9UL,
+                                            0x94d049bb133111ebUL, 0x2545f4914f6cdd1dUL } };
+
+void randomSeed(TCRandomState * state, uint64_t seed)
+{
+    for( int ix = 0; ix < 4; ix++ ) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15UL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9UL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebUL;
+        state->s[ix] = z ^ (z >> 31);
+    }
+}
+
+@implementation TCRandom
+
+-(instancetype) initWithSeed:(unsigned long)seed
+{
+    if(( self = [super init])) {
+        [self reseed:seed];
+    }
+    return self;
+}
+
+-(void) reseed:(unsigned long)seed
+{
+    _seed = seed;
+    randomSeed(&_state, seed);
+}
+
+-(TCRandom*) split
+{
+    TCRandom * stream = [[TCRandom alloc]initWithSeed:_seed];
+    stream->_state = _state;
+
+    // The xoshiro256 jump polynomial advances the state by 2^128 steps.
+
+    static const uint64_t jump[] = { 0x180ec6d33cfd0abaUL, 0xd5a61266f0c9392cUL,
+                                     0xa9582618e03fc9aaUL, 0x39abdc4529b1661cUL };
+    uint64_t s[4] = { 0, 0, 0, 0 };
+    for( int ix = 0; ix < 4; ix++ ) {
+        for( int b = 0; b < 64; b++ ) {
+            if( jump[ix] & (1UL << b) ) {
+                s[0] ^= _state.s[0];
+                s[1] ^= _state.s[1];
+                s[2] ^= _state.s[2];
+                s[3] ^= _state.s[3];
+            }
+            randomNext(&_state);
+        }
+    }
+    memcpy(_state.s, s, sizeof(s));
+    return stream;
+}
+
+-(TCRandomState*) state
+{
+    return &_state;
+}
+
+-(void) start
+{
+    activeRandom = &_state;
+}
+
+-(void) stop
+{
+    if( activeRandom == &_state )
+        activeRandom = NULL;
+}
+
+@end
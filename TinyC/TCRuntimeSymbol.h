@@ -10,9 +10,20 @@
 #import "TCValue.h"
 #import "TCStorageManager.h"
 
+/** The most dimensions a declared array can have */
+#define TCSYMBOL_MAX_DIMENSIONS 8
+
 
 @interface TCRuntimeSymbol : NSObject
 
+{
+    /** The extent of each dimension of a declared array */
+    long _extents[TCSYMBOL_MAX_DIMENSIONS];
+
+    /** The distance in bytes between elements of each dimension */
+    long _strides[TCSYMBOL_MAX_DIMENSIONS];
+}
+
 @property NSString * spelling;
 @property TCValueType type;
 @property int size;
@@ -21,7 +32,27 @@
 @property int scope;
 @property long address;
 
+/** The number of dimensions of a declared array, or zero for a pointer or scalar */
+@property (readonly) int rank;
+
+/** The address of the first element of a declared array, which cannot change */
+@property long arrayBase;
+
 -(void) setValue:(TCValue*)value storage:(TCStorageManager*) storage;
 
+/**
+ Describe the shape of a declared array, and calculate the row-major
+ stride of each dimension.
+ @param dimensions the extent of each dimension as an NSNumber, outermost first
+ @param size the size of each element in bytes
+ */
+-(void) setDimensions:(NSArray*) dimensions elementSize:(int) size;
+
+/** The extent of each dimension of a declared array */
+-(const long*) extents;
+
+/** The byte stride of each dimension of a declared array */
+-(const long*) strides;
+
 
 @end
@@ -38,12 +38,44 @@
 
 -(void) setValue:(TCValue*)value storage:(TCStorageManager*) storage
 {
+    // Storage is written using the type of the value, so a scalar must be
+    // converted first, or float f = 1.5 would store all eight bytes of a
+    // double.
+
+    if( value.getType != _type && value.getType < TCVALUE_POINTER && _type < TCVALUE_POINTER )
+        value = [value castTo:_type];
+
     _initialValue = value;
     if( _allocated )
         [storage setValue:value at:_address];
     else
         NSLog(@"FATAL: attempt to store value with no storage allocated");
-    
+
+}
+
+-(void) setDimensions:(NSArray*) dimensions elementSize:(int) size
+{
+    _rank = (int) MIN(dimensions.count, TCSYMBOL_MAX_DIMENSIONS);
+
+    // The last dimension varies fastest, so its stride is the element
+    // size; each outer stride is the size of one row of the next.
+
+    long stride = size;
+    for( int ix = _rank - 1; ix >= 0; ix-- ) {
+        _extents[ix] = [dimensions[ix] longValue];
+        _strides[ix] = stride;
+        stride *= _extents[ix];
+    }
+}
+
+-(const long*) extents
+{
+    return _extents;
+}
+
+-(const long*) strides
+{
+    return _strides;
 }
 -(NSString*)description
 {
@@ -8,6 +8,7 @@
 
 #import "TCRuntimeSymbolTable.h"
 #import "TCToken.h"
+#import "TCMetrics.h"
 
 @implementation TCRuntimeSymbolTable
 
@@ -29,9 +30,14 @@
 -(TCRuntimeSymbol *) findSymbol:(NSString*) name
 {
     
+    runtimeCounters.lookups++;
+    
+    // Walk out through the enclosing tables here rather than recursing,
+    // so a lookup is counted once however deep the scope.
+    
     TCRuntimeSymbol * symbol = [_symbols objectForKey:name];
-    if( symbol == nil && _parent != nil )
-        symbol = [_parent findSymbol:name];
+    for( TCRuntimeSymbolTable * table = _parent; symbol == nil && table != nil; table = table.parent )
+        symbol = [table.symbols objectForKey:name];
     return symbol;
 }
 
@@ -0,0 +1,129 @@
+//
+//  TCScheduler.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Runs many compiled TinyC programs as tasks on a fixed pool of worker
+//  threads.  Each worker has its own queue of ready tasks; it takes the
+//  oldest from its own queue, and when that is empty steals the newest from
+//  another worker's.  A task runs for a slice of executed nodes and is then
+//  preempted at the next loop back-edge or function call, and goes to the
+//  back of its worker's queue, so a long-running script cannot hold a worker
+//  while short ones wait.
+//
+//  Each program has its own TinyC object and so its own storage.  The
+//  interpreter keeps the running program's state on the host stack, so a
+//  task runs on a host thread of its own that is parked while the task is
+//  not scheduled; the worker hands control to it and waits for it to hand
+//  control back, so no more tasks run at once than there are workers.
+
+#import <Foundation/Foundation.h>
+#import "TCMetrics.h"
+#import "TCError.h"
+
+@class TinyC;
+
+/** The nodes a task executes before it can be preempted, by default */
+#define TCSCHEDULER_BUDGET 20000L
+
+/** The size of the host stack of each task thread */
+#define TCSCHEDULER_TASK_STACK (4L * 1024L * 1024L)
+
+/**
+ The time slice of the task running on a thread.
+ */
+typedef struct {
+    /** The nodes the task may execute each time it is scheduled */
+    long budget;
+
+    /** The node count at which the task is preempted */
+    long deadline;
+
+    /** The task, not retained */
+    void * task;
+} TCSlice;
+
+/** The slice of the task running on this thread, or NULL if not scheduled */
+extern __thread TCSlice * activeSlice;
+
+/**
+ Give up the worker running the current task, and wait to be scheduled
+ again.  Called by sliceCheck() when the slice is used up.
+ */
+void slicePreempt(void);
+
+/**
+ Preempt the current task if it has used its slice.  Called at loop
+ back-edges and function calls.
+ */
+static inline void sliceCheck(void)
+{
+    if( activeSlice && runtimeCounters.nodes >= activeSlice->deadline )
+        slicePreempt();
+}
+
+/**
+ A program submitted to a scheduler.
+ */
+@interface TCTask : NSObject
+
+/** The program being run */
+@property (readonly) TinyC * program;
+
+/** Has the program finished? */
+@property (readonly) BOOL done;
+
+/** The error the program's execution returned, if any, once it is done */
+@property (readonly) TCError * error;
+
+/** The seconds from submission until the program finished */
+@property (readonly) double elapsed;
+
+/** The number of slices the task was given */
+@property (readonly) long slices;
+
+/**
+ Wait for the program to finish.
+ @return the error its execution returned, or nil if there was none
+ */
+-(TCError*) wait;
+
+@end
+
+@interface TCScheduler : NSObject
+
+/** The nodes a task executes before it can be preempted */
+@property long budget;
+
+/** The number of worker threads */
+@property (readonly) int workers;
+
+/**
+ Start a scheduler.
+ @param workers the number of worker threads, or 0 for one per processor
+ @return the scheduler, with its workers waiting for tasks
+ */
+-(instancetype) initWithWorkers:(int) workers;
+
+/**
+ Queue a compiled program to be executed.  A program must not be
+ submitted again, or executed any other way, until its task is done.
+ @param program the program, already compiled
+ @return the task, which can be waited on
+ */
+-(TCTask*) submit:(TinyC*) program;
+
+/**
+ Wait until every task submitted so far has finished.
+ */
+-(void) waitAll;
+
+/**
+ Let the workers finish the queued tasks and then exit.  No more tasks
+ may be submitted.
+ */
+-(void) shutdown;
+
+@end
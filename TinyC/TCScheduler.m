@@ -0,0 +1,308 @@
+//
+//  TCScheduler.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCScheduler.h"
+#import "TinyC.h"
+#include <time.h>
+
+__thread TCSlice * activeSlice = NULL;
+
+/**
+ Read the monotonic clock, in seconds.
+ */
+static double taskClock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1.0e9;
+}
+
+#pragma mark - Tasks
+
+@interface TCTask ()
+
+-(instancetype) initWithProgram:(TinyC*) program;
+-(void) runSlice:(long) budget;
+-(void) preempt;
+-(void) finish;
+
+@end
+
+@implementation TCTask
+
+{
+    /** Signalled to let the task run */
+    dispatch_semaphore_t _run;
+
+    /** Signalled when the task is preempted or its program returns */
+    dispatch_semaphore_t _pause;
+
+    /** Signalled once the scheduler has finished with the task */
+    dispatch_semaphore_t _finished;
+
+    TCSlice _slice;
+    BOOL _started;
+    double _submitted;
+}
+
+-(instancetype) initWithProgram:(TinyC *)program
+{
+    if(( self = [super init])) {
+        _program = program;
+        _run = dispatch_semaphore_create(0);
+        _pause = dispatch_semaphore_create(0);
+        _finished = dispatch_semaphore_create(0);
+        _slice.task = (__bridge void*) self;
+        _submitted = taskClock();
+    }
+    return self;
+}
+
+/**
+ The body of the task's thread.  The program runs here from start to
+ finish, stopping in preempt whenever its slice is used up.
+ */
+-(void) main
+{
+    @autoreleasepool {
+        activeSlice = &_slice;
+        _slice.deadline = runtimeCounters.nodes + _slice.budget;
+        _error = [_program execute];
+        activeSlice = NULL;
+        _done = YES;
+        dispatch_semaphore_signal(_pause);
+    }
+}
+
+/**
+ Run the task on the calling worker until it is preempted or finishes.
+ */
+-(void) runSlice:(long)budget
+{
+    _slice.budget = budget;
+    _slices++;
+    if( !_started ) {
+        _started = YES;
+        NSThread * thread = [[NSThread alloc]initWithTarget:self selector:@selector(main) object:nil];
+        thread.stackSize = TCSCHEDULER_TASK_STACK;
+        [thread start];
+    }
+    else
+        dispatch_semaphore_signal(_run);
+    dispatch_semaphore_wait(_pause, DISPATCH_TIME_FOREVER);
+}
+
+/**
+ Hand the worker back and wait for the next slice.  This runs on the
+ task's thread, or on the thread of a coroutine the task resumed.
+ */
+-(void) preempt
+{
+    dispatch_semaphore_signal(_pause);
+    dispatch_semaphore_wait(_run, DISPATCH_TIME_FOREVER);
+    _slice.deadline = runtimeCounters.nodes + _slice.budget;
+}
+
+-(void) finish
+{
+    _elapsed = taskClock() - _submitted;
+    dispatch_semaphore_signal(_finished);
+}
+
+-(TCError*) wait
+{
+    dispatch_semaphore_wait(_finished, DISPATCH_TIME_FOREVER);
+    dispatch_semaphore_signal(_finished);
+    return _error;
+}
+
+@end
+
+void slicePreempt(void)
+{
+    TCTask * task = (__bridge TCTask*) activeSlice->task;
+    [task preempt];
+}
+
+#pragma mark - Scheduler
+
+@implementation TCScheduler
+
+{
+    /** The ready queue of each worker, and the lock for each */
+    NSArray * _queues;
+    NSArray * _locks;
+
+    /** Guards the counts below; signalled when work arrives or ends */
+    NSCondition * _state;
+
+    /** Tasks sitting in a ready queue */
+    long _ready;
+
+    /** Tasks submitted and not yet finished */
+    long _outstanding;
+
+    /** The queue the next submitted task goes on */
+    int _next;
+
+    BOOL _stopping;
+}
+
+-(instancetype) initWithWorkers:(int)workers
+{
+    if(( self = [super init])) {
+        if( workers < 1 )
+            workers = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+        _workers = workers;
+        _budget = TCSCHEDULER_BUDGET;
+        _state = [[NSCondition alloc]init];
+
+        NSMutableArray * queues = [NSMutableArray array];
+        NSMutableArray * locks = [NSMutableArray array];
+        for( int ix = 0; ix < workers; ix++ ) {
+            [queues addObject:[NSMutableArray array]];
+            [locks addObject:[[NSLock alloc]init]];
+        }
+        _queues = queues;
+        _locks = locks;
+
+        for( int ix = 0; ix < workers; ix++ ) {
+            NSThread * worker = [[NSThread alloc]initWithTarget:self
+                                                       selector:@selector(work:)
+                                                         object:@(ix)];
+            [worker start];
+        }
+    }
+    return self;
+}
+
+-(TCTask*) submit:(TinyC *)program
+{
+    TCTask * task = [[TCTask alloc]initWithProgram:program];
+
+    [_state lock];
+    _outstanding++;
+    int queue = _next;
+    _next = (_next + 1) % _workers;
+    [_state unlock];
+
+    [self enqueue:task on:queue];
+    return task;
+}
+
+/**
+ Put a task at the back of a worker's queue and wake an idle worker.
+ */
+-(void) enqueue:(TCTask*) task on:(int) queue
+{
+    NSLock * lock = _locks[queue];
+    [lock lock];
+    [_queues[queue] addObject:task];
+    [lock unlock];
+
+    [_state lock];
+    _ready++;
+    [_state broadcast];
+    [_state unlock];
+}
+
+/**
+ Find the next task for a worker: the oldest in its own queue, or else the
+ newest in the first other queue that has one.
+ */
+-(TCTask*) take:(int) worker
+{
+    TCTask * task = nil;
+    for( int ix = 0; ix < _workers && task == nil; ix++ ) {
+        int queue = (worker + ix) % _workers;
+        NSMutableArray * tasks = _queues[queue];
+        NSLock * lock = _locks[queue];
+        [lock lock];
+        if( tasks.count > 0 ) {
+            if( ix == 0 ) {
+                task = tasks[0];
+                [tasks removeObjectAtIndex:0];
+            }
+            else {
+                task = tasks.lastObject;
+                [tasks removeLastObject];
+            }
+        }
+        [lock unlock];
+    }
+    if( task != nil ) {
+        [_state lock];
+        _ready--;
+        [_state unlock];
+    }
+    return task;
+}
+
+/**
+ The body of a worker thread.
+ */
+-(void) work:(NSNumber*) index
+{
+    int worker = index.intValue;
+    while( YES ) {
+        @autoreleasepool {
+            TCTask * task = [self take:worker];
+            if( task == nil ) {
+                [_state lock];
+                while( _ready <= 0 && !_stopping )
+                    [_state wait];
+                BOOL finished = _ready <= 0 && _stopping;
+                [_state unlock];
+                if( finished )
+                    return;
+                continue;
+            }
+
+            // Keep running the task while nothing else is waiting, rather
+            // than passing it through the queue.
+
+            BOOL idle = NO;
+            do {
+                [task runSlice:_budget];
+                [_state lock];
+                idle = _ready <= 0;
+                [_state unlock];
+            } while( !task.done && idle );
+
+            if( !task.done ) {
+                [self enqueue:task on:worker];
+                continue;
+            }
+
+            [task finish];
+            [_state lock];
+            _outstanding--;
+            [_state broadcast];
+            [_state unlock];
+        }
+    }
+}
+
+-(void) waitAll
+{
+    [_state lock];
+    while( _outstanding > 0 )
+        [_state wait];
+    [_state unlock];
+}
+
+-(void) shutdown
+{
+    [self waitAll];
+    [_state lock];
+    _stopping = YES;
+    [_state broadcast];
+    [_state unlock];
+}
+
+@end
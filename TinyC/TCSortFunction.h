@@ -0,0 +1,84 @@
+//
+//  TCSortFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Base class for the sort and search builtins.  Arrays of int, long, float
+//  or double, and arrays of char* strings, are sorted with native compares
+//  by a merge sort; above TCSORT_PARALLEL_THRESHOLD elements the runs are
+//  sorted and merged on all the processors.  qsort() and bsearch() take the
+//  name of a TinyC comparator function instead, and run on the interpreter
+//  thread since each compare is a TinyC call.
+
+#import "TCArrayFunction.h"
+
+/** The number of elements at which a native sort is spread across threads */
+#define TCSORT_PARALLEL_THRESHOLD 65536L
+
+/**
+ A string being sorted: its text, for comparing, and the address in
+ runtime storage that is written back in sorted order.
+ */
+typedef struct {
+    const char * text;
+    long address;
+} TCSortString;
+
+@interface TCSortFunction : TCArrayFunction
+
+/**
+ Sort an array of numbers in place, in ascending order.
+ @param base a real pointer to the first element
+ @param count the number of elements
+ @param type the element type, which must be int, long, float or double
+ @return NO if there was no memory for the merge buffer; the error property
+ is set
+ */
+-(BOOL) sort:(void*) base count:(long) count type:(TCValueType) type;
+
+/**
+ Sort strings into ascending strcmp() order.
+ @param items the strings
+ @param count the number of strings
+ @return NO if there was no memory for the merge buffer; the error property
+ is set
+ */
+-(BOOL) sortStrings:(TCSortString*) items count:(long) count;
+
+/**
+ Gather the strings of an array of char* in runtime storage, which a
+ TinyC program keeps as an array of long addresses.  If the array or any
+ of its strings is not addressable, the error property is set.
+ @param value the array argument
+ @param count the number of strings
+ @param position the argument number, starting at 1, for error messages
+ @return a buffer the caller must free(), or NULL if there was an error
+ */
+-(TCSortString*) stringsOf:(TCValue*) value count:(long) count argument:(int) position;
+
+/**
+ Find the TinyC function named by a comparator argument.  If there is no
+ such function, the error property is set.
+ @param name the argument, a string holding the function name
+ @return the function's entry point, or nil if there was an error
+ */
+-(TCSyntaxNode*) comparator:(TCValue*) name;
+
+/**
+ Call a TinyC comparator with two pointers, as qsort() does.
+ @param entry the comparator's entry point
+ @param left the first pointer
+ @param right the second pointer
+ @param context the context the builtin was called from
+ @param failed set to YES if the call failed; the error property is set
+ @return the comparator's result, negative, zero or positive
+ */
+-(long) compare:(TCSyntaxNode*) entry
+           left:(TCValue*) left
+          right:(TCValue*) right
+      inContext:(TCExecutionContext*) context
+         failed:(BOOL*) failed;
+
+@end
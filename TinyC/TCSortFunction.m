@@ -0,0 +1,245 @@
+//
+//  TCSortFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCSortFunction.h"
+#import "TCMetrics.h"
+
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+/** Runs this short are sorted by insertion rather than split further */
+#define TCSORT_RUN 32
+
+typedef void (*TCSortRun)(void * a, void * tmp, long n);
+typedef void (*TCSortMerge)(const void * a, long na, const void * b, long nb, void * out);
+
+/**
+ Define a stable merge sort for one element type.  NAME##Sort sorts n
+ elements using tmp, which must also hold n elements; NAME##Merge merges
+ two sorted runs into out.  The void forms are what the parallel driver
+ calls.
+ */
+#define TCSORT_DEFINE(NAME, T, LESS) \
+static void NAME##Insertion(T * a, long n) \
+{ \
+    for( long i = 1; i < n; i++ ) { \
+        T x = a[i]; \
+        long j = i; \
+        for( ; j > 0 && LESS(x, a[j - 1]); j-- ) \
+            a[j] = a[j - 1]; \
+        a[j] = x; \
+    } \
+} \
+static void NAME##Merge(const T * a, long na, const T * b, long nb, T * out) \
+{ \
+    long i = 0, j = 0, k = 0; \
+    while( i < na && j < nb ) \
+        out[k++] = LESS(b[j], a[i]) ? b[j++] : a[i++]; \
+    while( i < na ) \
+        out[k++] = a[i++]; \
+    while( j < nb ) \
+        out[k++] = b[j++]; \
+} \
+static void NAME##Sort(T * a, T * tmp, long n) \
+{ \
+    if( n <= TCSORT_RUN ) { \
+        NAME##Insertion(a, n); \
+        return; \
+    } \
+    long h = n / 2; \
+    NAME##Sort(a, tmp, h); \
+    NAME##Sort(a + h, tmp + h, n - h); \
+    if( !LESS(a[h], a[h - 1]) ) \
+        return; \
+    memcpy(tmp, a, n * sizeof(T)); \
+    NAME##Merge(tmp, h, tmp + h, n - h, a); \
+} \
+static void NAME##SortRun(void * a, void * tmp, long n) \
+{ \
+    NAME##Sort(a, tmp, n); \
+} \
+static void NAME##MergeRun(const void * a, long na, const void * b, long nb, void * out) \
+{ \
+    NAME##Merge(a, na, b, nb, out); \
+}
+
+#define TCSORT_LESS(x, y) ((x) < (y))
+#define TCSORT_STRLESS(x, y) (strcmp((x).text, (y).text) < 0)
+
+TCSORT_DEFINE(intSort, int, TCSORT_LESS)
+TCSORT_DEFINE(longSort, long, TCSORT_LESS)
+TCSORT_DEFINE(floatSort, float, TCSORT_LESS)
+TCSORT_DEFINE(doubleSort, double, TCSORT_LESS)
+TCSORT_DEFINE(stringSort, TCSortString, TCSORT_STRLESS)
+
+/**
+ Sort n elements of the given size.  A large array is cut into one run per
+ processor; the runs are sorted at the same time, then merged in pairs,
+ each round of merges also running at the same time, going back and forth
+ between the array and tmp.
+ */
+static void sortElements(char * a, char * tmp, long n, size_t size, TCSortRun sort, TCSortMerge merge)
+{
+    long runs = 1;
+    long processors = [[NSProcessInfo processInfo] activeProcessorCount];
+    while( runs * 2 <= processors && runs < 64 )
+        runs *= 2;
+
+    if( n < TCSORT_PARALLEL_THRESHOLD || runs < 2 ) {
+        sort(a, tmp, n);
+        return;
+    }
+
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+    long width = (n + runs - 1) / runs;
+    dispatch_apply(runs, queue, ^(size_t run) {
+        long lo = MIN((long) run * width, n);
+        long hi = MIN(lo + width, n);
+        sort(a + lo * size, tmp + lo * size, hi - lo);
+    });
+
+    char * from = a;
+    char * to = tmp;
+    for( ; width < n; width *= 2 ) {
+        long pairs = (n + 2 * width - 1) / (2 * width);
+        char * src = from;
+        char * dest = to;
+        long w = width;
+        dispatch_apply(pairs, queue, ^(size_t pair) {
+            long lo = (long) pair * 2 * w;
+            long mid = MIN(lo + w, n);
+            long hi = MIN(lo + 2 * w, n);
+            merge(src + lo * size, mid - lo, src + mid * size, hi - mid, dest + lo * size);
+        });
+        from = dest;
+        to = src;
+    }
+    if( from != a )
+        memcpy(a, from, n * size);
+}
+
+@implementation TCSortFunction
+
+-(BOOL) merge:(void*) base count:(long) count size:(size_t) size sort:(TCSortRun) sort merge:(TCSortMerge) merge
+{
+    if( count < 2 )
+        return YES;
+
+    char * tmp = malloc(count * size);
+    if( tmp == NULL ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_FATAL
+                                           atNode:self.node
+                                     withArgument:@"no memory to sort"];
+        return NO;
+    }
+    sortElements(base, tmp, count, size, sort, merge);
+    free(tmp);
+    return YES;
+}
+
+-(BOOL) sort:(void *)base count:(long)count type:(TCValueType)type
+{
+    switch( type ) {
+        case TCVALUE_INT:
+            return [self merge:base count:count size:sizeof(int) sort:intSortSortRun merge:intSortMergeRun];
+        case TCVALUE_LONG:
+            return [self merge:base count:count size:sizeof(long) sort:longSortSortRun merge:longSortMergeRun];
+        case TCVALUE_FLOAT:
+            return [self merge:base count:count size:sizeof(float) sort:floatSortSortRun merge:floatSortMergeRun];
+        case TCVALUE_DOUBLE:
+            return [self merge:base count:count size:sizeof(double) sort:doubleSortSortRun merge:doubleSortMergeRun];
+        default:
+            return YES;
+    }
+}
+
+-(BOOL) sortStrings:(TCSortString *)items count:(long)count
+{
+    return [self merge:items count:count size:sizeof(TCSortString) sort:stringSortSortRun merge:stringSortMergeRun];
+}
+
+-(TCSortString*) stringsOf:(TCValue *)value count:(long)count argument:(int)position
+{
+    TCValueType type = TCVALUE_UNDEFINED;
+    const long * addresses = [self elementsOf:value count:count type:&type forWrite:NO argument:position];
+    if( addresses == NULL )
+        return NULL;
+    if( type != TCVALUE_LONG ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:position]];
+        return NULL;
+    }
+
+    // Each string is checked once here, so the sort itself compares real
+    // C strings.
+
+    TCSortString * items = malloc(MAX(count, 1L) * sizeof(TCSortString));
+    if( items == NULL ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_FATAL
+                                           atNode:self.node
+                                     withArgument:@"no memory to sort"];
+        return NULL;
+    }
+    for( long ix = 0; ix < count; ix++ ) {
+        long length = [self stringLength:addresses[ix] limit:LONG_MAX];
+        items[ix].text = length < 0 ? NULL : [self pointerTo:addresses[ix] length:length + 1 forWrite:NO];
+        items[ix].address = addresses[ix];
+        if( items[ix].text == NULL ) {
+            free(items);
+            return NULL;
+        }
+    }
+    return items;
+}
+
+-(TCSyntaxNode*) comparator:(TCValue *)name
+{
+    const char * text = [self cString:name];
+    if( text == NULL )
+        return nil;
+    NSString * spelling = [NSString stringWithUTF8String:text];
+    TCSyntaxNode * entry = [activeContext findEntryPoint:spelling];
+    if( entry == nil )
+        self.error = [[TCError alloc]initWithCode:TCERROR_UNK_ENTRYPOINT
+                                           atNode:self.node
+                                     withArgument:spelling];
+    return entry;
+}
+
+-(long) compare:(TCSyntaxNode *)entry
+           left:(TCValue *)left
+          right:(TCValue *)right
+      inContext:(TCExecutionContext *)context
+         failed:(BOOL *)failed
+{
+    // The comparator runs in a new frame, exactly as if the program had
+    // called it.
+
+    runtimeCounters.calls++;
+    TCExecutionContext * savedContext = activeContext;
+    TCExecutionContext * callContext = [[TCExecutionContext alloc]initWithStorage:self.storage];
+    callContext.debug = savedContext.debug;
+    callContext.assertAbort = savedContext.assertAbort;
+    callContext.module = savedContext.module;
+    callContext.symbols = context.symbols;
+    activeContext = callContext;
+
+    TCValue * result = [callContext execute:entry entryPoint:nil withArguments:@[left, right]];
+    TCError * error = callContext.error;
+
+    activeContext = savedContext;
+
+    if( error != nil || result == nil ) {
+        self.error = error ? error : [[TCError alloc]initWithCode:TCERROR_RETURNVALUE atNode:self.node];
+        *failed = YES;
+        return 0L;
+    }
+    return result.getLong;
+}
+
+@end
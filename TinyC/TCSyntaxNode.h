@@ -8,6 +8,7 @@
 
 #import <Foundation/Foundation.h>
 @class TCLexicalScanner;
+@class TCTier;
 
 typedef enum {
     /**
@@ -222,9 +223,23 @@ typedef enum {
     LANGUAGE_WHILE,
     LANGUAGE_CONTINUE,
     LANGUAGE_BREAK,
-    LANGUAGE_MODULE
+    LANGUAGE_MODULE,
+    
+    /**
+     A function in a shared library, declared with extern.
+     
+     @note the spelling is the function name and the argument is the
+     library path (nil to search the libraries already loaded) until the
+     module is bound, when it becomes the TCForeignFunction that calls it.
+     The subNodes are the return type and the parameter declarations, as
+     for an ENTRYPOINT, with no body.
+     */
+    LANGUAGE_EXTERN
 } SyntaxNodeType;
 
+/** Get the printable name of a node type */
+NSString * nodeSpelling( int nodeType );
+
 @interface TCSyntaxNode : NSObject
 
 @property SyntaxNodeType nodeType;
@@ -235,10 +250,27 @@ typedef enum {
 @property long position;
 @property TCLexicalScanner * scanner;
 
+/** For the NAME node of an array declaration, the extent of each dimension
+    as an NSNumber, outermost first */
+@property NSArray * dimensions;
+
+/** For an ARRAY node, a bit for each index expression that is known to be
+    within its dimension, so the bounds check can be skipped */
+@property unsigned int provenIndexes;
+
+/** For the ENTRYPOINT node of a function, what counts its calls and
+    holds the faster copy of it once it is hot */
+@property TCTier * tier;
+
 +(instancetype) node:(SyntaxNodeType)type usingScanner:(TCLexicalScanner*) parser;
 -(instancetype) initWithType:(SyntaxNodeType) type usingScanner:(TCLexicalScanner*) parser;
 
 -(void) addNode: (TCSyntaxNode*) newNode;
+
+/** Copy a node and everything under it, so the copy can be rewritten
+    while the original is still being run.  The tier is not copied. */
+-(TCSyntaxNode*) copyTree;
+
 -(void) dumpTree;
 -(int) nodeAction;
 
@@ -63,6 +63,8 @@ NSString * nodeSpelling( int nodeType ) {
             return @"BREAK";
         case LANGUAGE_CONTINUE:
             return @"CONTINUE";
+        case LANGUAGE_EXTERN:
+            return @"EXTERN";
             
         default:
             return [[NSString alloc]initWithFormat:@"%d", nodeType];
@@ -153,6 +155,23 @@ NSString * nodeSpelling( int nodeType ) {
     [self.subNodes addObject:newNode];
 }
 
+-(TCSyntaxNode*) copyTree
+{
+    TCSyntaxNode * copy = [[TCSyntaxNode alloc]initWithType:_nodeType usingScanner:_scanner];
+    copy.spelling = _spelling;
+    copy.action = _action;
+    copy.argument = _argument;
+    copy.position = _position;
+    copy.dimensions = _dimensions;
+    copy.provenIndexes = _provenIndexes;
+    if( _subNodes ) {
+        copy.subNodes = [NSMutableArray arrayWithCapacity:_subNodes.count];
+        for( TCSyntaxNode * sub in _subNodes )
+            [copy.subNodes addObject:[sub copyTree]];
+    }
+    return copy;
+}
+
 -(int) nodeAction
 {
     return _action;
@@ -0,0 +1,107 @@
+//
+//  TCThread.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  A TinyC function running on a host thread of its own, started with
+//  spawn() and waited for with join(), or one of the workers of
+//  parallel_for().  It shares the program's storage,
+//  so it sees the same globals and dynamic storage, and has its own block
+//  of the dynamic area for its automatic storage.
+//
+//  A spawned function sees only the globals, not the locals of the
+//  function that spawned it: that function can go on declaring into its
+//  scope, or return and pop its frame, while the thread runs.  The
+//  workers of parallel_for() can see the caller's locals, as the caller
+//  waits for them.
+//
+//  A thread counts its work in its own runtime counters, which are added
+//  to the joining thread's when it is joined, and runs under the same
+//  limits as the thread that spawned it.  It has its own random number
+//  generator, seeded from the spawning thread's.  The profilers and the
+//  trace ring are not thread-safe, so a spawned thread does not feed them.
+
+#import <Foundation/Foundation.h>
+#import "TCValue.h"
+#import "TCError.h"
+
+@class TCSyntaxNode;
+@class TCStorageManager;
+@class TCRuntimeSymbolTable;
+@class TCExecutionContext;
+
+/** The bytes of automatic storage given to each thread */
+#define TCTHREAD_STACK 65536L
+
+/** The size of the host stack of each thread */
+#define TCTHREAD_HOST_STACK (8L * 1024L * 1024L)
+
+/** The global scope of the program running on this thread */
+extern __thread __unsafe_unretained TCRuntimeSymbolTable * activeGlobals;
+
+/**
+ The work a thread does, given the execution context made for it.  It
+ returns the thread's result, and leaves any error in the context.
+ */
+typedef TCValue * (^TCThreadBody)(TCExecutionContext * context);
+
+@interface TCThread : NSObject
+
+/** The number a program uses to refer to the thread */
+@property (readonly) long handle;
+
+/** The error that ended the function, if any, once it is joined */
+@property (readonly) TCError * error;
+
+/**
+ Start a thread running a function.
+ @param entry the ENTRYPOINT of the function
+ @param arguments the values of the function's parameters
+ @param symbols the symbols the function can see
+ @param storage the runtime storage of the program
+ @return the thread, or nil if there is no storage for its stack
+ */
+-(instancetype) initWithEntry:(TCSyntaxNode*) entry
+                    arguments:(NSArray*) arguments
+                      symbols:(TCRuntimeSymbolTable*) symbols
+                      storage:(TCStorageManager*) storage;
+
+/**
+ Start a thread doing work for the interpreter itself, such as one of the
+ workers of parallel_for().  It has no handle, so the program cannot join
+ it; the caller must.
+ @param symbols the symbols the work can see
+ @param storage the runtime storage of the program
+ @param body the work, which is run on the new thread
+ @return the thread, or nil if there is no storage for its stack
+ */
+-(instancetype) initWithSymbols:(TCRuntimeSymbolTable*) symbols
+                        storage:(TCStorageManager*) storage
+                           body:(TCThreadBody) body;
+
+/**
+ Find a thread from its handle.  A program can only use the threads it
+ started, and each can be joined once.
+ @param handle the handle
+ @param storage the runtime storage of the program asking
+ @return the thread, or nil if the program has no such thread
+ */
++(TCThread*) threadFor:(long) handle storage:(TCStorageManager*) storage;
+
+/**
+ Wait for the thread's function to return, and release the thread.
+ @return the function's result, or nil if it ended with an error, which
+ is stored in the error property
+ */
+-(TCValue*) join;
+
+/**
+ Wait for every thread of a program that has not been joined, as at the
+ end of its execution.
+ @param storage the runtime storage of the program
+ */
++(void) joinAllInStorage:(TCStorageManager*) storage;
+
+@end
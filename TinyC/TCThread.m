@@ -0,0 +1,206 @@
+//
+//  TCThread.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCThread.h"
+#import "TCSyntaxNode.h"
+#import "TCStorageManager.h"
+#import "TCExecutionContext.h"
+#import "TCRuntimeSymbolTable.h"
+#import "TCMetrics.h"
+#import "TCRandom.h"
+
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+__thread __unsafe_unretained TCRuntimeSymbolTable * activeGlobals;
+
+/** The threads of every program that have not been joined, by handle */
+static NSMutableDictionary * threads = nil;
+
+/** The handle to give the next thread */
+static long nextHandle = 1L;
+
+@implementation TCThread
+
+{
+    TCThreadBody _body;
+    TCRuntimeSymbolTable * _symbols;
+    TCRuntimeSymbolTable * _globals;
+    TCStorageManager * _storage;
+    TCExecutionContext * _module;
+
+    /** Signalled when the function returns */
+    dispatch_semaphore_t _finished;
+
+    /** The thread's automatic stack */
+    TCStorageStack * _stack;
+
+    /** The address of the block holding the automatic stack */
+    long _stackAddress;
+
+    /** The thread's own random number generator */
+    TCRandomState _random;
+
+    /** The limits the thread runs under, and the counters it ends with */
+    TCRuntimeLimits _limits;
+    TCRuntimeCounters _counters;
+
+    TCValue * _result;
+}
+
+-(instancetype) initWithEntry:(TCSyntaxNode *)entry
+                    arguments:(NSArray *)arguments
+                      symbols:(TCRuntimeSymbolTable *)symbols
+                      storage:(TCStorageManager *)storage
+{
+    TCThreadBody body = ^TCValue*(TCExecutionContext * context) {
+        return [context execute:entry entryPoint:nil withArguments:arguments];
+    };
+    return [self initWithSymbols:symbols storage:storage body:body registered:YES];
+}
+
+-(instancetype) initWithSymbols:(TCRuntimeSymbolTable *)symbols
+                        storage:(TCStorageManager *)storage
+                           body:(TCThreadBody)body
+{
+    return [self initWithSymbols:symbols storage:storage body:body registered:NO];
+}
+
+/**
+ Start a thread, giving it a handle if the program is to be able to join it.
+ */
+-(instancetype) initWithSymbols:(TCRuntimeSymbolTable *)symbols
+                        storage:(TCStorageManager *)storage
+                           body:(TCThreadBody)body
+                     registered:(BOOL)registered
+{
+    if(( self = [super init])) {
+        _stackAddress = [storage allocateDynamic:TCTHREAD_STACK];
+        if( _stackAddress == 0L )
+            return nil;
+
+        _body = body;
+        _symbols = symbols;
+        _globals = activeGlobals;
+        _storage = storage;
+        _module = activeContext;
+        _finished = dispatch_semaphore_create(0);
+        _limits = runtimeLimits;
+        randomSeed(&_random, randomNext(randomCurrent()));
+
+        _stack = [[TCStorageStack alloc]init];
+        _stack.base = _stackAddress;
+        _stack.current = _stackAddress;
+        _stack.limit = _stackAddress + TCTHREAD_STACK;
+
+        if( registered ) {
+            @synchronized([TCThread class]) {
+                if( threads == nil )
+                    threads = [NSMutableDictionary dictionary];
+                _handle = nextHandle++;
+                threads[@(_handle)] = self;
+            }
+        }
+
+        NSThread * thread = [[NSThread alloc]initWithTarget:self selector:@selector(main) object:nil];
+        thread.stackSize = TCTHREAD_HOST_STACK;
+        [thread start];
+    }
+    return self;
+}
+
++(TCThread*) threadFor:(long)handle storage:(TCStorageManager *)storage
+{
+    TCThread * thread = nil;
+    @synchronized([TCThread class]) {
+        thread = threads[@(handle)];
+    }
+    return (thread && thread->_storage == storage) ? thread : nil;
+}
+
+/**
+ Run the function on the new thread.
+ */
+-(void) main
+{
+    @autoreleasepool {
+        
+        // The thread counts its own work, which is merged into the
+        // joiner's counters, but charges it to the budget it shares with
+        // the rest of the execution.
+        
+        resetRuntimeCounters();
+        runtimeLimits = _limits;
+        activeRandom = &_random;
+        activeGlobals = _globals;
+        [_storage adoptStack:_stack];
+
+        runtimeCounters.calls++;
+        TCExecutionContext * context = [[TCExecutionContext alloc]initWithStorage:_storage];
+        context.debug = _module.debug;
+        context.assertAbort = _module.assertAbort;
+        context.module = _module.module;
+        context.symbols = _symbols;
+        activeContext = context;
+
+        _result = _body(context);
+        _error = context.error;
+        limitExceeded();
+        _counters = runtimeCounters;
+        _limits = runtimeLimits;
+
+        [_storage adoptStack:nil];
+        activeContext = nil;
+        activeRandom = NULL;
+        activeGlobals = nil;
+        dispatch_semaphore_signal(_finished);
+    }
+}
+
+-(TCValue*) join
+{
+    // Only one joiner can take the thread out of the table.  A thread with
+    // no handle was never in it, and belongs to whoever started it.
+
+    BOOL claimed = _handle == 0L;
+    if( !claimed ) {
+        @synchronized([TCThread class]) {
+            claimed = threads[@(_handle)] == self;
+            [threads removeObjectForKey:@(_handle)];
+        }
+    }
+    if( !claimed ) {
+        _error = [[TCError alloc]initWithCode:TCERROR_THREAD
+                                       atNode:nil
+                                 withArgument:@"thread already joined"];
+        return nil;
+    }
+    dispatch_semaphore_wait(_finished, DISPATCH_TIME_FOREVER);
+
+    // The thread's work is charged to the joiner, and a limit it ran into
+    // stops the joiner too.
+
+    mergeRuntimeCounters(&_counters);
+    if( _limits.exceeded != TCLIMIT_NONE )
+        runtimeLimits.exceeded = _limits.exceeded;
+
+    [_storage free:_stackAddress];
+    return _error ? nil : _result;
+}
+
++(void) joinAllInStorage:(TCStorageManager *)storage
+{
+    NSArray * live = nil;
+    @synchronized([TCThread class]) {
+        live = [threads allValues];
+    }
+    for( TCThread * thread in live )
+        if( thread->_storage == storage )
+            [thread join];
+}
+
+@end
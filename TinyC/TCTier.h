@@ -0,0 +1,55 @@
+//
+//  TCTier.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Tiered execution.  Every function starts out running the tree the
+//  parser built, which costs nothing to get going.  A TCTier hangs off the
+//  ENTRYPOINT of each function and counts the calls to it and the trips
+//  around its loops.  Once the function is hot, a copy of its tree is run
+//  through TCOptimizer, and the calls made from then on run it instead.
+//  The promotion is made by the call or loop trip that crosses the
+//  threshold, which waits for it, so the same program and input always
+//  switch at the same point.  Calls already running finish on the tree
+//  they started with, so a loop in main() that never returns keeps
+//  running the tree as parsed.
+//
+//  The counts are shared by every thread running the function and are
+//  kept without locks, so they are only as exact as a threshold needs.
+
+#import <Foundation/Foundation.h>
+
+@class TCSyntaxNode;
+
+/** The calls and loop trips after which a function is optimized */
+#define TCTIER_THRESHOLD 1000L
+
+@interface TCTier : NSObject
+
+/** The calls to the function counted so far */
+@property (readonly) long calls;
+
+/** The loop trips in the function counted so far */
+@property (readonly) long loops;
+
+/** The optimized copy of the function's ENTRYPOINT, once it is ready */
+@property (readonly) TCSyntaxNode * promoted;
+
+/**
+ Give each function of a module a tier.  The runtime entry point runs
+ once, so it gets none.
+ @param tree the parse tree of the module
+ @param debug YES to log each function as it is promoted
+ @return the number of functions given a tier
+ */
++(long) attachToModule:(TCSyntaxNode*) tree debug:(BOOL) debug;
+
+/** Count a call to the function */
+-(void) called;
+
+/** Count a trip around one of the function's loops */
+-(void) looped;
+
+@end
@@ -0,0 +1,104 @@
+//
+//  TCTier.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCTier.h"
+#import "TCSyntaxNode.h"
+#import "TCOptimizer.h"
+#import "TinyC.h"
+
+@interface TCTier ()
+
+@property (readwrite) TCSyntaxNode * promoted;
+
+@end
+
+@implementation TCTier
+
+{
+    /** The function, which owns the tier */
+    __weak TCSyntaxNode * _entry;
+
+    /** The optimizer and the queue it runs on, shared by the module */
+    TCOptimizer * _optimizer;
+    dispatch_queue_t _queue;
+
+    /** Set once the function has been sent to be optimized */
+    BOOL _requested;
+    BOOL _debug;
+}
+
++(long) attachToModule:(TCSyntaxNode *)tree debug:(BOOL)debug
+{
+    if( tree.nodeType != LANGUAGE_MODULE )
+        return 0L;
+
+    // One function is optimized at a time, as the optimizer keeps its
+    // state between passes.
+
+    TCOptimizer * optimizer = [[TCOptimizer alloc]initWithModule:tree];
+    dispatch_queue_t queue = dispatch_queue_create("TinyC tier", DISPATCH_QUEUE_SERIAL);
+
+    long count = 0L;
+    for( TCSyntaxNode * entry in tree.subNodes ) {
+        if( entry.nodeType != LANGUAGE_ENTRYPOINT || [entry.spelling isEqualToString:RUNTIME_ENTRYPOINT] )
+            continue;
+        TCTier * tier = [[TCTier alloc]init];
+        tier->_entry = entry;
+        tier->_optimizer = optimizer;
+        tier->_queue = queue;
+        tier->_debug = debug;
+        entry.tier = tier;
+        count++;
+    }
+    return count;
+}
+
+-(void) called
+{
+    [self count:&_calls];
+}
+
+-(void) looped
+{
+    [self count:&_loops];
+}
+
+/**
+ Add one to a count, and send the function to be optimized the first time
+ the counts reach the threshold.
+ */
+-(void) count:(long*) counter
+{
+    if( __atomic_load_n(&_requested, __ATOMIC_RELAXED))
+        return;
+    __atomic_add_fetch(counter, 1L, __ATOMIC_RELAXED);
+    long heat = __atomic_load_n(&_calls, __ATOMIC_RELAXED) + __atomic_load_n(&_loops, __ATOMIC_RELAXED);
+    if( heat < TCTIER_THRESHOLD || __atomic_exchange_n(&_requested, YES, __ATOMIC_ACQ_REL))
+        return;
+
+    TCSyntaxNode * entry = _entry;
+    if( entry == nil )
+        return;
+
+    // The original is only read while it is copied, so it can go on
+    // running on other threads.  The copy is published whole.  The call
+    // that crosses the threshold waits for it, so a run takes the same
+    // path every time, and node limits, metrics and profiles repeat.
+
+    TCOptimizer * optimizer = _optimizer;
+    dispatch_sync(_queue, ^{
+        TCSyntaxNode * copy = [entry copyTree];
+        [optimizer optimizeFunction:copy];
+        self.promoted = copy;
+        if( self->_debug )
+            NSLog(@"TIER: %@ promoted after %ld calls and %ld loop trips",
+                  entry.spelling, self.calls, self.loops);
+    });
+}
+
+@end
@@ -61,6 +61,7 @@ typedef  enum TOKEN_TYPE {
     TOKEN_INCREMENT,
     TOKEN_DECREMENT,
     TOKEN_PERCENT,
+    TOKEN_EXTERN,
     TOKEN__MAXVALUE
 } TokenType;
 
@@ -0,0 +1,173 @@
+//
+//  TCTraceBuffer.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//  Binary execution trace used by the -db option.  Rather than formatting
+//  a message for each event, the interpreters and the storage manager store
+//  a fixed-size record into a ring of the most recent events.  Recording is
+//  a few stores, so the trace can be left on for production runs.  The
+//  ring is written to a file when execution fails or when the program asks
+//  for it, and decoded later against the program source with tinyc -D.
+
+#import <Foundation/Foundation.h>
+
+@class TCLexicalScanner;
+
+/** Number of events kept in the ring unless another size is requested */
+#define TCTRACE_DEFAULT_EVENTS 65536
+
+/**
+ The kinds of trace events.
+ */
+typedef enum {
+    /** A statement or expression node; detail is the node type */
+    TCTRACE_NODE = 1,
+
+    /** Entry to a TinyC function; a is the number of arguments */
+    TCTRACE_CALL,
+
+    /** Return from a TinyC function; a is the result as a long */
+    TCTRACE_RETURN,
+
+    /** A builtin function call; a is the number of arguments */
+    TCTRACE_BUILTIN,
+
+    /** A typed storage read; detail is the value type, a the address, and
+        b the value (the bits of the value, for a float or double) */
+    TCTRACE_READ,
+
+    /** A typed storage write; recorded the same way as a read */
+    TCTRACE_WRITE,
+
+    /** A dynamic allocation; a is the address and b the size */
+    TCTRACE_ALLOC,
+
+    /** A dynamic free; a is the address and b the size released */
+    TCTRACE_FREE,
+
+    /** A runtime error; detail is the error code */
+    TCTRACE_ERROR
+} TCTraceOp;
+
+/**
+ A single trace event.  The source position is the position of the most
+ recent node executed, so storage events are attributed to the code that
+ caused them.
+ */
+typedef struct {
+    uint16_t op;
+    uint16_t detail;
+    int32_t position;
+    int64_t a;
+    int64_t b;
+} TCTraceEvent;
+
+/**
+ The ring of events.  The capacity is a power of two, so the slot for an
+ event is the running count masked by capacity - 1.
+ */
+typedef struct {
+    TCTraceEvent * events;
+    unsigned long mask;
+    unsigned long count;
+    int32_t position;
+} TCTraceRing;
+
+/** The ring for the execution running on this thread, or NULL if not tracing */
+extern __thread TCTraceRing * activeTrace;
+
+/**
+ Record a trace event in the active ring.  The caller must check that
+ activeTrace is not NULL first.
+ */
+static inline void traceEvent(TCTraceOp op, int detail, long a, long b)
+{
+    TCTraceEvent * e = activeTrace->events + (activeTrace->count++ & activeTrace->mask);
+    e->op = (uint16_t) op;
+    e->detail = (uint16_t) detail;
+    e->position = activeTrace->position;
+    e->a = a;
+    e->b = b;
+}
+
+/**
+ Record a node event, which also sets the source position that later
+ events are charged to.  Nodes without a position keep the current one.
+ */
+static inline void traceNode(int nodeType, long position)
+{
+    if( position > 0 )
+        activeTrace->position = (int32_t) position;
+    traceEvent(TCTRACE_NODE, nodeType, 0L, 0L);
+}
+
+@interface TCTraceBuffer : NSObject
+
+{
+    /** The ring this buffer owns */
+    TCTraceRing _ring;
+
+    /** Storage for the events in the ring */
+    NSMutableData * _events;
+}
+
+/** The path of the source file, recorded in the trace file for the decoder */
+@property NSString * sourcePath;
+
+/** The file the trace is written to */
+@property NSString * tracePath;
+
+/**
+ Create a trace buffer.
+ @param capacity the number of events to keep, rounded up to a power of two
+ @return a new, empty trace buffer
+ */
+-(instancetype) initWithCapacity:(long) capacity;
+
+/**
+ Make this the active trace, so events are recorded into it.
+ */
+-(void) start;
+
+/**
+ Stop recording events into this trace, if it is the active one.
+ */
+-(void) stop;
+
+/**
+ The trace buffer whose ring is active, or nil if not tracing.
+ */
++(TCTraceBuffer*) current;
+
+/** The total number of events recorded, including those overwritten */
+-(unsigned long) eventCount;
+
+/**
+ Write the events still in the ring to the trace file, oldest first.
+ @return YES if the file was written
+ */
+-(BOOL) write;
+
+/**
+ Write the most recent events, decoded, to a stream.
+ @param file where to write the events
+ @param limit the maximum number of events to write
+ @param scanner the scanner that compiled the program, used to show the
+ source line of each event
+ */
+-(void) dumpTail:(FILE*) file limit:(long) limit scanner:(TCLexicalScanner*) scanner;
+
+/**
+ Decode a trace file written by the write method.
+ @param path the trace file
+ @param sourcePath the program source, or nil to use the path recorded in
+ the trace file
+ @param file where to write the decoded events
+ @return YES if the trace file could be read
+ */
++(BOOL) decodeFile:(NSString*) path source:(NSString*) sourcePath to:(FILE*) file;
+
+@end
@@ -0,0 +1,288 @@
+//
+//  TCTraceBuffer.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCTraceBuffer.h"
+#import "TCSyntaxNode.h"
+#import "TCLexicalScanner.h"
+#import "TCValue.h"
+
+const char * typeName(TCValueType);
+
+__thread TCTraceRing * activeTrace = NULL;
+
+/** The buffer that owns the active ring */
+static __thread __unsafe_unretained TCTraceBuffer * currentBuffer = nil;
+
+/** Identifies a trace file, and the layout of the events in it */
+#define TCTRACE_MAGIC   "TCTR"
+#define TCTRACE_VERSION 1
+
+/**
+ The header at the start of a trace file.  It is followed by the source
+ path (pathLength bytes, no terminator, padded with nulls to a multiple of
+ eight bytes) and then the events, oldest first.
+ */
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t eventSize;
+    uint32_t pathLength;
+    uint64_t total;
+    uint64_t stored;
+} TCTraceHeader;
+
+/** The space the source path takes in the file, keeping the events aligned */
+#define TCTRACE_PATH_SPACE(length) (((length) + 7) & ~7UL)
+
+/**
+ Get the printable name of an event kind.
+ */
+static const char * opName(int op)
+{
+    switch(op) {
+        case TCTRACE_NODE:      return "node";
+        case TCTRACE_CALL:      return "call";
+        case TCTRACE_RETURN:    return "return";
+        case TCTRACE_BUILTIN:   return "builtin";
+        case TCTRACE_READ:      return "read";
+        case TCTRACE_WRITE:     return "write";
+        case TCTRACE_ALLOC:     return "alloc";
+        case TCTRACE_FREE:      return "free";
+        case TCTRACE_ERROR:     return "error";
+        default:                return "?";
+    }
+}
+
+/**
+ Write one event.  The source line is shown whenever it differs from the
+ line of the previous event written.
+ */
+static void writeEvent(FILE * file, unsigned long sequence, const TCTraceEvent * e,
+                       TCLexicalScanner * scanner, long * lastLine)
+{
+    long line = (scanner && e->position > 0) ? [scanner lineNumberAtPosition:e->position] : -1L;
+
+    if( line >= 0 && line != *lastLine ) {
+        NSString * text = [[scanner getLineAtLine:line]
+                           stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+        fprintf(file, "%5ld: %s\n", line + 1, text ? [text UTF8String] : "");
+        *lastLine = line;
+    }
+
+    fprintf(file, "  %10lu  %-8s", sequence, opName(e->op));
+    switch(e->op) {
+        case TCTRACE_NODE:
+            fprintf(file, "%s", [nodeSpelling(e->detail) UTF8String]);
+            break;
+        case TCTRACE_CALL:
+        case TCTRACE_BUILTIN:
+            fprintf(file, "%lld arguments", (long long) e->a);
+            break;
+        case TCTRACE_RETURN:
+            fprintf(file, "%lld", (long long) e->a);
+            break;
+        case TCTRACE_READ:
+        case TCTRACE_WRITE:
+            if( e->detail == TCVALUE_DOUBLE ) {
+                double value;
+                memcpy(&value, &e->b, sizeof(value));
+                fprintf(file, "double at %lld = %g", (long long) e->a, value);
+            } else if( e->detail == TCVALUE_FLOAT ) {
+                int32_t bits = (int32_t) e->b;
+                float value;
+                memcpy(&value, &bits, sizeof(value));
+                fprintf(file, "float at %lld = %g", (long long) e->a, value);
+            } else
+                fprintf(file, "%s at %lld = %lld", typeName(e->detail), (long long) e->a, (long long) e->b);
+            break;
+        case TCTRACE_ALLOC:
+        case TCTRACE_FREE:
+            fprintf(file, "%lld bytes at %lld", (long long) e->b, (long long) e->a);
+            break;
+        case TCTRACE_ERROR:
+            fprintf(file, "code %d", e->detail);
+            break;
+        default:
+            break;
+    }
+    fputc('\n', file);
+}
+
+/**
+ Make a scanner for a program source, so event positions can be mapped
+ to source lines.
+ */
+static TCLexicalScanner * scannerFor(NSString * source)
+{
+    if( source == nil )
+        return nil;
+    TCLexicalScanner * scanner = [[TCLexicalScanner alloc]init];
+    [scanner lex:source];
+    return scanner;
+}
+
+@implementation TCTraceBuffer
+
+#pragma mark - Initialization
+
+-(instancetype) initWithCapacity:(long) capacity
+{
+    if(( self = [super init])) {
+        unsigned long size = 1;
+        while( size < (unsigned long) capacity )
+            size <<= 1;
+
+        _events = [NSMutableData dataWithLength:size * sizeof(TCTraceEvent)];
+        _ring.events = _events.mutableBytes;
+        _ring.mask = size - 1;
+        _ring.count = 0;
+        _ring.position = 0;
+    }
+    return self;
+}
+
+-(void) dealloc
+{
+    [self stop];
+}
+
+-(void) start
+{
+    currentBuffer = self;
+    activeTrace = &_ring;
+}
+
+-(void) stop
+{
+    if( activeTrace == &_ring ) {
+        activeTrace = NULL;
+        currentBuffer = nil;
+    }
+}
+
++(TCTraceBuffer*) current
+{
+    return currentBuffer;
+}
+
+-(unsigned long) eventCount
+{
+    return _ring.count;
+}
+
+#pragma mark - Output
+
+/**
+ Get the number of events still in the ring, and the sequence number of
+ the oldest of them.
+ */
+-(unsigned long) stored:(unsigned long*) first
+{
+    unsigned long capacity = _ring.mask + 1;
+    unsigned long stored = _ring.count < capacity ? _ring.count : capacity;
+    *first = _ring.count - stored;
+    return stored;
+}
+
+-(BOOL) write
+{
+    if( _tracePath == nil )
+        return NO;
+
+    FILE * file = fopen([_tracePath fileSystemRepresentation], "wb");
+    if( file == NULL )
+        return NO;
+
+    const char * path = _sourcePath ? [_sourcePath fileSystemRepresentation] : "";
+    unsigned long first = 0;
+
+    TCTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TCTRACE_MAGIC, 4);
+    header.version = TCTRACE_VERSION;
+    header.eventSize = sizeof(TCTraceEvent);
+    header.pathLength = (uint32_t) strlen(path);
+    header.total = _ring.count;
+    header.stored = [self stored:&first];
+
+    static const char padding[8] = { 0 };
+    unsigned long pad = TCTRACE_PATH_SPACE(header.pathLength) - header.pathLength;
+    BOOL ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(path, 1, header.pathLength, file) == header.pathLength &&
+              fwrite(padding, 1, pad, file) == pad;
+
+    // The ring is written in at most two pieces: from the oldest event to
+    // the end of the buffer, then from the start of the buffer.
+
+    unsigned long start = first & _ring.mask;
+    unsigned long tail = _ring.mask + 1 - start;
+    if( tail > header.stored )
+        tail = header.stored;
+    if( ok )
+        ok = fwrite(_ring.events + start, sizeof(TCTraceEvent), tail, file) == tail;
+    if( ok && header.stored > tail )
+        ok = fwrite(_ring.events, sizeof(TCTraceEvent), header.stored - tail, file) == header.stored - tail;
+
+    return fclose(file) == 0 && ok;
+}
+
+-(void) dumpTail:(FILE *)file limit:(long)limit scanner:(TCLexicalScanner *)scanner
+{
+    unsigned long first = 0;
+    unsigned long stored = [self stored:&first];
+    if( limit >= 0 && stored > (unsigned long) limit ) {
+        first += stored - limit;
+        stored = limit;
+    }
+
+    long lastLine = -1L;
+    for( unsigned long seq = first; seq < first + stored; seq++ )
+        writeEvent(file, seq, _ring.events + (seq & _ring.mask), scanner, &lastLine);
+}
+
++(BOOL) decodeFile:(NSString *)path source:(NSString *)sourcePath to:(FILE *)file
+{
+    NSData * data = [NSData dataWithContentsOfFile:path];
+    if( data == nil || data.length < sizeof(TCTraceHeader))
+        return NO;
+
+    const TCTraceHeader * header = data.bytes;
+    if( memcmp(header->magic, TCTRACE_MAGIC, 4) != 0 ||
+        header->version != TCTRACE_VERSION ||
+        header->eventSize != sizeof(TCTraceEvent) ||
+        data.length < sizeof(TCTraceHeader) + TCTRACE_PATH_SPACE(header->pathLength) +
+                      header->stored * sizeof(TCTraceEvent))
+        return NO;
+
+    const char * bytes = data.bytes;
+    if( sourcePath == nil && header->pathLength > 0 )
+        sourcePath = [[NSString alloc]initWithBytes:bytes + sizeof(TCTraceHeader)
+                                             length:header->pathLength
+                                           encoding:NSUTF8StringEncoding];
+
+    NSString * source = nil;
+    if( sourcePath != nil ) {
+        source = [NSString stringWithContentsOfFile:sourcePath encoding:NSUTF8StringEncoding error:nil];
+        if( source == nil )
+            fprintf(stderr, "TRACE: unable to read source %s; lines not shown\n", [sourcePath UTF8String]);
+    }
+
+    fprintf(file, "%llu events recorded, last %llu kept\n",
+            (unsigned long long) header->total, (unsigned long long) header->stored);
+
+    TCLexicalScanner * scanner = scannerFor(source);
+    const TCTraceEvent * events = (const TCTraceEvent*)(bytes + sizeof(TCTraceHeader) +
+                                                        TCTRACE_PATH_SPACE(header->pathLength));
+    unsigned long first = header->total - header->stored;
+    long lastLine = -1L;
+    for( unsigned long ix = 0; ix < header->stored; ix++ )
+        writeEvent(file, first + ix, events + ix, scanner, &lastLine);
+    return YES;
+}
+
+@end
@@ -20,6 +20,7 @@
     if([scanner isNextToken:TOKEN_DECL_INT] ||
        [scanner isNextToken:TOKEN_DECL_LONG] ||
        [scanner isNextToken:TOKEN_DECL_DOUBLE] ||
+       [scanner isNextToken:TOKEN_DECL_FLOAT] ||
        [scanner isNextToken:TOKEN_DECL_VOID] ||
        [scanner isNextToken:TOKEN_DECL_CHAR]) {
         
@@ -34,6 +35,10 @@
                 decl.action = TCVALUE_DOUBLE;
                 break;
                 
+            case TOKEN_DECL_FLOAT:
+                decl.action = TCVALUE_FLOAT;
+                break;
+                
             case TOKEN_DECL_INT:
                 decl.action = TCVALUE_INT;
                 break;
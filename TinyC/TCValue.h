@@ -77,7 +77,10 @@ typedef enum {
     /** The scalar value when it is a long value */
     long        longValue;
     
-    /** The scalar value when it is a float or double value */
+    /** The scalar value when it is a float value */
+    float       floatValue;
+    
+    /** The scalar value when it is a double value */
     double      doubleValue;
     
     /** The value when it is a compiler-generated string constant */
@@ -108,6 +111,15 @@ typedef enum {
  */
 -(instancetype)initWithDouble:(double) value;
 
+/**
+ Create a new instance of a TCValue of type float with the supplied
+ initial value.
+ 
+    @param value the float to store in the runtime value
+    @return the initialized instance of the value
+ */
+-(instancetype)initWithFloat:(float) value;
+
 /**
  Create a new instance of a TCValue of type string with the supplied
  initial value.
@@ -185,6 +197,22 @@ typedef enum {
  */
 -(TCValue *) makePointer:(TCValueType)ofType;
 
+/**
+ Replace the scalar held by this value without changing its type.  This
+ lets a caller that makes the same call many times reuse its argument
+ values rather than create new ones on every call.
+ 
+ @param value the new value, converted to the type of this item
+ */
+-(void) assignLong:(long) value;
+
+/**
+ Replace the scalar held by this value without changing its type.
+ 
+ @param value the new value, converted to the type of this item
+ */
+-(void) assignDouble:(double) value;
+
 
 #pragma mark - Basic math
 /**
@@ -309,6 +337,14 @@ typedef enum {
 -(double)getDouble;
 
 
+/**
+ Get the float value stored in this type.
+ 
+    @return The value, cast to a float
+ */
+-(float)getFloat;
+
+
 /**
  Get the string value of the item stored in this type.
  
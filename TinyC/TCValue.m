@@ -118,6 +118,8 @@ typedef struct {
             return longValue;
             
         case TCVALUE_FLOAT:
+            return (long) floatValue;
+            
         case TCVALUE_DOUBLE:
             return (long) doubleValue;
             
@@ -142,6 +144,8 @@ typedef struct {
             return (double)longValue;
             
         case TCVALUE_FLOAT:
+            return (double)floatValue;
+            
         case TCVALUE_DOUBLE:
             return doubleValue;
             
@@ -153,6 +157,32 @@ typedef struct {
     }
 }
 
+-(float)getFloat
+{
+    
+    switch([self getType]) {
+            
+        case TCVALUE_CHAR:
+        case TCVALUE_INT:
+            return (float)intValue;
+            
+        case TCVALUE_LONG:
+            return (float)longValue;
+            
+        case TCVALUE_FLOAT:
+            return floatValue;
+            
+        case TCVALUE_DOUBLE:
+            return (float)doubleValue;
+            
+        case TCVALUE_STRING:
+            return [stringValue floatValue];
+            
+        default:
+            return 0;
+    }
+}
+
 
 -(NSString *)getString
 {
@@ -171,6 +201,8 @@ typedef struct {
             return [NSString stringWithFormat:@"%ld", longValue];
             
         case TCVALUE_FLOAT:
+            return [NSString stringWithFormat:@"%f", (double) floatValue];
+            
         case TCVALUE_DOUBLE:
             return [NSString stringWithFormat:@"%f", doubleValue];
             
@@ -235,6 +267,15 @@ typedef struct {
     return self;
 }
 
+-(instancetype) initWithFloat:(float) value
+{
+    if((self = [super self])) {
+        type = TCVALUE_FLOAT;
+        floatValue = value;
+    }
+    return self;
+}
+
 #pragma mark - Conversions
 
 /**
@@ -249,6 +290,47 @@ typedef struct {
 }
 
 
+-(void) assignLong:(long) value
+{
+    if( type > TCVALUE_POINTER ) {
+        longValue = value;
+        return;
+    }
+    switch(type) {
+        case TCVALUE_CHAR:
+            intValue = (char) value;
+            break;
+        case TCVALUE_BOOLEAN:
+        case TCVALUE_INT:
+            intValue = (int) value;
+            break;
+        case TCVALUE_FLOAT:
+            floatValue = (float) value;
+            break;
+        case TCVALUE_DOUBLE:
+            doubleValue = (double) value;
+            break;
+        default:
+            longValue = value;
+            break;
+    }
+}
+
+-(void) assignDouble:(double) value
+{
+    switch(type) {
+        case TCVALUE_FLOAT:
+            floatValue = (float) value;
+            break;
+        case TCVALUE_DOUBLE:
+            doubleValue = value;
+            break;
+        default:
+            [self assignLong:(long) value];
+            break;
+    }
+}
+
 -(TCValue*) castTo:(TCValueType)newType
 {
     
@@ -276,6 +358,9 @@ typedef struct {
                 case TCVALUE_LONG:
                     return [[TCValue alloc]initWithChar:(char)self.getLong];
                     
+                case TCVALUE_FLOAT:
+                    return [[TCValue alloc]initWithChar:(char)floatValue];
+                    
                 case TCVALUE_DOUBLE:
                     return [[TCValue alloc]initWithChar:(char)doubleValue];
                     
@@ -296,6 +381,9 @@ typedef struct {
                 case TCVALUE_LONG:
                     return [[TCValue alloc]initWithInt:(int)self.getLong];
                     
+                case TCVALUE_FLOAT:
+                    return [[TCValue alloc]initWithInt:floatValue];
+                    
                 case TCVALUE_DOUBLE:
                     return [[TCValue alloc]initWithInt:doubleValue];
                     
@@ -316,6 +404,9 @@ typedef struct {
                 case TCVALUE_LONG:
                     return [[TCValue alloc]initWithLong:self.getLong];
 
+                case TCVALUE_FLOAT:
+                    return [[TCValue alloc]initWithLong:floatValue];
+                    
                 case TCVALUE_DOUBLE:
                     return [[TCValue alloc]initWithLong:doubleValue];
                     
@@ -327,6 +418,23 @@ typedef struct {
                     return nil;
             }
             
+        case TCVALUE_FLOAT:
+            switch([self getType]) {
+                case TCVALUE_CHAR:
+                case TCVALUE_INT:
+                    return [[TCValue alloc]initWithFloat:(float) intValue];
+                case TCVALUE_LONG:
+                    return [[TCValue alloc]initWithFloat:(float) longValue];
+                case TCVALUE_DOUBLE:
+                    return [[TCValue alloc]initWithFloat:(float) doubleValue];
+                case TCVALUE_STRING:
+                    return [[TCValue alloc]initWithFloat:[stringValue floatValue]];
+                default:
+                    NSLog(@"Unsupported conversion of TCValue from %d", newType);
+                    return nil;
+                    
+            }
+            
         case TCVALUE_DOUBLE:
             switch([self getType]) {
                 case TCVALUE_CHAR:
@@ -334,6 +442,8 @@ typedef struct {
                     return [[TCValue alloc]initWithDouble:(double) intValue];
                 case TCVALUE_LONG:
                     return [[TCValue alloc]initWithDouble:(double) longValue];
+                case TCVALUE_FLOAT:
+                    return [[TCValue alloc]initWithDouble:(double) floatValue];
                 case TCVALUE_STRING:
                     return [[TCValue alloc]initWithDouble:[stringValue doubleValue]];
                 default:
@@ -350,6 +460,8 @@ typedef struct {
                     return [[TCValue alloc]initWithString:[NSString stringWithFormat:@"%d", intValue]];
                 case TCVALUE_LONG:
                     return [[TCValue alloc]initWithString:[NSString stringWithFormat:@"%ld", longValue]];
+                case TCVALUE_FLOAT:
+                    return [[TCValue alloc]initWithString:[NSString stringWithFormat:@"%f", (double) floatValue]];
                 case TCVALUE_DOUBLE:
                     return [[TCValue alloc]initWithString:[NSString stringWithFormat:@"%f", doubleValue]];
                     
@@ -400,6 +512,8 @@ typedef struct {
             return [[TCValue alloc]initWithInt:([self getInt] + [value getInt])];
         case TCVALUE_LONG:
             return [[TCValue alloc]initWithLong:([self getLong] + [value getLong])];
+        case TCVALUE_FLOAT:
+            return [[TCValue alloc]initWithFloat:([self getFloat] + [value getFloat])];
         case TCVALUE_DOUBLE:
             return [[TCValue alloc]initWithDouble:([self getDouble] + [value getDouble])];
             
@@ -429,6 +543,8 @@ typedef struct {
             return [[TCValue alloc]initWithInt:([self getInt] - [value getInt])];
         case TCVALUE_LONG:
             return [[TCValue alloc]initWithLong:([self getLong] - [value getLong])];
+        case TCVALUE_FLOAT:
+            return [[TCValue alloc]initWithFloat:([self getFloat] - [value getFloat])];
         case TCVALUE_DOUBLE:
             return [[TCValue alloc]initWithDouble:([self getDouble] - [value getDouble])];
             
@@ -460,6 +576,8 @@ typedef struct {
             return [[TCValue alloc]initWithInt:([self getInt] * [value getInt])];
         case TCVALUE_LONG:
             return [[TCValue alloc]initWithLong:([self getLong] * [value getLong])];
+        case TCVALUE_FLOAT:
+            return [[TCValue alloc]initWithFloat:([self getFloat] * [value getFloat])];
         case TCVALUE_DOUBLE:
             return [[TCValue alloc]initWithDouble:([self getDouble] * [value getDouble])];
             
@@ -515,6 +633,8 @@ typedef struct {
             }
             return [[TCValue alloc]initWithLong:(v1/v2)];
         }
+        case TCVALUE_FLOAT:
+            return [[TCValue alloc]initWithFloat:([self getFloat] / [value getFloat])];
         case TCVALUE_DOUBLE:
             return [[TCValue alloc]initWithDouble:([self getDouble] / [value getDouble])];
             
@@ -562,6 +682,8 @@ typedef struct {
             }
             return [[TCValue alloc]initWithLong:(v1 % v2)];
         }
+        case TCVALUE_FLOAT:
+            return [[TCValue alloc]initWithFloat:(fmodf([self getFloat], [value getFloat]))];
         case TCVALUE_DOUBLE:
             return [[TCValue alloc]initWithDouble:(fmod([self getDouble], [value getDouble]))];
             
@@ -611,6 +733,7 @@ typedef struct {
             else return 0;
         }
             
+        case TCVALUE_FLOAT:
         case TCVALUE_DOUBLE:
         {
             double d = [self getDouble] - [value getDouble];
@@ -640,6 +763,9 @@ typedef struct {
         case TCVALUE_LONG:
             return [[TCValue alloc] initWithLong:(-[self getLong])];
             
+        case TCVALUE_FLOAT:
+            return [[TCValue alloc] initWithFloat:(-[self getFloat])];
+            
         case TCVALUE_DOUBLE:
             return [[TCValue alloc] initWithDouble:(-[self getDouble])];
             
@@ -661,6 +787,7 @@ typedef struct {
         case TCVALUE_LONG:
             return [[TCValue alloc] initWithInt:(![self getLong])];
             
+        case TCVALUE_FLOAT:
         case TCVALUE_DOUBLE:
         {
             int result;
@@ -0,0 +1,17 @@
+//
+//  TCarray_axpyFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_axpy(a, x, y, n) adds a * x[i] to y[i] for each of n elements, and
+//  returns y.  Both arrays must have the same element type.  For integer
+//  arrays a is converted to an integer first.
+
+#import "TCArrayFunction.h"
+
+@interface TCarray_axpyFunction : TCArrayFunction
+
+@end
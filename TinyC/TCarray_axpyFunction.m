@@ -0,0 +1,51 @@
+//
+//  TCarray_axpyFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_axpyFunction.h"
+
+@implementation TCarray_axpyFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 4 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long count = [arguments[3] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    TCValueType yType = TCVALUE_UNDEFINED;
+    const void * xBase = [self elementsOf:arguments[1] count:count type:&type forWrite:NO argument:2];
+    if( xBase == NULL )
+        return nil;
+    void * yBase = [self elementsOf:arguments[2] count:count type:&yType forWrite:YES argument:3];
+    if( yBase == NULL )
+        return nil;
+    if( yType != type ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:3]];
+        return nil;
+    }
+    
+    // Each element is independent unless the arrays overlap, in which case
+    // the loop still runs in order like the interpreted version would.
+    
+    double realFactor = [arguments[0] getDouble];
+    long intFactor = [arguments[0] getLong];
+    TCARRAY_DISPATCH(type, {
+        const T * x = xBase;
+        T * y = yBase;
+        const T factor = REAL ? (T) realFactor : (T) intFactor;
+        for( long ix = 0; ix < count; ix++ )
+            y[ix] += factor * x[ix];
+    })
+    return arguments[2];
+}
+@end
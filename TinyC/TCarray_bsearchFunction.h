@@ -0,0 +1,17 @@
+//
+//  TCarray_bsearchFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_bsearch(p, n, key) searches the n sorted int, long, float or
+//  double elements at p for key.  It returns the index of the first element
+//  equal to key, or -1 if there is none.
+
+#import "TCSortFunction.h"
+
+@interface TCarray_bsearchFunction : TCSortFunction
+
+@end
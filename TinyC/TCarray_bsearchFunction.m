@@ -0,0 +1,45 @@
+//
+//  TCarray_bsearchFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_bsearchFunction.h"
+
+@implementation TCarray_bsearchFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    long count = [arguments[1] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    const void * base = [self elementsOf:arguments[0] count:count type:&type forWrite:NO argument:1];
+    if( base == NULL )
+        return nil;
+
+    long found = -1L;
+    TCValue * key = arguments[2];
+    TCARRAY_DISPATCH(type, {
+        const T * a = base;
+        A k = REAL ? (A) key.getDouble : (A) key.getLong;
+        long lo = 0, hi = count;
+        while( lo < hi ) {
+            long mid = lo + (hi - lo) / 2;
+            if( a[mid] < k )
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if( lo < count && a[lo] == k )
+            found = lo;
+    })
+    return [[TCValue alloc]initWithLong:found];
+}
+@end
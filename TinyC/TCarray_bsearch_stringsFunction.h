@@ -0,0 +1,17 @@
+//
+//  TCarray_bsearch_stringsFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_bsearch_strings(p, n, key) searches an array of n char* strings,
+//  sorted by array_sort_strings, for the string key.  It returns the index
+//  of the first match, or -1 if there is none.
+
+#import "TCSortFunction.h"
+
+@interface TCarray_bsearch_stringsFunction : TCSortFunction
+
+@end
@@ -0,0 +1,41 @@
+//
+//  TCarray_bsearch_stringsFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_bsearch_stringsFunction.h"
+
+@implementation TCarray_bsearch_stringsFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    long count = [arguments[1] getLong];
+    const char * key = [self cString:arguments[2]];
+    if( key == NULL )
+        return nil;
+    TCSortString * items = [self stringsOf:arguments[0] count:count argument:1];
+    if( items == NULL )
+        return nil;
+
+    long lo = 0, hi = count;
+    while( lo < hi ) {
+        long mid = lo + (hi - lo) / 2;
+        if( strcmp(items[mid].text, key) < 0 )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    long found = lo < count && strcmp(items[lo].text, key) == 0 ? lo : -1L;
+    free(items);
+    return [[TCValue alloc]initWithLong:found];
+}
+@end
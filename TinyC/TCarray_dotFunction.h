@@ -0,0 +1,16 @@
+//
+//  TCarray_dotFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_dot(x, y, n) returns the sum of x[i] * y[i] over n elements.  Both
+//  arrays must have the same element type.
+
+#import "TCArrayFunction.h"
+
+@interface TCarray_dotFunction : TCArrayFunction
+
+@end
@@ -0,0 +1,57 @@
+//
+//  TCarray_dotFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_dotFunction.h"
+
+@implementation TCarray_dotFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long count = [arguments[2] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    TCValueType otherType = TCVALUE_UNDEFINED;
+    const void * xBase = [self elementsOf:arguments[0] count:count type:&type forWrite:NO argument:1];
+    if( xBase == NULL )
+        return nil;
+    const void * yBase = [self elementsOf:arguments[1] count:count type:&otherType forWrite:NO argument:2];
+    if( yBase == NULL )
+        return nil;
+    if( otherType != type ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:2]];
+        return nil;
+    }
+    
+    long integer = 0L;
+    double real = 0.0;
+    TCARRAY_DISPATCH(type, {
+        const T * x = xBase;
+        const T * y = yBase;
+        A s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        long ix = 0;
+        for( ; ix + 4 <= count; ix += 4 ) {
+            s0 += (A) x[ix] * y[ix];
+            s1 += (A) x[ix + 1] * y[ix + 1];
+            s2 += (A) x[ix + 2] * y[ix + 2];
+            s3 += (A) x[ix + 3] * y[ix + 3];
+        }
+        for( ; ix < count; ix++ )
+            s0 += (A) x[ix] * y[ix];
+        integer = (long)((s0 + s1) + (s2 + s3));
+        real = (double)((s0 + s1) + (s2 + s3));
+    })
+    return [self resultFor:type integer:integer real:real];
+}
+@end
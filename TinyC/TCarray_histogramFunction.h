@@ -0,0 +1,18 @@
+//
+//  TCarray_histogramFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_histogram(counts, bins, p, n, lo, hi) counts the n elements at p
+//  into bins equal-width buckets covering lo to hi, adding to the int or
+//  long array counts.  A value equal to hi goes in the last bucket; values
+//  outside the range are not counted.  Returns the number counted.
+
+#import "TCArrayFunction.h"
+
+@interface TCarray_histogramFunction : TCArrayFunction
+
+@end
@@ -0,0 +1,72 @@
+//
+//  TCarray_histogramFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_histogramFunction.h"
+
+@implementation TCarray_histogramFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 6 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long bins = [arguments[1] getLong];
+    long count = [arguments[3] getLong];
+    double lo = [arguments[4] getDouble];
+    double hi = [arguments[5] getDouble];
+    
+    TCValueType countType = TCVALUE_UNDEFINED;
+    TCValueType type = TCVALUE_UNDEFINED;
+    void * countBase = [self elementsOf:arguments[0] count:bins type:&countType forWrite:YES argument:1];
+    if( countBase == NULL )
+        return nil;
+    if( countType != TCVALUE_INT && countType != TCVALUE_LONG ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:1]];
+        return nil;
+    }
+    const void * base = [self elementsOf:arguments[2] count:count type:&type forWrite:NO argument:3];
+    if( base == NULL )
+        return nil;
+    if( bins == 0 || !(hi > lo) )
+        return [[TCValue alloc]initWithLong:0L];
+    
+    // Work out every bucket number first, in a loop with no stores to the
+    // counts, then add them up.  The first loop is the one that vectorizes.
+    
+    double width = (double) bins / (hi - lo);
+    long counted = 0L;
+    long bucket[256];
+    for( long start = 0; start < count; start += 256 ) {
+        long chunk = MIN(256L, count - start);
+        TCARRAY_DISPATCH(type, {
+            const T * a = (const T*) base + start;
+            for( long ix = 0; ix < chunk; ix++ ) {
+                double v = (double) a[ix];
+                long b = (v >= lo && v <= hi) ? (long)((v - lo) * width) : -1L;
+                bucket[ix] = b < bins ? b : bins - 1;
+            }
+        })
+        for( long ix = 0; ix < chunk; ix++ ) {
+            long b = bucket[ix];
+            if( b < 0 )
+                continue;
+            if( countType == TCVALUE_INT )
+                ((int*) countBase)[b]++;
+            else
+                ((long*) countBase)[b]++;
+            counted++;
+        }
+    }
+    return [[TCValue alloc]initWithLong:counted];
+}
+@end
@@ -0,0 +1,15 @@
+//
+//  TCarray_minFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_min(p, n) returns the smallest of the n elements at p, or zero if n is zero.
+
+#import "TCArrayFunction.h"
+
+@interface TCarray_minFunction : TCArrayFunction
+
+@end
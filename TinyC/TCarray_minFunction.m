@@ -0,0 +1,53 @@
+//
+//  TCarray_minFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_minFunction.h"
+
+@implementation TCarray_minFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long count = [arguments[1] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    const void * base = [self elementsOf:arguments[0] count:count type:&type forWrite:NO argument:1];
+    if( base == NULL )
+        return nil;
+    if( count == 0 )
+        return [self resultFor:type integer:0L real:0.0];
+    
+    // Keep four running results, one per lane, and combine them at the end.
+    
+    long integer = 0L;
+    double real = 0.0;
+    TCARRAY_DISPATCH(type, {
+        const T * a = base;
+        T m0 = a[0], m1 = a[0], m2 = a[0], m3 = a[0];
+        long ix = 0;
+        for( ; ix + 4 <= count; ix += 4 ) {
+            m0 = a[ix] < m0 ? a[ix] : m0;
+            m1 = a[ix + 1] < m1 ? a[ix + 1] : m1;
+            m2 = a[ix + 2] < m2 ? a[ix + 2] : m2;
+            m3 = a[ix + 3] < m3 ? a[ix + 3] : m3;
+        }
+        for( ; ix < count; ix++ )
+            m0 = a[ix] < m0 ? a[ix] : m0;
+        m0 = m1 < m0 ? m1 : m0;
+        m0 = m2 < m0 ? m2 : m0;
+        m0 = m3 < m0 ? m3 : m0;
+        integer = (long) m0;
+        real = (double) m0;
+    })
+    return [self resultFor:type integer:integer real:real];
+}
+@end
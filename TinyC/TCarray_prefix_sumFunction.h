@@ -0,0 +1,18 @@
+//
+//  TCarray_prefix_sumFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_prefix_sum(dest, src, n) stores the running total of the n elements
+//  at src into dest, so dest[i] is src[0] + ... + src[i], and returns the
+//  total.  dest and src must have the same element type and may be the same
+//  array.
+
+#import "TCArrayFunction.h"
+
+@interface TCarray_prefix_sumFunction : TCArrayFunction
+
+@end
@@ -0,0 +1,55 @@
+//
+//  TCarray_prefix_sumFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_prefix_sumFunction.h"
+
+@implementation TCarray_prefix_sumFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long count = [arguments[2] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    TCValueType srcType = TCVALUE_UNDEFINED;
+    void * destBase = [self elementsOf:arguments[0] count:count type:&type forWrite:YES argument:1];
+    if( destBase == NULL )
+        return nil;
+    const void * srcBase = [self elementsOf:arguments[1] count:count type:&srcType forWrite:NO argument:2];
+    if( srcBase == NULL )
+        return nil;
+    if( srcType != type ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:2]];
+        return nil;
+    }
+    
+    // Each total depends on the one before, so this is a plain loop; it is
+    // still native code with no per-element interpretation.
+    
+    long integer = 0L;
+    double real = 0.0;
+    TCARRAY_DISPATCH(type, {
+        T * dest = destBase;
+        const T * src = srcBase;
+        T total = 0;
+        for( long ix = 0; ix < count; ix++ ) {
+            total += src[ix];
+            dest[ix] = total;
+        }
+        integer = (long) total;
+        real = (double) total;
+    })
+    return [self resultFor:type integer:integer real:real];
+}
+@end
@@ -0,0 +1,17 @@
+//
+//  TCarray_scaleFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_scale(p, n, a) multiplies each of the n elements at p by a, in
+//  place, and returns p.  For an integer array a is converted to an
+//  integer first.
+
+#import "TCArrayFunction.h"
+
+@interface TCarray_scaleFunction : TCArrayFunction
+
+@end
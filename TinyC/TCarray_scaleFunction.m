@@ -0,0 +1,37 @@
+//
+//  TCarray_scaleFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_scaleFunction.h"
+
+@implementation TCarray_scaleFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long count = [arguments[1] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    void * base = [self elementsOf:arguments[0] count:count type:&type forWrite:YES argument:1];
+    if( base == NULL )
+        return nil;
+    
+    double realFactor = [arguments[2] getDouble];
+    long intFactor = [arguments[2] getLong];
+    TCARRAY_DISPATCH(type, {
+        T * a = base;
+        const T factor = REAL ? (T) realFactor : (T) intFactor;
+        for( long ix = 0; ix < count; ix++ )
+            a[ix] *= factor;
+    })
+    return arguments[0];
+}
+@end
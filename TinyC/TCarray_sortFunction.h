@@ -0,0 +1,16 @@
+//
+//  TCarray_sortFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_sort(p, n) sorts the n int, long, float or double elements at p
+//  into ascending order, in place.
+
+#import "TCSortFunction.h"
+
+@interface TCarray_sortFunction : TCSortFunction
+
+@end
@@ -0,0 +1,30 @@
+//
+//  TCarray_sortFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_sortFunction.h"
+
+@implementation TCarray_sortFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    long count = [arguments[1] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    void * base = [self elementsOf:arguments[0] count:count type:&type forWrite:YES argument:1];
+    if( base == NULL )
+        return nil;
+    if( ![self sort:base count:count type:type] )
+        return nil;
+    return [[TCValue alloc]initWithLong:count];
+}
+@end
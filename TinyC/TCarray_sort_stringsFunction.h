@@ -0,0 +1,17 @@
+//
+//  TCarray_sort_stringsFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_sort_strings(p, n) sorts an array of n char* strings into strcmp()
+//  order, in place.  The array is declared as long, since it holds the
+//  addresses of the strings; the strings themselves are not moved.
+
+#import "TCSortFunction.h"
+
+@interface TCarray_sort_stringsFunction : TCSortFunction
+
+@end
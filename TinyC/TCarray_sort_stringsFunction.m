@@ -0,0 +1,35 @@
+//
+//  TCarray_sort_stringsFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_sort_stringsFunction.h"
+
+@implementation TCarray_sort_stringsFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    long count = [arguments[1] getLong];
+    TCSortString * items = [self stringsOf:arguments[0] count:count argument:1];
+    if( items == NULL )
+        return nil;
+    long * addresses = (long*)[self pointerTo:[arguments[0] getLong] count:count size:sizeof(long) forWrite:YES];
+    if( addresses == NULL || ![self sortStrings:items count:count] ) {
+        free(items);
+        return nil;
+    }
+    for( long ix = 0; ix < count; ix++ )
+        addresses[ix] = items[ix].address;
+    free(items);
+    return [[TCValue alloc]initWithLong:count];
+}
+@end
@@ -0,0 +1,16 @@
+//
+//  TCarray_sumFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  array_sum(p, n) returns the sum of the n elements at p, as a long for an
+//  int or long array and as a double for a float or double array.
+
+#import "TCArrayFunction.h"
+
+@interface TCarray_sumFunction : TCArrayFunction
+
+@end
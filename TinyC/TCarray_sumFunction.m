@@ -0,0 +1,49 @@
+//
+//  TCarray_sumFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCarray_sumFunction.h"
+
+@implementation TCarray_sumFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long count = [arguments[1] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    const void * base = [self elementsOf:arguments[0] count:count type:&type forWrite:NO argument:1];
+    if( base == NULL )
+        return nil;
+    
+    // Four independent partial sums break the chain of dependent adds, so
+    // the loop can be spread across vector lanes.
+    
+    long integer = 0L;
+    double real = 0.0;
+    TCARRAY_DISPATCH(type, {
+        const T * a = base;
+        A s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        long ix = 0;
+        for( ; ix + 4 <= count; ix += 4 ) {
+            s0 += a[ix];
+            s1 += a[ix + 1];
+            s2 += a[ix + 2];
+            s3 += a[ix + 3];
+        }
+        for( ; ix < count; ix++ )
+            s0 += a[ix];
+        integer = (long)((s0 + s1) + (s2 + s3));
+        real = (double)((s0 + s1) + (s2 + s3));
+    })
+    return [self resultFor:type integer:integer real:real];
+}
+@end
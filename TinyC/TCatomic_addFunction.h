@@ -0,0 +1,16 @@
+//
+//  TCatomic_addFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  atomic_add(p, v) adds v to the int or long at p atomically, and returns
+//  the value it held before.
+
+#import "TCAtomicFunction.h"
+
+@interface TCatomic_addFunction : TCAtomicFunction
+
+@end
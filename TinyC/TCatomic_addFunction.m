@@ -0,0 +1,22 @@
+//
+//  TCatomic_addFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCatomic_addFunction.h"
+
+@implementation TCatomic_addFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    return [self perform:TCATOMIC_ADD arguments:arguments];
+}
+@end
@@ -0,0 +1,17 @@
+//
+//  TCatomic_casFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  atomic_cas(p, expected, desired) stores desired in the int or long at p
+//  if it holds expected, all atomically, and returns the value it held
+//  before; the store happened if that equals expected.
+
+#import "TCAtomicFunction.h"
+
+@interface TCatomic_casFunction : TCAtomicFunction
+
+@end
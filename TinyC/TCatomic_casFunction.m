@@ -0,0 +1,22 @@
+//
+//  TCatomic_casFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCatomic_casFunction.h"
+
+@implementation TCatomic_casFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    return [self perform:TCATOMIC_CAS arguments:arguments];
+}
+@end
@@ -0,0 +1,15 @@
+//
+//  TCatomic_loadFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  atomic_load(p) returns the int or long at p, read atomically.
+
+#import "TCAtomicFunction.h"
+
+@interface TCatomic_loadFunction : TCAtomicFunction
+
+@end
@@ -0,0 +1,16 @@
+//
+//  TCatomic_storeFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  atomic_store(p, v) stores v in the int or long at p atomically, and
+//  returns v.
+
+#import "TCAtomicFunction.h"
+
+@interface TCatomic_storeFunction : TCAtomicFunction
+
+@end
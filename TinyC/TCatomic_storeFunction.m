@@ -0,0 +1,22 @@
+//
+//  TCatomic_storeFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCatomic_storeFunction.h"
+
+@implementation TCatomic_storeFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    return [self perform:TCATOMIC_STORE arguments:arguments];
+}
+@end
@@ -0,0 +1,17 @@
+//
+//  TCbsearchFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  bsearch(key, base, n, size, "compare") searches n sorted elements of size
+//  bytes at base, calling compare(key, element) as in C.  It returns a
+//  pointer to a matching element, or 0 if there is none.
+
+#import "TCSortFunction.h"
+
+@interface TCbsearchFunction : TCSortFunction
+
+@end
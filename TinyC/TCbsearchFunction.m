@@ -0,0 +1,67 @@
+//
+//  TCbsearchFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCbsearchFunction.h"
+
+@implementation TCbsearchFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 5 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCValue * key = arguments[0];
+    long address = [arguments[1] getLong];
+    long count = [arguments[2] getLong];
+    long size = [arguments[3] getLong];
+    if( count < 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARRAY_BOUNDS
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithLong:count]];
+        return nil;
+    }
+    if( size <= 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:4]];
+        return nil;
+    }
+
+    // Once the whole array is known to be in storage, every element
+    // address fits in a long.
+
+    if( [self pointerTo:address count:count size:size forWrite:NO] == NULL )
+        return nil;
+    TCSyntaxNode * entry = [self comparator:arguments[4]];
+    if( entry == nil )
+        return nil;
+
+    TCValueType type = [arguments[1] getType];
+    type = type > TCVALUE_POINTER ? type - TCVALUE_POINTER : TCVALUE_CHAR;
+
+    BOOL failed = NO;
+    long lo = 0, hi = count;
+    while( lo < hi ) {
+        long mid = lo + (hi - lo) / 2;
+        TCValue * element = [[[TCValue alloc]initWithLong:address + mid * size] makePointer:type];
+        long order = [self compare:entry left:key right:element inContext:context failed:&failed];
+        if( failed )
+            return nil;
+        if( order == 0 )
+            return element;
+        if( order < 0 )
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return [[[TCValue alloc]initWithLong:0L] makePointer:type];
+}
+@end
@@ -0,0 +1,16 @@
+//
+//  TCcoroutine_doneFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  coroutine_done(co) returns 1 if the coroutine's function has returned,
+//  so that it cannot be resumed again, and 0 if it can.
+
+#import "TCCoroutineFunction.h"
+
+@interface TCcoroutine_doneFunction : TCCoroutineFunction
+
+@end
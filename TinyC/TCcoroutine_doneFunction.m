@@ -0,0 +1,26 @@
+//
+//  TCcoroutine_doneFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCcoroutine_doneFunction.h"
+
+@implementation TCcoroutine_doneFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCCoroutine * coroutine = [self coroutineFor:arguments[0]];
+    if( coroutine == nil )
+        return nil;
+    return [[TCValue alloc]initWithInt:coroutine.done ? 1 : 0];
+}
+@end
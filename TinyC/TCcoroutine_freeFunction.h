@@ -0,0 +1,17 @@
+//
+//  TCcoroutine_freeFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  coroutine_free(co) releases a coroutine and its storage.  A coroutine
+//  that is suspended is unwound first.  Coroutines still live when the
+//  program ends are released automatically.
+
+#import "TCCoroutineFunction.h"
+
+@interface TCcoroutine_freeFunction : TCCoroutineFunction
+
+@end
@@ -0,0 +1,33 @@
+//
+//  TCcoroutine_freeFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCcoroutine_freeFunction.h"
+
+@implementation TCcoroutine_freeFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCCoroutine * coroutine = [self coroutineFor:arguments[0]];
+    if( coroutine == nil )
+        return nil;
+    if( coroutine == [TCCoroutine current] ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_COROUTINE
+                                           atNode:self.node
+                                     withArgument:@"a coroutine cannot free itself"];
+        return nil;
+    }
+    [coroutine cancel];
+    return [[TCValue alloc]initWithInt:0];
+}
+@end
@@ -0,0 +1,18 @@
+//
+//  TCcoroutine_newFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  coroutine_new("function", args...) makes a coroutine that will call the
+//  named function with the given arguments, and returns its handle.  The
+//  function does not start until the first resume().  Returns 0 if there is
+//  no storage for the coroutine's stack.
+
+#import "TCFunction.h"
+
+@interface TCcoroutine_newFunction : TCFunction
+
+@end
@@ -0,0 +1,44 @@
+//
+//  TCcoroutine_newFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCcoroutine_newFunction.h"
+#import "TCCoroutine.h"
+#import "TCSyntaxNode.h"
+
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+@implementation TCcoroutine_newFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count < 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    const char * text = [self cString:arguments[0]];
+    if( text == NULL )
+        return nil;
+    NSString * spelling = [NSString stringWithUTF8String:text];
+    TCSyntaxNode * entry = [activeContext findEntryPoint:spelling];
+    if( entry == nil ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_UNK_ENTRYPOINT
+                                           atNode:self.node
+                                     withArgument:spelling];
+        return nil;
+    }
+
+    NSArray * parameters = [arguments subarrayWithRange:NSMakeRange(1, arguments.count - 1)];
+    TCCoroutine * coroutine = [[TCCoroutine alloc]initWithEntry:entry
+                                                      arguments:parameters
+                                                        symbols:context.symbols
+                                                        storage:self.storage];
+    return [[TCValue alloc]initWithLong:coroutine ? coroutine.handle : 0L];
+}
+@end
@@ -0,0 +1,24 @@
+//
+//  TCfcloseFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCfcloseFunction.h"
+
+@implementation TCfcloseFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long handle = [arguments[0] getLong];
+    return [[TCValue alloc]initWithInt:[self.storage closeFile:handle]];
+}
+@end
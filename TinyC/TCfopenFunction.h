@@ -0,0 +1,13 @@
+//
+//  TCfopenFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCFunction.h"
+
+@interface TCfopenFunction : TCFunction
+
+@end
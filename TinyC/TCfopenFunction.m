@@ -0,0 +1,33 @@
+//
+//  TCfopenFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCfopenFunction.h"
+
+@implementation TCfopenFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    const char * path = [self cString:arguments[0]];
+    const char * mode = path ? [self cString:arguments[1]] : NULL;
+    if( mode == NULL )
+        return nil;
+    
+    // Like the C library, a file that cannot be opened is not an error;
+    // the program gets back a zero handle and can test for it.
+    
+    FILE * file = fopen(path, mode);
+    long handle = file ? [self.storage addFile:file] : 0L;
+    return [[TCValue alloc]initWithLong:handle];
+}
+@end
@@ -0,0 +1,39 @@
+//
+//  TCfreadFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCfreadFunction.h"
+
+@implementation TCfreadFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 4 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long address = [arguments[0] getLong];
+    long size = [arguments[1] getLong];
+    long count = [arguments[2] getLong];
+    long handle = [arguments[3] getLong];
+    
+    FILE * file = [self.storage fileForHandle:handle];
+    if( file == NULL || size <= 0 || count <= 0 )
+        return [[TCValue alloc]initWithLong:0L];
+    
+    // Read straight into runtime storage, once the whole destination is
+    // known to be writable.
+    
+    char * buffer = [self pointerTo:address count:count size:size forWrite:YES];
+    if( buffer == NULL )
+        return nil;
+    
+    return [[TCValue alloc]initWithLong:(long) fread(buffer, size, count, file)];
+}
+@end
@@ -0,0 +1,24 @@
+//
+//  TCgetcharFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCgetcharFunction.h"
+#import "TCInputBuffer.h"
+
+@implementation TCgetcharFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    return [[TCValue alloc]initWithInt:[[TCInputBuffer standardInput] getChar]];
+}
+@end
@@ -0,0 +1,17 @@
+//
+//  TCjoinFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  join(t) waits for the thread started by spawn() to return, and returns
+//  the function's result.  An error that stopped the thread stops the
+//  joining program too.  A thread can only be joined once.
+
+#import "TCFunction.h"
+
+@interface TCjoinFunction : TCFunction
+
+@end
@@ -0,0 +1,39 @@
+//
+//  TCjoinFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCjoinFunction.h"
+#import "TCThread.h"
+
+@implementation TCjoinFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCThread * thread = [TCThread threadFor:[arguments[0] getLong] storage:self.storage];
+    if( thread == nil ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:1]];
+        return nil;
+    }
+
+    // A function with no return statement gives no value, which is an int 0.
+
+    TCValue * result = [thread join];
+    if( thread.error ) {
+        self.error = thread.error;
+        return nil;
+    }
+    return result ? result : [[TCValue alloc]initWithInt:0];
+}
+@end
@@ -0,0 +1,16 @@
+//
+//  TCmap_freeFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_free(m) releases the map, its table and its copies of string keys.
+//  The handle may not be used afterwards.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_freeFunction : TCMapFunction
+
+@end
@@ -0,0 +1,38 @@
+//
+//  TCmap_freeFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_freeFunction.h"
+
+@implementation TCmap_freeFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapHeader * map = [self mapOf:arguments[0]];
+    if( map == NULL )
+        return nil;
+    TCMapSlot * slots = [self slotsOf:map];
+    if( slots == NULL )
+        return nil;
+
+    if( map->stringKeys ) {
+        for( long ix = 0; ix < map->capacity; ix++ )
+            if( slots[ix].hash != TCMAP_EMPTY && slots[ix].hash != TCMAP_DELETED )
+                [self.storage free:slots[ix].key];
+    }
+    [self.storage free:map->slots];
+    map->magic = 0;
+    [self.storage free:[arguments[0] getLong]];
+    return [[TCValue alloc]initWithLong:0L];
+}
+@end
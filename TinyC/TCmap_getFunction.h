@@ -0,0 +1,16 @@
+//
+//  TCmap_getFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_get(m, key, missing) returns the value stored under key, or
+//  missing if the map has no entry for it.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_getFunction : TCMapFunction
+
+@end
@@ -0,0 +1,38 @@
+//
+//  TCmap_getFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_getFunction.h"
+
+@implementation TCmap_getFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapHeader * map = [self mapOf:arguments[0]];
+    if( map == NULL )
+        return nil;
+
+    const char * text = NULL;
+    long length = 0;
+    long hash = [self hashOf:arguments[1] map:map text:&text length:&length];
+    if( hash == TCMAP_EMPTY )
+        return nil;
+    long ix = [self find:map key:[arguments[1] getLong] text:text length:length hash:hash insert:NULL];
+    if( self.error )
+        return nil;
+
+    if( ix < 0 )
+        return [[TCValue alloc]initWithLong:[arguments[2] getLong]];
+    return [[TCValue alloc]initWithLong:[self slotsOf:map][ix].value];
+}
+@end
@@ -0,0 +1,15 @@
+//
+//  TCmap_hasFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_has(m, key) returns 1 if the map has an entry for key, else 0.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_hasFunction : TCMapFunction
+
+@end
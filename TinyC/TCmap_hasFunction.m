@@ -0,0 +1,36 @@
+//
+//  TCmap_hasFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_hasFunction.h"
+
+@implementation TCmap_hasFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapHeader * map = [self mapOf:arguments[0]];
+    if( map == NULL )
+        return nil;
+
+    const char * text = NULL;
+    long length = 0;
+    long hash = [self hashOf:arguments[1] map:map text:&text length:&length];
+    if( hash == TCMAP_EMPTY )
+        return nil;
+    long ix = [self find:map key:[arguments[1] getLong] text:text length:length hash:hash insert:NULL];
+    if( self.error )
+        return nil;
+
+    return [[TCValue alloc]initWithLong:ix >= 0 ? 1L : 0L];
+}
+@end
@@ -0,0 +1,17 @@
+//
+//  TCmap_keyFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_key(m, slot) returns the key of the entry in a slot found with
+//  map_next.  For a string map it is a char* to the map's own copy of the
+//  key, which must not be changed.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_keyFunction : TCMapFunction
+
+@end
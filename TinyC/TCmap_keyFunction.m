@@ -0,0 +1,29 @@
+//
+//  TCmap_keyFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_keyFunction.h"
+
+@implementation TCmap_keyFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapSlot * slot = [self slotOf:arguments[0] index:arguments[1]];
+    if( slot == NULL )
+        return nil;
+    TCValue * key = [[TCValue alloc]initWithLong:slot->key];
+    if( [self mapOf:arguments[0]]->stringKeys )
+        return [key makePointer:TCVALUE_CHAR];
+    return key;
+}
+@end
@@ -0,0 +1,17 @@
+//
+//  TCmap_newFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_new(string_keys) makes an empty map and returns its handle.  If
+//  string_keys is nonzero the keys are char* strings compared by content;
+//  otherwise they are longs.  Returns 0 if storage is exhausted.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_newFunction : TCMapFunction
+
+@end
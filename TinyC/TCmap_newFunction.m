@@ -0,0 +1,45 @@
+//
+//  TCmap_newFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_newFunction.h"
+
+@implementation TCmap_newFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    BOOL stringKeys = [arguments[0] getLong] != 0;
+    long handle = [self.storage allocateDynamic:sizeof(TCMapHeader)];
+    if( handle == 0 )
+        return [[TCValue alloc]initWithLong:0L];
+    long slots = [self.storage allocateDynamic:TCMAP_MIN_CAPACITY * sizeof(TCMapSlot)];
+    if( slots == 0 ) {
+        [self.storage free:handle];
+        return [[TCValue alloc]initWithLong:0L];
+    }
+
+    TCMapHeader * map = (TCMapHeader*)[self pointerTo:handle length:sizeof(TCMapHeader) forWrite:YES];
+    char * table = [self pointerTo:slots length:TCMAP_MIN_CAPACITY * sizeof(TCMapSlot) forWrite:YES];
+    if( map == NULL || table == NULL )
+        return nil;
+    memset(table, 0, TCMAP_MIN_CAPACITY * sizeof(TCMapSlot));
+
+    map->magic = TCMAP_MAGIC;
+    map->stringKeys = stringKeys;
+    map->count = 0;
+    map->used = 0;
+    map->capacity = TCMAP_MIN_CAPACITY;
+    map->slots = slots;
+    return [[TCValue alloc]initWithLong:handle];
+}
+@end
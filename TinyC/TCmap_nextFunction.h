@@ -0,0 +1,22 @@
+//
+//  TCmap_nextFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_next(m, slot) returns the next slot after slot that holds an entry,
+//  or -1 when there are no more.  Iteration starts with a slot of -1:
+//
+//      for( s = map_next(m, -1); s >= 0; s = map_next(m, s) )
+//          printf("%d\n", map_value(m, s));
+//
+//  Adding entries may move them, so a map should not be changed while it
+//  is being walked, except by map_remove of the current entry.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_nextFunction : TCMapFunction
+
+@end
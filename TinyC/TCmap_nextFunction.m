@@ -0,0 +1,34 @@
+//
+//  TCmap_nextFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_nextFunction.h"
+
+@implementation TCmap_nextFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapHeader * map = [self mapOf:arguments[0]];
+    if( map == NULL )
+        return nil;
+    TCMapSlot * slots = [self slotsOf:map];
+    if( slots == NULL )
+        return nil;
+
+    long ix = MAX([arguments[1] getLong] + 1, 0L);
+    for( ; ix < map->capacity; ix++ )
+        if( slots[ix].hash != TCMAP_EMPTY && slots[ix].hash != TCMAP_DELETED )
+            return [[TCValue alloc]initWithLong:ix];
+    return [[TCValue alloc]initWithLong:-1L];
+}
+@end
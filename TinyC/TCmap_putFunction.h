@@ -0,0 +1,17 @@
+//
+//  TCmap_putFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_put(m, key, value) stores value under key, returning 1 if the key
+//  is new and 0 if it replaced an existing value.  Returns -1 if the map
+//  needed to grow and storage is exhausted.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_putFunction : TCMapFunction
+
+@end
@@ -0,0 +1,68 @@
+//
+//  TCmap_putFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_putFunction.h"
+
+@implementation TCmap_putFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapHeader * map = [self mapOf:arguments[0]];
+    if( map == NULL )
+        return nil;
+
+    const char * text = NULL;
+    long length = 0;
+    long key = [arguments[1] getLong];
+    long hash = [self hashOf:arguments[1] map:map text:&text length:&length];
+    if( hash == TCMAP_EMPTY )
+        return nil;
+
+    long value = [arguments[2] getLong];
+    long ix = [self find:map key:key text:text length:length hash:hash insert:NULL];
+    if( ix >= 0 ) {
+        [self slotsOf:map][ix].value = value;
+        return [[TCValue alloc]initWithLong:0L];
+    }
+    if( self.error )
+        return nil;
+
+    // Growing moves every slot, so the insertion point is found again
+    // afterwards.
+
+    if( ![self reserve:map] )
+        return self.error ? nil : [[TCValue alloc]initWithLong:-1L];
+    long insert = -1L;
+    [self find:map key:key text:text length:length hash:hash insert:&insert];
+    TCMapSlot * slots = [self slotsOf:map];
+    if( slots == NULL || insert < 0 )
+        return nil;
+
+    if( map->stringKeys ) {
+        key = [self.storage allocateDynamic:length + 1];
+        char * copy = key ? [self pointerTo:key length:length + 1 forWrite:YES] : NULL;
+        if( copy == NULL )
+            return self.error ? nil : [[TCValue alloc]initWithLong:-1L];
+        memcpy(copy, text, length + 1);
+    }
+
+    if( slots[insert].hash == TCMAP_EMPTY )
+        map->used++;
+    map->count++;
+    slots[insert].hash = hash;
+    slots[insert].key = key;
+    slots[insert].value = value;
+    return [[TCValue alloc]initWithLong:1L];
+}
+@end
@@ -0,0 +1,16 @@
+//
+//  TCmap_removeFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_remove(m, key) removes the entry for key, returning 1 if there was
+//  one and 0 if there was not.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_removeFunction : TCMapFunction
+
+@end
@@ -0,0 +1,53 @@
+//
+//  TCmap_removeFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_removeFunction.h"
+
+@implementation TCmap_removeFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapHeader * map = [self mapOf:arguments[0]];
+    if( map == NULL )
+        return nil;
+
+    const char * text = NULL;
+    long length = 0;
+    long hash = [self hashOf:arguments[1] map:map text:&text length:&length];
+    if( hash == TCMAP_EMPTY )
+        return nil;
+    long ix = [self find:map key:[arguments[1] getLong] text:text length:length hash:hash insert:NULL];
+    if( self.error )
+        return nil;
+
+    if( ix < 0 )
+        return [[TCValue alloc]initWithLong:0L];
+
+    TCMapSlot * slots = [self slotsOf:map];
+    if( map->stringKeys )
+        [self.storage free:slots[ix].key];
+
+    // A slot followed by an empty one ends no probe chain, so it can be
+    // made empty again rather than left as a tombstone.
+
+    if( slots[(ix + 1) & (map->capacity - 1)].hash == TCMAP_EMPTY ) {
+        slots[ix].hash = TCMAP_EMPTY;
+        map->used--;
+    }
+    else
+        slots[ix].hash = TCMAP_DELETED;
+    map->count--;
+    return [[TCValue alloc]initWithLong:1L];
+}
+@end
@@ -0,0 +1,15 @@
+//
+//  TCmap_sizeFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_size(m) returns the number of entries in the map.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_sizeFunction : TCMapFunction
+
+@end
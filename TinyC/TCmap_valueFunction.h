@@ -0,0 +1,16 @@
+//
+//  TCmap_valueFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  map_value(m, slot) returns the value of the entry in a slot found with
+//  map_next.
+
+#import "TCMapFunction.h"
+
+@interface TCmap_valueFunction : TCMapFunction
+
+@end
@@ -0,0 +1,26 @@
+//
+//  TCmap_valueFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmap_valueFunction.h"
+
+@implementation TCmap_valueFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCMapSlot * slot = [self slotOf:arguments[0] index:arguments[1]];
+    if( slot == NULL )
+        return nil;
+    return [[TCValue alloc]initWithLong:slot->value];
+}
+@end
@@ -0,0 +1,33 @@
+//
+//  TCmemcmpFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmemcmpFunction.h"
+
+@implementation TCmemcmpFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long left = [arguments[0] getLong];
+    long right = [arguments[1] getLong];
+    long count = [arguments[2] getLong];
+    
+    char * l = [self pointerTo:left length:count forWrite:NO];
+    char * r = l ? [self pointerTo:right length:count forWrite:NO] : NULL;
+    if( r == NULL )
+        return nil;
+    
+    int result = memcmp(l, r, count);
+    return [[TCValue alloc]initWithInt:result];
+}
+@end
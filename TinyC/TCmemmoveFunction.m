@@ -0,0 +1,33 @@
+//
+//  TCmemmoveFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmemmoveFunction.h"
+
+@implementation TCmemmoveFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long dest = [arguments[0] getLong];
+    long src = [arguments[1] getLong];
+    long count = [arguments[2] getLong];
+    
+    char * to = [self pointerTo:dest length:count forWrite:YES];
+    char * from = to ? [self pointerTo:src length:count forWrite:NO] : NULL;
+    if( from == NULL )
+        return nil;
+    
+    memmove(to, from, count);
+    return [[[TCValue alloc]initWithLong:dest] makePointer:TCVALUE_CHAR];
+}
+@end
@@ -0,0 +1,32 @@
+//
+//  TCmemsetFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmemsetFunction.h"
+
+@implementation TCmemsetFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long dest = [arguments[0] getLong];
+    int value = [arguments[1] getInt];
+    long count = [arguments[2] getLong];
+    
+    char * to = [self pointerTo:dest length:count forWrite:YES];
+    if( to == NULL )
+        return nil;
+    
+    memset(to, value, count);
+    return [[[TCValue alloc]initWithLong:dest] makePointer:TCVALUE_CHAR];
+}
+@end
@@ -0,0 +1,36 @@
+//
+//  TCmmap_fileFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmmap_fileFunction.h"
+
+@implementation TCmmap_fileFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    const char * path = [self cString:arguments[0]];
+    if( path == NULL )
+        return nil;
+    
+    // NSData maps the file rather than reading it, and the storage manager
+    // makes those bytes addressable in place.  Pages are only brought in
+    // as the program touches them.
+    
+    NSError * error = nil;
+    NSData * data = [NSData dataWithContentsOfFile:[NSString stringWithUTF8String:path]
+                                           options:NSDataReadingMappedAlways
+                                             error:&error];
+    long address = data ? [self.storage mapExternal:data writable:NO] : 0L;
+    return [[[TCValue alloc]initWithLong:address] makePointer:TCVALUE_CHAR];
+}
+@end
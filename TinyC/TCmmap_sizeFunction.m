@@ -0,0 +1,24 @@
+//
+//  TCmmap_sizeFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCmmap_sizeFunction.h"
+
+@implementation TCmmap_sizeFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long address = [arguments[0] getLong];
+    return [[TCValue alloc]initWithLong:[self.storage externalLength:address]];
+}
+@end
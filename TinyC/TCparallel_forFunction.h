@@ -0,0 +1,20 @@
+//
+//  TCparallel_forFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  parallel_for(start, end, "function"[, chunk]) calls the named function
+//  with each index from start up to but not including end, on a pool of
+//  worker threads, and returns 0 once every call has returned.  chunk is
+//  how many indices a worker takes at a time; by default each worker's
+//  share is cut into eight.  See TCParallelFor for what the function may
+//  write.  An error in any call stops the rest, and stops the program.
+
+#import "TCFunction.h"
+
+@interface TCparallel_forFunction : TCFunction
+
+@end
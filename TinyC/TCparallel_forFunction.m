@@ -0,0 +1,48 @@
+//
+//  TCparallel_forFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCparallel_forFunction.h"
+#import "TCParallelFor.h"
+#import "TCSyntaxNode.h"
+
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+@implementation TCparallel_forFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 && arguments.count != 4 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    const char * text = [self cString:arguments[2]];
+    if( text == NULL )
+        return nil;
+    NSString * spelling = [NSString stringWithUTF8String:text];
+    TCSyntaxNode * entry = [activeContext findEntryPoint:spelling];
+    if( entry == nil ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_UNK_ENTRYPOINT
+                                           atNode:self.node
+                                     withArgument:spelling];
+        return nil;
+    }
+
+    long chunk = arguments.count == 4 ? [arguments[3] getLong] : 0L;
+    TCParallelFor * loop = [[TCParallelFor alloc]initWithEntry:entry
+                                                       symbols:context.symbols
+                                                       storage:self.storage
+                                                       workers:0];
+    if( ![loop runFrom:[arguments[0] getLong] to:[arguments[1] getLong] chunk:chunk] ) {
+        self.error = loop.error;
+        return nil;
+    }
+    return [[TCValue alloc]initWithInt:0];
+}
+@end
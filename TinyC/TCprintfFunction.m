@@ -7,7 +7,7 @@
 //
 
 #import "TCprintfFunction.h"
-#import "NSString+NSStringFormatting.h"
+#import "TCFormatString.h"
 
 @implementation TCprintfFunction
 
@@ -21,45 +21,49 @@
         return [[TCValue alloc]initWithLong:0];
     }
     
-    // We will accumulate the arguments into an array of data
-    // items loaded from memory or directly referenced by
-    // value as appropriate
+    // If the format was a string literal, the compiler has already turned
+    // it into a list of directives and stored it on the CALL node.  Otherwise
+    // the format was calculated at runtime, so we compile it now.
     
-    NSMutableArray * valueArgs = [NSMutableArray array];
-    TCValue* formatValue = (TCValue*) arguments[0];
-    NSString * formatString = [formatValue getString];
-    
-    for( int i = 1; i < arguments.count; i++ ) {
-        TCValue * x = (TCValue*) arguments[i];
-        if( x.getType == TCVALUE_POINTER_CHAR) {
-            long strPtrAddress = x.getLong;
-            [valueArgs addObject:[self.storage getString:strPtrAddress]];
-        } else if( x.getType == TCVALUE_STRING)
-            [valueArgs addObject:x.getString];
-        else if( x.getType == TCVALUE_BOOLEAN)
-            [valueArgs addObject:[NSNumber numberWithBool:x.getLong]];
-        else if( x.getType == TCVALUE_INT)
-            [valueArgs addObject:[NSNumber numberWithInteger:x.getInt]];
-        else if( x.getType == TCVALUE_LONG)
-            [valueArgs addObject:[NSNumber numberWithLong:x.getLong]];
-        else if( x.getType == TCVALUE_DOUBLE)
-            [valueArgs addObject:[NSNumber numberWithDouble:x.getDouble]];
-        else if( x.getType >= TCVALUE_POINTER)
-            [valueArgs addObject:[NSNumber numberWithLong:x.getLong]];
-        else {
-            NSLog(@"ERROR: unusable argument type %d cannot be added to arglist ", x.getType);
-            
+    TCFormatString * format = nil;
+    if([self.node.argument isKindOfClass:[TCFormatString class]])
+        format = (TCFormatString*) self.node.argument;
+    else {
+        TCValue* formatValue = (TCValue*) arguments[0];
+        if( formatValue.getType == TCVALUE_POINTER_CHAR) {
+            const char * text = [self cString:formatValue];
+            if( text == NULL )
+                return nil;
+            format = [[TCFormatString alloc]initWithUTF8String:text];
+        }
+        else
+            format = [[TCFormatString alloc]initWithString:[formatValue getString]];
+        
+        if( format.error) {
+            self.error = format.error;
+            return nil;
         }
     }
-
-    // Call our custom formatting function that uses an array of values.  The resulting
-    // buffer is then processed through the escape string manager to convert "\n" to an
-    // actual new line, etc.
     
-    NSString * buffer = [[NSString stringWithFormat:formatString array:valueArgs] escapeString];
+    // Format the values straight into the output buffer, and write the
+    // bytes out in a single operation.
+    
+    NSMutableData * buffer = [NSMutableData dataWithCapacity:128];
+    TCError * formatError = nil;
+    long bytesPrinted = [format appendArguments:arguments
+                                           from:1
+                                        storage:self.storage
+                                             to:buffer
+                                          error:&formatError];
+    if( bytesPrinted < 0 ) {
+        self.error = [[TCError alloc]initWithCode:formatError.code
+                                           atNode:self.node
+                                     withArgument:formatError.argument];
+        return nil;
+    }
     
-    int bytesPrinted = printf("%s", [buffer UTF8String]);
-    return [[TCValue alloc]initWithInt: bytesPrinted];
+    fwrite(buffer.bytes, 1, bytesPrinted, stdout);
+    return [[TCValue alloc]initWithInt:(int) bytesPrinted];
 }
 
 @end
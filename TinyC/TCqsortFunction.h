@@ -0,0 +1,19 @@
+//
+//  TCqsortFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  qsort(base, n, size, "compare") sorts n elements of size bytes at base,
+//  in place, calling the TinyC function compare with pointers to two
+//  elements; it returns a negative, zero or positive result as in C.  The
+//  sort is stable.  Each compare is an interpreted call, so array_sort is
+//  much faster for plain numbers.
+
+#import "TCSortFunction.h"
+
+@interface TCqsortFunction : TCSortFunction
+
+@end
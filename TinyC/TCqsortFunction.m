@@ -0,0 +1,109 @@
+//
+//  TCqsortFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCqsortFunction.h"
+
+@implementation TCqsortFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 4 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    long address = [arguments[0] getLong];
+    long count = [arguments[1] getLong];
+    long size = [arguments[2] getLong];
+    if( count < 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARRAY_BOUNDS
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithLong:count]];
+        return nil;
+    }
+    if( size <= 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_TYPE
+                                           atNode:self.node
+                                     withArgument:[NSNumber numberWithInt:3]];
+        return nil;
+    }
+
+    // Once the whole array is known to be in storage, count * size and
+    // every element address fit in a long.
+
+    if( [self pointerTo:address count:count size:size forWrite:YES] == NULL )
+        return nil;
+    TCSyntaxNode * entry = [self comparator:arguments[3]];
+    if( entry == nil )
+        return nil;
+
+    // The compares are TinyC calls on the elements where they are, so
+    // the sort orders element indexes, and the elements are moved once at
+    // the end.  A bottom-up merge keeps it stable and bounds the calls at
+    // n log n.
+
+    TCValueType type = [arguments[0] getType];
+    type = type > TCVALUE_POINTER ? type - TCVALUE_POINTER : TCVALUE_CHAR;
+
+    long * order = malloc(MAX(count, 1L) * sizeof(long));
+    long * tmp = malloc(MAX(count, 1L) * sizeof(long));
+    char * moved = malloc(MAX(count * size, 1L));
+    if( order == NULL || tmp == NULL || moved == NULL ) {
+        free(order);
+        free(tmp);
+        free(moved);
+        self.error = [[TCError alloc]initWithCode:TCERROR_FATAL
+                                           atNode:self.node
+                                     withArgument:@"no memory to sort"];
+        return nil;
+    }
+    for( long ix = 0; ix < count; ix++ )
+        order[ix] = ix;
+
+    BOOL failed = NO;
+    for( long width = 1; width < count && !failed; width *= 2 ) {
+        for( long lo = 0; lo < count; lo += 2 * width ) {
+            long mid = MIN(lo + width, count);
+            long hi = MIN(lo + 2 * width, count);
+            long i = lo, j = mid, k = lo;
+            while( i < mid && j < hi && !failed ) {
+                TCValue * left = [[[TCValue alloc]initWithLong:address + order[j] * size] makePointer:type];
+                TCValue * right = [[[TCValue alloc]initWithLong:address + order[i] * size] makePointer:type];
+                if( [self compare:entry left:left right:right inContext:context failed:&failed] < 0 )
+                    tmp[k++] = order[j++];
+                else
+                    tmp[k++] = order[i++];
+            }
+            while( i < mid )
+                tmp[k++] = order[i++];
+            while( j < hi )
+                tmp[k++] = order[j++];
+        }
+        long * swap = order;
+        order = tmp;
+        tmp = swap;
+    }
+
+    // The comparator may have allocated storage, so the elements are
+    // located again before they are moved.
+
+    char * elements = failed ? NULL : [self pointerTo:address count:count size:size forWrite:YES];
+    if( elements != NULL ) {
+        for( long ix = 0; ix < count; ix++ )
+            memcpy(moved + ix * size, elements + order[ix] * size, size);
+        memcpy(elements, moved, count * size);
+    }
+    free(order);
+    free(tmp);
+    free(moved);
+    if( elements == NULL )
+        return nil;
+    return [[TCValue alloc]initWithLong:count];
+}
+@end
@@ -7,6 +7,7 @@
 //
 
 #import "TCrandomFunction.h"
+#import "TCRandom.h"
 
 @implementation TCrandomFunction
 
@@ -21,7 +22,10 @@
         return nil;
     }
     
-    return [[TCValue alloc]initWithLong:random()];
+    // The top 31 bits, so the range is the same as the libc random() this
+    // used to call.
+    
+    return [[TCValue alloc]initWithLong:(long)(randomNext(randomCurrent()) >> 33)];
     
 }
 
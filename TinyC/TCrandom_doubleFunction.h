@@ -0,0 +1,15 @@
+//
+//  TCrandom_doubleFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  random_double() returns a random double in the range [0, 1).
+
+#import "TCFunction.h"
+
+@interface TCrandom_doubleFunction : TCFunction
+
+@end
@@ -0,0 +1,24 @@
+//
+//  TCrandom_doubleFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCrandom_doubleFunction.h"
+#import "TCRandom.h"
+
+@implementation TCrandom_doubleFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    return [[TCValue alloc]initWithDouble:randomDouble(randomCurrent())];
+}
+@end
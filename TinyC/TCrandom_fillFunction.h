@@ -0,0 +1,18 @@
+//
+//  TCrandom_fillFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  random_fill(p, n) stores n random values into the array at p in one
+//  call.  int elements get values in the range of random(), long elements
+//  get non-negative 63-bit values, and float and double elements get values
+//  in [0, 1).
+
+#import "TCArrayFunction.h"
+
+@interface TCrandom_fillFunction : TCArrayFunction
+
+@end
@@ -0,0 +1,46 @@
+//
+//  TCrandom_fillFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCrandom_fillFunction.h"
+#import "TCRandom.h"
+
+@implementation TCrandom_fillFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    long count = [arguments[1] getLong];
+    TCValueType type = TCVALUE_UNDEFINED;
+    void * base = [self elementsOf:arguments[0] count:count type:&type forWrite:YES argument:1];
+    if( base == NULL )
+        return nil;
+    
+    // The generator state is copied into locals for the loop and stored
+    // back once at the end.
+    
+    TCRandomState * active = randomCurrent();
+    TCRandomState state = *active;
+    TCARRAY_DISPATCH(type, {
+        T * a = base;
+        for( long ix = 0; ix < count; ix++ ) {
+            uint64_t bits = randomNext(&state);
+            if( REAL )
+                a[ix] = (T)(sizeof(T) == sizeof(float) ? (bits >> 40) * 0x1.0p-24 : (bits >> 11) * 0x1.0p-53);
+            else
+                a[ix] = (T)(sizeof(T) == sizeof(int) ? bits >> 33 : bits >> 1);
+        }
+    })
+    *active = state;
+    return [[TCValue alloc]initWithLong:count];
+}
+@end
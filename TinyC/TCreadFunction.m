@@ -0,0 +1,33 @@
+//
+//  TCreadFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCreadFunction.h"
+#import "TCInputBuffer.h"
+
+@implementation TCreadFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long address = [arguments[0] getLong];
+    long length = [arguments[1] getLong];
+    if( length <= 0 )
+        return [[TCValue alloc]initWithLong:0L];
+    
+    char * buffer = [self pointerTo:address length:length forWrite:YES];
+    if( buffer == NULL )
+        return nil;
+    
+    return [[TCValue alloc]initWithLong:[[TCInputBuffer standardInput] read:buffer length:length]];
+}
+@end
@@ -0,0 +1,33 @@
+//
+//  TCreadlineFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCreadlineFunction.h"
+#import "TCInputBuffer.h"
+
+@implementation TCreadlineFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long address = [arguments[0] getLong];
+    long size = [arguments[1] getLong];
+    if( size <= 0 )
+        return [[TCValue alloc]initWithLong:0L];
+    
+    char * buffer = [self pointerTo:address length:size forWrite:YES];
+    if( buffer == NULL )
+        return nil;
+    
+    return [[TCValue alloc]initWithLong:[[TCInputBuffer standardInput] readLine:buffer size:size]];
+}
+@end
@@ -0,0 +1,18 @@
+//
+//  TCresumeFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  resume(co[, value]) runs a coroutine until it yields or returns.  The
+//  value, 0 if omitted, becomes the result of the yield() it is suspended
+//  in.  Returns the value it yields, or the function's result when it
+//  returns.
+
+#import "TCCoroutineFunction.h"
+
+@interface TCresumeFunction : TCCoroutineFunction
+
+@end
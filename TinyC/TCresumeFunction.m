@@ -0,0 +1,32 @@
+//
+//  TCresumeFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCresumeFunction.h"
+
+@implementation TCresumeFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count < 1 || arguments.count > 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCCoroutine * coroutine = [self coroutineFor:arguments[0]];
+    if( coroutine == nil )
+        return nil;
+    TCValue * value = arguments.count > 1 ? arguments[1] : [[TCValue alloc]initWithLong:0L];
+    TCValue * result = [coroutine resume:value];
+    if( result == nil ) {
+        self.error = coroutine.error;
+        return nil;
+    }
+    return result;
+}
+@end
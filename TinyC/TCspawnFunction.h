@@ -0,0 +1,21 @@
+//
+//  TCspawnFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  spawn("function", args...) starts the named function running on a new
+//  thread with the given arguments, and returns the thread's handle.  Each
+//  thread must be joined with join(); threads still running when the
+//  program ends are joined automatically.  Returns 0 if there is no storage
+//  for the thread's stack.  The function sees the globals but not the
+//  locals of its caller, so anything it needs from them must be passed as
+//  an argument.
+
+#import "TCFunction.h"
+
+@interface TCspawnFunction : TCFunction
+
+@end
@@ -0,0 +1,55 @@
+//
+//  TCspawnFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCspawnFunction.h"
+#import "TCThread.h"
+#import "TCSyntaxNode.h"
+
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+@implementation TCspawnFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count < 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    const char * text = [self cString:arguments[0]];
+    if( text == NULL )
+        return nil;
+    NSString * spelling = [NSString stringWithUTF8String:text];
+    TCSyntaxNode * entry = [activeContext findEntryPoint:spelling];
+    if( entry == nil ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_UNK_ENTRYPOINT
+                                           atNode:self.node
+                                     withArgument:spelling];
+        return nil;
+    }
+
+    // The thread gets the global scope only.  The caller's own scope may
+    // change, or be popped, before the thread is joined.  There is no
+    // global scope while the globals themselves are being initialized.
+
+    if( activeGlobals == nil ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_THREAD
+                                           atNode:self.node
+                                     withArgument:@"no threads while globals are initialized"];
+        return nil;
+    }
+
+    NSArray * parameters = [arguments subarrayWithRange:NSMakeRange(1, arguments.count - 1)];
+    TCThread * thread = [[TCThread alloc]initWithEntry:entry
+                                             arguments:parameters
+                                               symbols:activeGlobals
+                                               storage:self.storage];
+    return [[TCValue alloc]initWithLong:thread ? thread.handle : 0L];
+}
+@end
@@ -0,0 +1,16 @@
+//
+//  TCsrandomFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  srandom(seed) starts the execution's random number generator over from
+//  seed, so the values that follow are the same on every run.
+
+#import "TCFunction.h"
+
+@interface TCsrandomFunction : TCFunction
+
+@end
@@ -0,0 +1,25 @@
+//
+//  TCsrandomFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCsrandomFunction.h"
+#import "TCRandom.h"
+
+@implementation TCsrandomFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    randomSeed(randomCurrent(), (uint64_t)[arguments[0] getLong]);
+    return [[TCValue alloc]initWithInt:0];
+}
+@end
@@ -0,0 +1,39 @@
+//
+//  TCstrcatFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCstrcatFunction.h"
+
+@implementation TCstrcatFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long dest = [arguments[0] getLong];
+    long src = [arguments[1] getLong];
+    
+    long destLength = [self stringLength:dest limit:LONG_MAX];
+    if( destLength < 0 )
+        return nil;
+    long srcLength = [self stringLength:src limit:LONG_MAX];
+    if( srcLength < 0 )
+        return nil;
+    
+    char * to = [self pointerTo:dest length:destLength + srcLength + 1 forWrite:YES];
+    char * from = to ? [self pointerTo:src length:srcLength + 1 forWrite:NO] : NULL;
+    if( from == NULL )
+        return nil;
+    
+    memmove(to + destLength, from, srcLength + 1);
+    return [[[TCValue alloc]initWithLong:dest] makePointer:TCVALUE_CHAR];
+}
+@end
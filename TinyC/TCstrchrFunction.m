@@ -0,0 +1,38 @@
+//
+//  TCstrchrFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCstrchrFunction.h"
+
+@implementation TCstrchrFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long string = [arguments[0] getLong];
+    char ch = [arguments[1] getChar];
+    
+    long length = [self stringLength:string limit:LONG_MAX];
+    if( length < 0 )
+        return nil;
+    
+    // Search the terminator as well, so strchr(s, 0) finds the end of
+    // the string the same way the C library does.
+    
+    char * base = [self pointerTo:string length:length + 1 forWrite:NO];
+    if( base == NULL )
+        return nil;
+    char * found = memchr(base, ch, length + 1);
+    long address = found ? string + (found - base) : 0L;
+    return [[[TCValue alloc]initWithLong:address] makePointer:TCVALUE_CHAR];
+}
+@end
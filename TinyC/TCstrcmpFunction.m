@@ -0,0 +1,32 @@
+//
+//  TCstrcmpFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCstrcmpFunction.h"
+
+@implementation TCstrcmpFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    // Once both strings are known to be terminated inside storage, the
+    // C library comparison cannot run past the end of either one.
+    
+    const char * l = [self cString:arguments[0]];
+    const char * r = l ? [self cString:arguments[1]] : NULL;
+    if( r == NULL )
+        return nil;
+    
+    int result = strcmp(l, r);
+    return [[TCValue alloc]initWithInt:result];
+}
+@end
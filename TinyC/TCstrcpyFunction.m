@@ -0,0 +1,38 @@
+//
+//  TCstrcpyFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCstrcpyFunction.h"
+
+@implementation TCstrcpyFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long dest = [arguments[0] getLong];
+    long src = [arguments[1] getLong];
+    
+    // Find the source length first so we know how much of the
+    // destination must be addressable, including the terminator.
+    
+    long length = [self stringLength:src limit:LONG_MAX];
+    if( length < 0 )
+        return nil;
+    char * from = [self pointerTo:src length:length + 1 forWrite:NO];
+    char * to = from ? [self pointerTo:dest length:length + 1 forWrite:YES] : NULL;
+    if( to == NULL )
+        return nil;
+    
+    memmove(to, from, length + 1);
+    return [[[TCValue alloc]initWithLong:dest] makePointer:TCVALUE_CHAR];
+}
+@end
@@ -21,13 +21,9 @@
     TCValue * strArg = arguments[0];
     long strAddress = strArg.getLong;
 
-    long count = 0;
-    while(true) {
-        char ch = [self.storage getChar:strAddress+count];
-        if( ch == 0 )
-            break;
-        count++;
-    }
+    long count = [self stringLength:strAddress limit:LONG_MAX];
+    if( count < 0 )
+        return nil;
     return [[TCValue alloc]initWithLong:count];
 }
 @end
@@ -0,0 +1,43 @@
+//
+//  TCstrncmpFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCstrncmpFunction.h"
+
+@implementation TCstrncmpFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 3 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long left = [arguments[0] getLong];
+    long right = [arguments[1] getLong];
+    long count = [arguments[2] getLong];
+    
+    if( count <= 0 )
+        return [[TCValue alloc]initWithInt:0];
+    
+    // Each string only has to be addressable up to its terminator or the
+    // count, whichever comes first.
+    
+    long leftLength = [self stringLength:left limit:count];
+    long rightLength = leftLength < 0 ? -1 : [self stringLength:right limit:count];
+    if( rightLength < 0 )
+        return nil;
+    char * l = [self pointerTo:left length:MIN(leftLength + 1, count) forWrite:NO];
+    char * r = l ? [self pointerTo:right length:MIN(rightLength + 1, count) forWrite:NO] : NULL;
+    if( r == NULL )
+        return nil;
+    
+    int result = strncmp(l, r, count);
+    return [[TCValue alloc]initWithInt:result];
+}
+@end
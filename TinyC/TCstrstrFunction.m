@@ -0,0 +1,35 @@
+//
+//  TCstrstrFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCstrstrFunction.h"
+
+@implementation TCstrstrFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 2 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    long string = [arguments[0] getLong];
+    
+    long length = [self stringLength:string limit:LONG_MAX];
+    if( length < 0 )
+        return nil;
+    const char * base = [self pointerTo:string length:length + 1 forWrite:NO];
+    const char * text = base ? [self cString:arguments[1]] : NULL;
+    if( text == NULL )
+        return nil;
+    
+    const char * found = strstr(base, text);
+    long address = found ? string + (found - base) : 0L;
+    return [[[TCValue alloc]initWithLong:address] makePointer:TCVALUE_CHAR];
+}
+@end
@@ -0,0 +1,30 @@
+//
+//  TCtrace_dumpFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCtrace_dumpFunction.h"
+#import "TCTraceBuffer.h"
+
+@implementation TCtrace_dumpFunction
+
+/**
+ Write the binary trace recorded so far to the trace file.  This lets a
+ program capture the events leading up to a condition it detects itself.
+ Returns 1 if the trace was written, or 0 if no trace is being recorded.
+ */
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count != 0 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+    
+    TCTraceBuffer * trace = [TCTraceBuffer current];
+    return [[TCValue alloc]initWithInt:(trace != nil && [trace write]) ? 1 : 0];
+}
+@end
@@ -0,0 +1,17 @@
+//
+//  TCyieldFunction.h
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+//
+//  yield([value]) suspends the running coroutine and hands the value, 0 if
+//  omitted, to the resume() that ran it.  Returns the value passed to the
+//  next resume().  It is an error to call it outside a coroutine.
+
+#import "TCFunction.h"
+
+@interface TCyieldFunction : TCFunction
+
+@end
@@ -0,0 +1,40 @@
+//
+//  TCyieldFunction.m
+//  TinyC
+//
+//  Created by Tom Cole on 10/19/26.
+//  Copyright (c) 2026 Forest Edge. All rights reserved.
+//
+
+#import "TCyieldFunction.h"
+#import "TCCoroutine.h"
+
+@implementation TCyieldFunction
+
+-(TCValue*) execute:(NSArray *)arguments inContext:(TCExecutionContext*) context
+{
+    
+    if( arguments.count > 1 ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_ARG_MISMATCH atNode:nil];
+        return nil;
+    }
+
+    TCCoroutine * coroutine = [TCCoroutine current];
+    if( coroutine == nil ) {
+        self.error = [[TCError alloc]initWithCode:TCERROR_COROUTINE
+                                           atNode:self.node
+                                     withArgument:@"yield outside a coroutine"];
+        return nil;
+    }
+    TCValue * value = arguments.count > 0 ? arguments[0] : [[TCValue alloc]initWithLong:0L];
+    TCValue * result = [coroutine yield:value];
+
+    // A coroutine that is freed while suspended unwinds from here.
+
+    if( result == nil )
+        self.error = [[TCError alloc]initWithCode:TCERROR_COROUTINE
+                                           atNode:self.node
+                                     withArgument:@"coroutine freed while suspended"];
+    return result;
+}
+@end
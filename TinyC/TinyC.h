@@ -18,6 +18,7 @@
 #import <Foundation/Foundation.h>
 #import "TCError.h"
 #import "TCValue.h"
+#import "TCMetrics.h"
 
 #define RUNTIME_ENTRYPOINT @"__runtime__"
 
@@ -51,7 +52,19 @@ typedef enum {
     TCFatalAsserts = 32,
     
     /** Is the random number generator deterministic or truly random? */
-    TCNonRandomNumbers = 64
+    TCNonRandomNumbers = 64,
+    
+    /** Profile execution by function and source line */
+    TCDebugProfile = 128,
+    
+    /** Record binary trace events into a ring buffer */
+    TCDebugTraceRing = 256,
+    
+    /** Profile dynamic storage allocation by call site */
+    TCDebugHeap = 512,
+    
+    /** Run every function as parsed, never optimizing the hot ones */
+    TCNoOptimize = 1024
     
 } TCFlag;
 
@@ -59,6 +72,12 @@ typedef enum {
 @class TCLexicalScanner;
 @class TCSyntaxNode;
 @class TCExecutionContext;
+@class TCRuntimeSymbolTable;
+@class TCEntryPoint;
+@class TCTraceBuffer;
+@class TCRandom;
+@class TCProfiler;
+@class TCHeapProfiler;
 
 
 @interface TinyC : NSObject
@@ -80,6 +99,45 @@ typedef enum {
     /** This is the context used to execute this program code. */
     TCExecutionContext * context;
     
+    /** The global symbols created by running the runtime initialization */
+    TCRuntimeSymbolTable * globals;
+    
+    /** Has the runtime initialization been run since the last compile? */
+    BOOL globalsInitialized;
+    
+    /** The outermost symbol table, holding the host buffer pointers */
+    TCRuntimeSymbolTable * hostSymbols;
+    
+    /** Mapped host buffers; each name maps to a pointer TCValue */
+    NSMutableDictionary * hostBuffers;
+    
+    /** The variables of unmapped host buffers, whose storage is reused
+        if the name is mapped again */
+    NSMutableDictionary * unmappedHostSymbols;
+    
+    /** The runtime counters captured at the end of the last execution */
+    TCRuntimeCounters counters;
+    
+    /** The limit the last execution was stopped by, if any */
+    TCLimit limitHit;
+    
+    /** What the running execution has used, across all its threads */
+    TCRuntimeBudget budget;
+    
+    /** The path of the source file, if the program was compiled from one */
+    NSString * sourcePath;
+    
+    /** Has the caller chosen the seed for the random number generator? */
+    BOOL randomSeeded;
+    
+    /** The seed the caller chose */
+    unsigned long randomSeed;
+    
+    /** The profilers of the running execution.  The active hooks do not
+        own them, since they are per-thread, so they are kept alive here. */
+    TCProfiler * profiler;
+    TCHeapProfiler * heapProfiler;
+    
 }
 
 
@@ -128,6 +186,67 @@ typedef enum {
 /** The argv[] array for this execution, if any */
 @property NSMutableArray * arguments;
 
+/** The binary trace of the most recent execution, if TCDebugTraceRing is set */
+@property (readonly) TCTraceBuffer * trace;
+
+/** The number of events the trace ring holds; zero uses the default */
+@property long traceEvents;
+
+/** The random number generator used by random(), random_fill() and the
+    other random builtins.  It is seeded again at the start of each execution,
+    from the seed given to seedRandom: if there is one, else zero when
+    TCNonRandomNumbers is set, else a truly random seed.  Use [random split]
+    to get an independent stream for another execution. */
+@property (readonly) TCRandom * random;
+
+/** The most nodes an execution may run before it is stopped with
+    TCERROR_LIMIT, or zero for no limit */
+@property long nodeLimit;
+
+/** The most bytes of dynamic storage an execution may have allocated at
+    once before it is stopped with TCERROR_LIMIT, or zero for no limit */
+@property long memoryLimit;
+
+/** Seconds spent lexing the source in the most recent compile */
+@property (readonly) double lexTime;
+
+/** Seconds spent parsing the token stream in the most recent compile */
+@property (readonly) double parseTime;
+
+/** Seconds spent resolving names and checking printf formats */
+@property (readonly) double resolveTime;
+
+/** Seconds spent moving string constants into runtime storage */
+@property (readonly) double stringTime;
+
+/** Seconds spent running the program in the most recent execution */
+@property (readonly) double executeTime;
+
+/**
+ Get the counters for the most recent execution: nodes executed, calls,
+ storage and symbol table traffic, dynamic allocations, the storage high
+ water marks, and the compile and execution phase times.  Counts are
+ numbers of events, sizes are in bytes and times are in seconds.
+ @returns a dictionary of NSNumber values keyed by counter name
+ */
+-(NSDictionary*) metrics;
+
+/**
+ Get the counters for the most recent execution as a single line of
+ JSON text, with the same keys as the metrics dictionary.
+ @returns the JSON text
+ */
+-(NSString*) metricsJSON;
+
+/**
+ Write the events in the binary trace of the most recent execution to a
+ file, which can be decoded with tinyc -D.
+ @param path the file to write, or nil to use the module name with a
+ ".trace" extension
+ @returns YES if the trace was written
+ */
+-(BOOL) writeTrace:(NSString*) path;
+
 /**
  Given a string containing the text of a TinyC module, compile it and
  prepare it for execution.
@@ -180,6 +299,61 @@ typedef enum {
  */
  -(TCError*) executeReturningValue:(TCValue**) result;
 
+/**
+ Run the runtime initialization of the program, which creates and sets
+ the global variables.  This is only done once after each compile; later
+ calls do nothing.  It is run automatically by resolveEntryPoint:handle:.
+ @returns nil if no error occured, else a description of the error.
+ */
+-(TCError*) initializeGlobals;
+
+/**
+ Choose the seed for the random number generator, so every execution from
+ now on produces the same random values.
+ @param seed the seed
+ */
+-(void) seedRandom:(unsigned long) seed;
+
+/**
+ Map a block of memory owned by the caller into the program's address
+ space, without copying it, and declare a global pointer variable of the
+ given name that points to its first element.  The program reads (and if
+ allowed, writes) the caller's memory in place, so the caller sees any
+ changes as soon as the program stores them.  The memory must remain
+ valid until it is unmapped or this object is released.  A buffer can be
+ mapped before or after the program is compiled.
+ @param bytes the first byte of the block
+ @param length the size of the block in bytes
+ @param type the element type; one of TCVALUE_CHAR, TCVALUE_INT,
+ TCVALUE_LONG, TCVALUE_FLOAT or TCVALUE_DOUBLE
+ @param writable YES if the program may store into the block
+ @param name the name of the global pointer variable
+ @returns nil if no error occured, else a description of the error.
+ */
+-(TCError*) mapBuffer:(void*) bytes
+               length:(long) length
+               ofType:(TCValueType) type
+             writable:(BOOL) writable
+                   as:(NSString*) name;
+
+/**
+ Remove a host buffer from the program's address space, along with the
+ global pointer variable that refers to it.
+ @param name the name the buffer was mapped as
+ @returns nil if no error occured, else a description of the error.
+ */
+-(TCError*) unmapBuffer:(NSString*) name;
+
+/**
+ Find a function in the compiled program and return a handle that can be
+ used to call it directly, as many times as needed, without running the
+ global initialization or main() again.
+ @param name the name of the function
+ @param handle where to store the resolved handle
+ @returns nil if no error occured, else a description of the error.
+ */
+-(TCError*) resolveEntryPoint:(NSString*) name handle:(TCEntryPoint *__autoreleasing*) handle;
+
 /**
  This function scans the parse tree and allocates static storage from the
  available virtual storage for the program for any string constants in the
@@ -193,6 +367,28 @@ typedef enum {
  assigned to string constant values.
  */
 -(long) allocateScalarStrings:(TCSyntaxNode*) tree storage:(TCStorageManager*) storage;
+
+/**
+ This function scans the parse tree for calls to printf() that use a
+ string constant as the format, and compiles each format into a list of
+ directives that is attached to the call.  The argument count, and the
+ types of any constant arguments, are checked against the format.  This
+ is run automatically when a program is compiled.
+ @param tree the abstract syntax tree created by the compilation of the
+ source code.
+ @returns nil if no error occured, else a description of the error.
+ */
+-(TCError*) compileFormatStrings:(TCSyntaxNode*) tree;
+
+/**
+ This function loads the shared library of each extern function declared
+ in a module, and binds the function's symbol.  This is run automatically
+ when a program is compiled.
+ @param tree the abstract syntax tree created by the compilation of the
+ source code.
+ @returns nil if no error occured, else a description of the error.
+ */
+-(TCError*) bindExterns:(TCSyntaxNode*) tree;
  
  /**
   Set the debug flag for this object.  The debug flag is 
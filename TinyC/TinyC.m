@@ -20,8 +20,30 @@
 #import "TCLexicalScanner.h"
 #import "TCExecutionContext.h"
 #import "TCModuleParser.h"
+#import "TCFormatString.h"
+#import "TCEntryPoint.h"
+#import "TCProfiler.h"
+#import "TCTraceBuffer.h"
+#import "TCHeapProfiler.h"
+#import "TCBoundsAnalyzer.h"
+#import "TCTier.h"
+#import "TCRandom.h"
+#import "TCForeignFunction.h"
+#import "TCCoroutine.h"
+#import "TCThread.h"
 
-TCExecutionContext* activeContext;
+extern __thread __unsafe_unretained TCExecutionContext* activeContext;
+
+/**
+ Read the monotonic clock, in seconds, for timing the phases of a compile
+ and execution.
+ */
+static double phaseClock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1.0e9;
+}
 
 @implementation TinyC
 
@@ -47,6 +69,7 @@ TCExecutionContext* activeContext;
 -(id)initWithMemory:(long)initialMemorySize flags:(TCFlag)debugFlags {
     flags = debugFlags;
     _memorySize = initialMemorySize;
+    _random = [[TCRandom alloc]initWithSeed:0];
     return self;
 }
 
@@ -73,6 +96,7 @@ TCExecutionContext* activeContext;
     // Now compile the string and capture the appropriate return code, or nil if no errors
     // occurred.
     TCError * compileError = [self compileString:source module:_moduleName];
+    sourcePath = [path stringByStandardizingPath];
     
     return compileError;
 }
@@ -80,9 +104,12 @@ TCExecutionContext* activeContext;
 -(TCError*) compileString:(NSString *)source module:(NSString*) moduleName
 {
     TCError *error;
+    double start = phaseClock();
     
+    sourcePath = nil;
     scanner = [[TCLexicalScanner alloc]init];
     [scanner lex:source];
+    _lexTime = phaseClock() - start;
     if( self.debugTokens)
         [scanner dump];
     
@@ -91,9 +118,11 @@ TCExecutionContext* activeContext;
     else
         _moduleName = @"__STRING__";
     
+    start = phaseClock();
     TCModuleParser* module = [[TCModuleParser alloc]init];
     TCSyntaxNode * tree = [module parse:scanner name:_moduleName];
     error = scanner.error;
+    _parseTime = phaseClock() - start;
     
     // If the parse resulted in an error, bail out.
     if( error != nil) {
@@ -111,35 +140,85 @@ TCExecutionContext* activeContext;
     // first compile of a session; subsequent compiles use the same storage
     // area.
     
-     if(self.storage == nil ) {
-         if( _memorySize == 0 )
-             _memorySize = 65536;
-         
-       self.storage = [[TCStorageManager alloc]initWithStorage:_memorySize];
-    }
+    [self allocateStorage];
     self.storage.debug = self.debugStorage;
     
     // Create execution context and check to see if there are
     // unresolved symbols
     
+    start = phaseClock();
+    
     context = [[TCExecutionContext alloc]initWithStorage:self.storage];
     context.debug = self.debugTrace;
     context.module = tree;
     activeContext = context;
+    globals = nil;
+    globalsInitialized = NO;
+    
+    // Host buffers are declared in the outermost symbol table, so they
+    // are visible to the runtime initialization and every function.  The
+    // table outlives a recompile, as its variables hold storage that is
+    // never popped.
+    
+    if( hostSymbols == nil ) {
+        hostSymbols = [[TCRuntimeSymbolTable alloc]init];
+        for( NSString * name in hostBuffers )
+            [self declareHostBuffer:name];
+    }
+    context.symbols = hostSymbols;
+    
+    // Load the libraries of any extern functions and bind the symbols,
+    // so a missing one is reported now rather than when it is called.
+    
+    error = [self bindExterns:tree];
+    if( error != nil ) {
+        return error;
+    }
     
     if([context hasUnresolvedNames:tree]) {
         return context.error;
     }
     
+    // Pre-compile any literal printf() format strings, and check that the
+    // arguments passed match them.  This must happen before the string
+    // constants are moved to storage, while the format text is still in
+    // the tree.
+    
+    error = [self compileFormatStrings:tree];
+    if( error != nil ) {
+        return error;
+    }
+    
+    // Find the array indexes that counted loops keep within the declared
+    // bounds, so they are not checked each time they are evaluated.
+    
+    TCBoundsAnalyzer * bounds = [[TCBoundsAnalyzer alloc]init];
+    [bounds analyze:tree];
+    if( self.debugParse )
+        NSLog(@"PARSE: %ld array index bounds checks removed", bounds.provenCount);
+    
+    // Functions start out running the tree as parsed.  Each one that gets
+    // hot is optimized in the background and called in that form after.
+    
+    if( !(flags & TCNoOptimize)) {
+        long tiered = [TCTier attachToModule:tree debug:self.debugParse];
+        if( self.debugParse )
+            NSLog(@"PARSE: %ld functions will be optimized when hot", tiered);
+    }
+    
     // Now that we have storage and the tree is free of obvious
     // errors, search for string scalar values
     // that really need to be char* pointing to static storage.
     // Always start with an empty dictionary. After the allocation
     // we no longer need the dictionary and can free it up...
     
+    _resolveTime = phaseClock() - start;
+    
+    start = phaseClock();
     _stringPool = [NSMutableDictionary dictionary];
     [self allocateScalarStrings:tree storage: self.storage];
     _stringPool = nil;
+    _stringTime = phaseClock() - start;
     
     _result = nil;
     
@@ -171,15 +250,259 @@ TCExecutionContext* activeContext;
     return error;
 }
 
--(TCError* ) execute
+/**
+ Create the storage manager if this session does not have one yet.
+ */
+-(void) allocateStorage
+{
+    if(self.storage == nil ) {
+        if( _memorySize == 0 )
+            _memorySize = 65536;
+        
+        self.storage = [[TCStorageManager alloc]initWithStorage:_memorySize];
+    }
+}
+
+/**
+ Create the global pointer variable for a mapped host buffer.
+ @param name the name the buffer was mapped as
+ */
+-(void) declareHostBuffer:(NSString*) name
+{
+    // A name mapped again keeps the storage of its variable.
+    
+    TCValue * pointer = hostBuffers[name];
+    TCRuntimeSymbol * symbol = hostSymbols.symbols[name];
+    if( symbol == nil ) {
+        symbol = unmappedHostSymbols[name];
+        [unmappedHostSymbols removeObjectForKey:name];
+        if( symbol != nil )
+            hostSymbols.symbols[name] = symbol;
+    }
+    if( symbol == nil )
+        symbol = [hostSymbols newSymbol:name
+                                 ofType:pointer.getType
+                                storage:_storage];
+    symbol.type = pointer.getType;
+    [symbol setValue:pointer storage:_storage];
+}
+
+-(TCError*) mapBuffer:(void *)bytes
+               length:(long)length
+               ofType:(TCValueType)type
+             writable:(BOOL)writable
+                   as:(NSString *)name
+{
+    if( type != TCVALUE_CHAR && type != TCVALUE_INT &&
+        type != TCVALUE_LONG && type != TCVALUE_FLOAT && type != TCVALUE_DOUBLE ) {
+        return [[TCError alloc]initWithCode:TCERROR_HOST_BUFFER
+                                     atNode:nil
+                               withArgument:name];
+    }
+    
+    [self allocateStorage];
+    if( hostBuffers[name] != nil )
+        [self unmapBuffer:name];
+    
+    long address = [_storage mapBytes:bytes length:length writable:writable owner:nil];
+    if( address == 0L ) {
+        return [[TCError alloc]initWithCode:TCERROR_HOST_BUFFER
+                                     atNode:nil
+                               withArgument:name];
+    }
+    
+    if( hostBuffers == nil )
+        hostBuffers = [NSMutableDictionary dictionary];
+    hostBuffers[name] = [[[TCValue alloc]initWithLong:address] makePointer:type];
+    
+    // If the program is already compiled, the variable can be declared
+    // now; otherwise the compile will declare it.
+    
+    if( hostSymbols != nil )
+        [self declareHostBuffer:name];
+    return nil;
+}
+
+-(TCError*) unmapBuffer:(NSString *)name
+{
+    TCValue * pointer = hostBuffers[name];
+    if( pointer == nil ) {
+        return [[TCError alloc]initWithCode:TCERROR_HOST_BUFFER
+                                     atNode:nil
+                               withArgument:name];
+    }
+    [_storage unmapExternal:pointer.getLong];
+    [hostBuffers removeObjectForKey:name];
+    TCRuntimeSymbol * symbol = hostSymbols.symbols[name];
+    if( symbol != nil ) {
+        if( unmappedHostSymbols == nil )
+            unmappedHostSymbols = [NSMutableDictionary dictionary];
+        unmappedHostSymbols[name] = symbol;
+        [hostSymbols.symbols removeObjectForKey:name];
+    }
+    return nil;
+}
+
+-(TCError*) initializeGlobals
+{
+    if( globalsInitialized )
+        return nil;
+    
+    if([context findEntryPoint:RUNTIME_ENTRYPOINT] != nil ) {
+        context.assertAbort = (BOOL) (flags & TCFatalAsserts);
+        [_random start];
+        _result = [context execute:context.module
+                        entryPoint:RUNTIME_ENTRYPOINT
+                     withArguments:@[]];
+        [_random stop];
+        if( context.error != nil )
+            return context.error;
+    }
+    globals = context.symbols;
+    globalsInitialized = YES;
+    return nil;
+}
+
+-(void) seedRandom:(unsigned long)seed
+{
+    randomSeeded = YES;
+    randomSeed = seed;
+}
+
+-(TCError*) resolveEntryPoint:(NSString *)name handle:(TCEntryPoint *__autoreleasing *)handle
+{
+    TCError * error = [self initializeGlobals];
+    if( error != nil )
+        return error;
+    
+    activeContext = context;
+    TCSyntaxNode * entry = [context findEntryPoint:name];
+    if( entry == nil || [name isEqualToString:RUNTIME_ENTRYPOINT]) {
+        return [[TCError alloc]initWithCode:TCERROR_UNK_ENTRYPOINT
+                                     atNode:nil
+                               withArgument:name];
+    }
+    
+    TCEntryPoint * entryPoint = [[TCEntryPoint alloc]initWithEntry:entry
+                                                            module:context.module
+                                                           globals:globals
+                                                           storage:_storage];
+    entryPoint.debug = self.debugTrace;
+    entryPoint.assertAbort = (BOOL) (flags & TCFatalAsserts);
+    entryPoint.random = [_random split];
+    if( handle != nil )
+        *handle = entryPoint;
+    return nil;
+}
+
+/**
+ Note which limit, if any, stopped the execution, and lift the limits so
+ they do not apply to entry points called later on this thread.
+ */
+-(void) finishLimits
+{
+    limitHit = runtimeLimits.exceeded;
+    if( limitHit == TCLIMIT_NONE && runtimeLimits.budget )
+        limitHit = runtimeLimits.budget->exceeded;
+    runtimeLimits.nodes = 0L;
+    runtimeLimits.memory = 0L;
+    runtimeLimits.exceeded = TCLIMIT_NONE;
+    runtimeLimits.budget = NULL;
+}
+
+/**
+ If a profile is being taken, stop it, write the report to stderr, and
+ write the folded call stacks to a file named for the module.  A heap
+ profile is reported to stderr as well.
+ */
+-(void) finishProfile
 {
-    // Initialize the random number generator state unless the flag is
-    // set to use deterministic random numbers
+    if( activeHeapProfiler != nil ) {
+        [activeHeapProfiler report:stderr storage:_storage sites:20];
+        activeHeapProfiler = nil;
+        heapProfiler = nil;
+    }
+    
+    if( activeProfiler == nil )
+        return;
+    
+    activeProfiler = nil;
     
-    if( flags & TCNonRandomNumbers)
-        srandom(0);
+    [profiler report:stderr lines:20];
+    
+    NSString * path = [NSString stringWithFormat:@"%@.folded", _moduleName ? _moduleName : @"tinyc"];
+    if([profiler writeFoldedStacks:path])
+        fprintf(stderr, "\nPROFILE: folded stacks written to %s\n", [path UTF8String]);
     else
-        srandomdev();
+        NSLog(@"PROFILE: unable to write folded stacks to %@", path);
+    profiler = nil;
+}
+
+/**
+ If a binary trace is being recorded, stop it.  If the execution failed,
+ record the error, write the trace file, and show the last few events so
+ the failure can be seen in context.
+ @param error the error from the execution, or nil
+ */
+-(void) finishTrace:(TCError*) error
+{
+    if( _trace == nil || [TCTraceBuffer current] != _trace )
+        return;
+    
+    if( error != nil ) {
+        traceEvent(TCTRACE_ERROR, error.code, 0L, 0L);
+        fprintf(stderr, "TRACE: last events before the error:\n");
+        [_trace dumpTail:stderr limit:20 scanner:scanner];
+        if([_trace write])
+            fprintf(stderr, "TRACE: trace written to %s\n", [_trace.tracePath UTF8String]);
+    }
+    [_trace stop];
+}
+
+/**
+ Get the number of events the trace ring holds.
+ */
+-(long) traceCapacity
+{
+    return _traceEvents > 0 ? _traceEvents : TCTRACE_DEFAULT_EVENTS;
+}
+
+-(BOOL) writeTrace:(NSString *)path
+{
+    if( _trace == nil )
+        return NO;
+    if( path != nil )
+        _trace.tracePath = path;
+    return [_trace write];
+}
+
+-(TCError* ) execute
+{
+    double start = phaseClock();
+    resetRuntimeCounters();
+    runtimeLimits.nodes = _nodeLimit;
+    runtimeLimits.memory = _memoryLimit;
+    runtimeLimits.exceeded = TCLIMIT_NONE;
+    
+    // The threads the program starts draw on the same budget.
+    
+    memset(&budget, 0, sizeof(budget));
+    runtimeLimits.budget = (_nodeLimit || _memoryLimit) ? &budget : NULL;
+    
+    // Seed this program's random number generator.  An explicit seed or
+    // the deterministic flag make the run repeatable; otherwise each run
+    // gets a truly random seed.
+    
+    if( randomSeeded )
+        [_random reseed:randomSeed];
+    else if( flags & TCNonRandomNumbers)
+        [_random reseed:0];
+    else {
+        unsigned long seed;
+        arc4random_buf(&seed, sizeof(seed));
+        [_random reseed:seed];
+    }
+    [_random start];
     
     // Make sure the flag indicating if asserts are fatal in this execution
     // is copied into the execution context.  We do this now since it could
@@ -216,6 +539,25 @@ TCExecutionContext* activeContext;
     
     TCValue * argvValue = [[[TCValue alloc]initWithLong:argv] makePointer:TCVALUE_POINTER_CHAR];
     
+    // If profiling, start now so the runtime initialization is included.
+    
+    if( flags & TCDebugProfile )
+        profiler = [[TCProfiler alloc]initWithScanner:scanner];
+    if( flags & TCDebugHeap )
+        heapProfiler = [[TCHeapProfiler alloc]initWithScanner:scanner];
+    activeProfiler = profiler;
+    activeHeapProfiler = heapProfiler;
+    
+    // The trace ring is started here too.  It is written out if the
+    // execution fails, or when the program or caller asks for it.
+    
+    if( flags & TCDebugTraceRing ) {
+        _trace = [[TCTraceBuffer alloc]initWithCapacity:[self traceCapacity]];
+        _trace.sourcePath = sourcePath;
+        _trace.tracePath = [NSString stringWithFormat:@"%@.trace", _moduleName ? _moduleName : @"tinyc"];
+        [_trace start];
+    }
+    
     // Try to execute the runtime initialization if it was compiled.  This happens
     // when there are global variables, for example. The special name RUNTIME_ENTRYPOINT
     // is reserved.
@@ -225,20 +567,45 @@ TCExecutionContext* activeContext;
         _result = [context execute:context.module
                         entryPoint:RUNTIME_ENTRYPOINT
                      withArguments:@[]];
-        if( _result.getInt != 0 )
+        if( _result.getInt != 0 ) {
+            [TCThread joinAllInStorage:_storage];
+            [TCCoroutine cancelAllInStorage:_storage];
+            _executeTime = phaseClock() - start;
+            counters = runtimeCounters;
+            [self finishLimits];
+            [self finishProfile];
+            [self finishTrace:context.error];
+            [_random stop];
             return [context error];
+        }
     }
+    globals = context.symbols;
+    globalsInitialized = YES;
     
-    // Now run the main program.
+    // Now run the main program.  Threads it spawns see the globals.
+    activeGlobals = globals;
     _result = [context execute:context.module
                              entryPoint:@"main"
                           withArguments:@[ argcValue, argvValue ]];
     
+    // Threads not joined are waited for, and coroutines left suspended are
+    // unwound so their threads end.
+    
+    [TCThread joinAllInStorage:_storage];
+    [TCCoroutine cancelAllInStorage:_storage];
+    activeGlobals = nil;
+    _executeTime = phaseClock() - start;
+    counters = runtimeCounters;
+    [self finishLimits];
+    [self finishProfile];
+    [self finishTrace:context.error];
+    [_random stop];
+    
     // After we're done, do we need to dump out memory usage stats?
     
     if( flags & TCDebugMemory) {
         NSLog(@"MEMORY: total runtime memory (in bytes):       %8ld", _storage.size);
-        NSLog(@"MEMORY: Maximum active automatic stack frames: %8d",  _storage.frameCount);
+        NSLog(@"MEMORY: Maximum active automatic stack frames: %8ld", _storage.maxFrames);
         NSLog(@"MEMORY: Maximum automatic storage allocated:   %8ld", _storage.autoMark);
         NSLog(@"MEMORY: Maximum dynamic   storage allocated:   %8ld", _storage.dynamicMark);
         NSLog(@"MEMORY: Unused runtime memory:                 %8ld",
@@ -249,6 +616,44 @@ TCExecutionContext* activeContext;
 }
 
 
+-(NSDictionary*) metrics
+{
+    return @{ @"nodes"         : @(counters.nodes),
+              @"calls"         : @(counters.calls),
+              @"iterations"    : @(counters.iterations),
+              @"builtinCalls"  : @(counters.builtinCalls),
+              @"storageReads"  : @(counters.reads),
+              @"storageWrites" : @(counters.writes),
+              @"symbolLookups" : @(counters.lookups),
+              @"allocs"        : @(counters.allocs),
+              @"allocBytes"    : @(counters.allocBytes),
+              @"frees"         : @(counters.frees),
+              @"freeBytes"     : @(counters.freeBytes),
+              @"peakBytes"     : @(counters.peakBytes),
+              @"nodeLimit"     : @(_nodeLimit),
+              @"memoryLimit"   : @(_memoryLimit),
+              @"limitHit"      : limitHit == TCLIMIT_NODES ? @"nodes" :
+                                 limitHit == TCLIMIT_MEMORY ? @"memory" : @"none",
+              @"memorySize"    : @(_storage.size),
+              @"maxFrames"     : @(_storage.maxFrames),
+              @"autoMark"      : @(_storage.autoMark),
+              @"dynamicMark"   : @(_storage.dynamicMark),
+              @"lexTime"       : @(_lexTime),
+              @"parseTime"     : @(_parseTime),
+              @"resolveTime"   : @(_resolveTime),
+              @"stringTime"    : @(_stringTime),
+              @"executeTime"   : @(_executeTime) };
+}
+
+-(NSString*) metricsJSON
+{
+    NSData * json = [NSJSONSerialization dataWithJSONObject:[self metrics]
+                                                    options:NSJSONWritingSortedKeys
+                                                      error:nil];
+    return [[NSString alloc]initWithData:json encoding:NSUTF8StringEncoding];
+}
+
+
 /**
  Search a parse tree (recursively as needed) and locate any SCALAR string loads.
  Convert those to char* loads and allocate space in the storage area for them.
@@ -310,6 +715,102 @@ TCExecutionContext* activeContext;
 }
 
 
+-(TCError*) bindExterns:(TCSyntaxNode *)tree
+{
+    for( TCSyntaxNode * node in tree.subNodes ) {
+        if( node.nodeType != LANGUAGE_EXTERN || [node.argument isKindOfClass:[TCForeignFunction class]])
+            continue;
+        
+        TCError * error = nil;
+        TCForeignFunction * function = [[TCForeignFunction alloc]initWithPrototype:node error:&error];
+        if( function == nil )
+            return error;
+        node.argument = function;
+    }
+    return nil;
+}
+
+/**
+ Search a parse tree (recursively as needed) for calls to the printf()
+ builtin whose format is a string literal.  Each such format is compiled
+ into a TCFormatString that is stored as the argument of the CALL node,
+ and the argument list is validated against it.
+ @param tree the parse tree to evaluate
+ @return nil if all formats were valid, else a description of the error
+ */
+
+-(TCError*) compileFormatStrings:(TCSyntaxNode *)tree
+{
+    if( tree.nodeType == LANGUAGE_CALL &&
+       [tree.spelling isEqualToString:@"printf"] &&
+       tree.subNodes.count > 0 &&
+       [context findEntryPoint:tree.spelling] == nil) {
+        
+        TCSyntaxNode * formatArg = tree.subNodes[0];
+        if( formatArg.nodeType == LANGUAGE_EXPRESSION && formatArg.subNodes.count == 1 )
+            formatArg = formatArg.subNodes[0];
+        
+        if( formatArg.nodeType == LANGUAGE_SCALAR && formatArg.action == TOKEN_STRING) {
+            TCFormatString * format = [[TCFormatString alloc]initWithString:formatArg.spelling];
+            if( format.error ) {
+                return [[TCError alloc]initWithCode:format.error.code
+                                             atNode:tree
+                                       withArgument:format.error.argument];
+            }
+            
+            int count = (int) tree.subNodes.count - 1;
+            if( count != format.argumentCount) {
+                return [[TCError alloc]initWithCode:TCERROR_FORMAT_ARGCOUNT
+                                             atNode:tree
+                                       withArgument:[NSNumber numberWithInt:format.argumentCount]];
+            }
+            
+            // We can only know the type of constant arguments at this point;
+            // everything else is checked as the call is made.
+            
+            for( int ix = 0; ix < count; ix++ ) {
+                TCSyntaxNode * arg = tree.subNodes[ix+1];
+                if( arg.nodeType == LANGUAGE_EXPRESSION && arg.subNodes.count == 1 )
+                    arg = arg.subNodes[0];
+                if( arg.nodeType != LANGUAGE_SCALAR)
+                    continue;
+                
+                TCValueType argType = TCVALUE_UNDEFINED;
+                switch( arg.action ) {
+                    case TOKEN_INTEGER:
+                        argType = TCVALUE_INT;
+                        break;
+                    case TOKEN_DOUBLE:
+                        argType = TCVALUE_DOUBLE;
+                        break;
+                    case TOKEN_FLOAT:
+                        argType = TCVALUE_FLOAT;
+                        break;
+                    case TOKEN_STRING:
+                        argType = TCVALUE_POINTER_CHAR;
+                        break;
+                    default:
+                        continue;
+                }
+                if(![format acceptsArgument:ix ofType:argType]) {
+                    return [[TCError alloc]initWithCode:TCERROR_FORMAT_ARGTYPE
+                                                 atNode:tree
+                                           withArgument:[NSNumber numberWithInt:ix+1]];
+                }
+            }
+            tree.argument = format;
+        }
+    }
+    
+    for( int ix = 0; ix < tree.subNodes.count; ix++ ) {
+        TCError * error = [self compileFormatStrings:tree.subNodes[ix]];
+        if( error != nil )
+            return error;
+    }
+    return nil;
+}
+
+
 -(BOOL) debugParse
 {
     return (flags & TCDebugParse) ? YES: NO;
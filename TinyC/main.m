@@ -10,6 +10,7 @@
 #import "TCError.h"
 #import "TCValue.h"
 #import "TinyC.h"
+#import "TCTraceBuffer.h"
 
 NSString * loadProgramFromFile(FILE * input)
 {
@@ -29,6 +30,26 @@ NSString * loadProgramFromFile(FILE * input)
     return program;
 }
 
+/**
+ Read a byte count with an optional k or m suffix.
+ @return the count, or -1 if the suffix is not valid
+ */
+long scaledSize(const char * text)
+{
+    char * end = NULL;
+    long size = strtol(text, &end, 10);
+    switch( tolower(*end) ) {
+        case 0:
+            return size;
+        case 'k':
+            return size * 1024L;
+        case 'm':
+            return size * 1024L * 1024L;
+        default:
+            return -1L;
+    }
+}
+
 int main(int argc, const char * argv[])
 {
     
@@ -41,6 +62,12 @@ int main(int argc, const char * argv[])
         
         TCFlag df = TCDebugNone;
         BOOL argCapture = NO;
+        BOOL showTiming = NO;
+        BOOL showMetrics = NO;
+        BOOL seeded = NO;
+        unsigned long seed = 0;
+        long nodeLimit = 0;
+        long memoryLimit = 0;
         NSMutableArray *argList = [NSMutableArray array];
         
         // Scan over the runtime argument list.  Some will be processed
@@ -84,6 +111,18 @@ int main(int argc, const char * argv[])
                             df |= TCNonRandomNumbers;// -dr     Deterministic random numbers
                             break;
                             
+                        case 'P':
+                            df |= TCDebugProfile;   //  -dP     profile functions and lines
+                            break;
+                            
+                        case 'b':
+                            df |= TCDebugTraceRing; //  -db     binary trace ring
+                            break;
+                            
+                        case 'h':
+                            df |= TCDebugHeap;      //  -dh     heap profile by call site
+                            break;
+                            
                         default:
                             printf("Unrecognized -d option %c ignored\n", c);
                             break;
@@ -96,6 +135,63 @@ int main(int argc, const char * argv[])
                 continue;
             }
             
+            //  -O0 runs every function as parsed, without optimizing the
+            //  hot ones, to compare against or to rule the optimizer out
+            //  when chasing a bug.
+            if( strcmp(argv[ax], "-O0") == 0) {
+                df |= TCNoOptimize;
+                continue;
+            }
+            
+            //  -T writes the time spent in each phase to stderr as JSON,
+            //  for the benchmark harness.
+            if( strcmp(argv[ax], "-T") == 0) {
+                showTiming = YES;
+                continue;
+            }
+            
+            //  -M writes the runtime counters to stderr as JSON, so they
+            //  can be collected by whatever runs the job.
+            if( strcmp(argv[ax], "-M") == 0) {
+                showMetrics = YES;
+                continue;
+            }
+            
+            //  -D decodes a trace file written by a -db run, using the
+            //  source file named in the trace unless another is given.
+            if( strcmp(argv[ax], "-D") == 0 && ax + 1 < argc ) {
+                NSString * trace = [NSString stringWithUTF8String:argv[ax+1]];
+                NSString * source = (ax + 2 < argc) ? [NSString stringWithUTF8String:argv[ax+2]] : nil;
+                if(![TCTraceBuffer decodeFile:trace source:source to:stdout]) {
+                    printf("Unable to read trace file %s\n", argv[ax+1]);
+                    return -1;
+                }
+                return 0;
+            }
+            
+            //  -S seeds the random number generator, so a run can be
+            //  repeated exactly.
+            if( strcmp(argv[ax], "-S") == 0 && ax + 1 < argc ) {
+                seed = strtoul(argv[++ax], NULL, 0);
+                seeded = YES;
+                continue;
+            }
+            
+            //  -N and -H limit the nodes executed and the dynamic storage
+            //  in use, so a runaway script is stopped with an error.
+            if( strcmp(argv[ax], "-N") == 0 && ax + 1 < argc ) {
+                nodeLimit = strtol(argv[++ax], NULL, 0);
+                continue;
+            }
+            if( strcmp(argv[ax], "-H") == 0 && ax + 1 < argc ) {
+                memoryLimit = scaledSize(argv[++ax]);
+                if( memoryLimit < 0 ) {
+                    printf("Invalid heap limit %s\n", argv[ax]);
+                    return -1;
+                }
+                continue;
+            }
+            
             if( strcmp(argv[ax], "-m") == 0 ) {
                 
                 long mult = 1;
@@ -130,15 +226,25 @@ int main(int argc, const char * argv[])
             
             if( *(argv[ax]) == '-') {
                 printf("Unrecognized command line option %s\n", argv[ax]);
-                printf("Usage:   tinyc  [-d[tpxs]] [-a] [-m n] file\n");
+                printf("Usage:   tinyc  [-d[tpxsmrPbh]] [-a] [-O0] [-T] [-M] [-S seed] [-N n] [-H n] [-m n] file\n");
                 printf("    -dt   Dump token queue\n");
                 printf("    -dp   Dump parse tree\n");
                 printf("    -dx   Trace execution\n");
                 printf("    -ds   Trace storage\n");
                 printf("    -dm   Summarize memory use\n");
                 printf("    -dr   Do not use true random numbers\n");
+                printf("    -dP   Profile execution by function and line\n");
+                printf("    -db   Record a binary trace, written to <module>.trace on error\n");
+                printf("    -dh   Profile dynamic storage by call site\n");
                 printf("    -a    assert() abort\n");
+                printf("    -O0   Do not optimize hot functions\n");
+                printf("    -T    Write phase timings to stderr as JSON\n");
+                printf("    -M    Write runtime counters to stderr as JSON\n");
+                printf("    -S n  Seed the random number generator with n\n");
+                printf("    -N n  Stop the program after n nodes are executed\n");
+                printf("    -H n  Stop the program if it allocates more than n bytes at once\n");
                 printf("    -m n  Allocate n bytes to runtime storage\n");
+                printf("    -D trace [file]  Decode a binary trace file\n");
                 return -3;
             }
             path = [NSString stringWithCString:argv[ax] encoding:NSUTF8StringEncoding];
@@ -160,6 +266,10 @@ int main(int argc, const char * argv[])
         
         TCError * error = nil;
         TinyC * tinyC = [TinyC allocWithMemory:memory flags:df];
+        if( seeded )
+            [tinyC seedRandom:seed];
+        tinyC.nodeLimit = nodeLimit;
+        tinyC.memoryLimit = memoryLimit;
         
         // 2. If we have a file, compile that, else compile the string we captured.
         
@@ -182,6 +292,19 @@ int main(int argc, const char * argv[])
         
         error = [tinyC executeWithArguments:argList];
         
+        if( showTiming ) {
+            fflush(stdout);
+            fprintf(stderr, "TIMING: {\"lex\": %.9f, \"parse\": %.9f, \"resolve\": %.9f, "
+                    "\"strings\": %.9f, \"execute\": %.9f}\n",
+                    tinyC.lexTime, tinyC.parseTime, tinyC.resolveTime,
+                    tinyC.stringTime, tinyC.executeTime);
+        }
+        
+        if( showMetrics ) {
+            fflush(stdout);
+            fprintf(stderr, "METRICS: %s\n", [[tinyC metricsJSON] UTF8String]);
+        }
+        
         if( error != nil ) {
             printf("%s\n", [[error description] UTF8String]);
             return -1001;